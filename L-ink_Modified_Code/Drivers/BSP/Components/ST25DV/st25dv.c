@@ -131,6 +131,8 @@ int32_t ST25DV_GetMBEN_Dyn(ST25DV_Object_t *pObj, ST25DV_EN_STATUS *const pMBEN)
 int32_t ST25DV_SetMBEN_Dyn(ST25DV_Object_t *pObj);
 int32_t ST25DV_ResetMBEN_Dyn(ST25DV_Object_t *pObj);
 int32_t ST25DV_ReadMBLength_Dyn(ST25DV_Object_t *pObj, uint8_t *const pMBLength);
+int32_t ST25DV_ReadSysSnapshot(ST25DV_Object_t *pObj, ST25DV_SYS_SNAPSHOT *const pSys);
+int32_t ST25DV_ReadDynSnapshot(ST25DV_Object_t *pObj, ST25DV_DYN_SNAPSHOT *const pDyn);
 
 /* Global variables ---------------------------------------------------------*/
 /**
@@ -171,6 +173,7 @@ int32_t ST25DV_RegisterBusIO(ST25DV_Object_t *pObj, ST25DV_IO_t *pIO)
     pObj->IO.Read = pIO->Read;
     pObj->IO.IsReady = pIO->IsReady;
     pObj->IO.GetTick = pIO->GetTick;
+    pObj->IO.Submit = pIO->Submit;
 
     pObj->Ctx.ReadReg = ReadRegWrap;
     pObj->Ctx.WriteReg = WriteRegWrap;
@@ -406,6 +409,56 @@ int32_t ST25DV_WriteData(ST25DV_Object_t *pObj, const uint8_t *const pData, cons
   return ret;
 }
 
+/**
+  * @brief  Queues a read of N bytes of Data, starting from the specified I2C address.
+  * @details The read runs in the background, pXfer->Status leaves ST25DV_XFER_PENDING
+  *          once it completed and pXfer->Callback (if set) is called.
+  * @param  pXfer   Transfer descriptor, must stay valid until completion.
+  * @param  pData   Pointer used to return the read data.
+  * @param  TarAddr I2C data memory address to read.
+  * @param  NbByte  Number of bytes to be read.
+  * @return int32_t enum status.
+  */
+int32_t ST25DV_ReadDataAsync(ST25DV_Object_t *pObj, ST25DV_Xfer_t *const pXfer, uint8_t *const pData, const uint16_t TarAddr, const uint16_t NbByte)
+{
+  if (pObj->IO.Submit == NULL)
+  {
+    return NFCTAG_ERROR;
+  }
+
+  pXfer->DevAddr = ST25DV_ADDR_DATA_I2C;
+  pXfer->TarAddr = TarAddr;
+  pXfer->pData = pData;
+  pXfer->NbByte = NbByte;
+  pXfer->Mode = ST25DV_XFER_READ;
+  return pObj->IO.Submit(pXfer);
+}
+
+/**
+  * @brief  Queues a write of N bytes of Data, starting from the specified I2C address.
+  * @details Completes once the EEPROM write cycle is over; the bus re-polls the
+  *          device on a timer meanwhile instead of blocking.
+  * @param  pXfer   Transfer descriptor, must stay valid until completion.
+  * @param  pData   Pointer on the data to be written, must stay valid until completion.
+  * @param  TarAddr I2C data memory address to be written.
+  * @param  NbByte  Number of bytes to be written, at most ST25DV_MAX_WRITE_BYTE.
+  * @return int32_t enum status.
+  */
+int32_t ST25DV_WriteDataAsync(ST25DV_Object_t *pObj, ST25DV_Xfer_t *const pXfer, const uint8_t *const pData, const uint16_t TarAddr, const uint16_t NbByte)
+{
+  if ((pObj->IO.Submit == NULL) || (NbByte > ST25DV_MAX_WRITE_BYTE))
+  {
+    return NFCTAG_ERROR;
+  }
+
+  pXfer->DevAddr = ST25DV_ADDR_DATA_I2C;
+  pXfer->TarAddr = TarAddr;
+  pXfer->pData = (uint8_t *)pData;
+  pXfer->NbByte = NbByte;
+  pXfer->Mode = ST25DV_XFER_WRITE;
+  return pObj->IO.Submit(pXfer);
+}
+
 /**
   * @brief  Reads N bytes from Registers, starting at the specified I2C address.
   * @param  pData   Pointer used to return the read data.
@@ -2069,6 +2122,110 @@ int32_t ST25DV_ReadMBLength_Dyn(ST25DV_Object_t *pObj, uint8_t *const pMBLength)
   return ST25DV_GetMBLEN_DYN_MBLEN(&(pObj->Ctx), pMBLength);
 }
 
+/**
+  * @brief  Reads the whole system configuration area in one transaction.
+  * @details Use the ST25DV_SysGetxxx accessors to decode it, instead of one register read per field.
+  * @param  pSys Pointer on a ST25DV_SYS_SNAPSHOT structure used to return the registers.
+  * @return int32_t enum status.
+  */
+int32_t ST25DV_ReadSysSnapshot(ST25DV_Object_t *pObj, ST25DV_SYS_SNAPSHOT *const pSys)
+{
+  return ST25DV_ReadRegister(pObj, (uint8_t *)pSys, ST25DV_GPO_REG, (ST25DV_ICREF_REG - ST25DV_GPO_REG + 1));
+}
+
+/**
+  * @brief  Reads all the dynamic registers in one transaction.
+  * @note   IT_STS_Dyn is cleared by the read, its value is kept in pDyn->ItSts.
+  * @param  pDyn Pointer on a ST25DV_DYN_SNAPSHOT structure used to return the registers.
+  * @return int32_t enum status.
+  */
+int32_t ST25DV_ReadDynSnapshot(ST25DV_Object_t *pObj, ST25DV_DYN_SNAPSHOT *const pDyn)
+{
+  return ST25DV_ReadMailboxRegister(pObj, (uint8_t *)pDyn, ST25DV_GPO_DYN_REG, (ST25DV_MBLEN_DYN_REG - ST25DV_GPO_DYN_REG + 1));
+}
+
+/**
+  * @brief  Decodes the I2C Protected Area state from a snapshot.
+  * @param  pProtZone Pointer on a ST25DV_I2C_PROT_ZONE structure used to return the Protected Area state.
+  * @return None.
+  */
+void ST25DV_SysGetI2CProtectZone(const ST25DV_SYS_SNAPSHOT *const pSys, ST25DV_I2C_PROT_ZONE *const pProtZone)
+{
+  pProtZone->ProtectZone1 = (ST25DV_PROTECTION_CONF)((pSys->I2css & ST25DV_I2CSS_PZ1_MASK) >> ST25DV_I2CSS_PZ1_SHIFT);
+  pProtZone->ProtectZone2 = (ST25DV_PROTECTION_CONF)((pSys->I2css & ST25DV_I2CSS_PZ2_MASK) >> ST25DV_I2CSS_PZ2_SHIFT);
+  pProtZone->ProtectZone3 = (ST25DV_PROTECTION_CONF)((pSys->I2css & ST25DV_I2CSS_PZ3_MASK) >> ST25DV_I2CSS_PZ3_SHIFT);
+  pProtZone->ProtectZone4 = (ST25DV_PROTECTION_CONF)((pSys->I2css & ST25DV_I2CSS_PZ4_MASK) >> ST25DV_I2CSS_PZ4_SHIFT);
+}
+
+/**
+  * @brief  Decodes an area end address from a snapshot.
+  * @param  EndZone ST25DV_END_ZONE value corresponding to an area end address.
+  * @return End address of the area, 0xFF for an invalid EndZone.
+  */
+uint8_t ST25DV_SysGetEndZonex(const ST25DV_SYS_SNAPSHOT *const pSys, const ST25DV_END_ZONE EndZone)
+{
+  switch (EndZone)
+  {
+  case ST25DV_ZONE_END1:
+    return pSys->Enda1;
+  case ST25DV_ZONE_END2:
+    return pSys->Enda2;
+  case ST25DV_ZONE_END3:
+    return pSys->Enda3;
+
+  default:
+    return 0xFF;
+  }
+}
+
+/**
+  * @brief  Decodes the Memory Size from a snapshot.
+  * @param  pSizeInfo Pointer on a ST25DV_MEM_SIZE structure used to return the Memory size information.
+  * @return None.
+  */
+void ST25DV_SysGetMemSize(const ST25DV_SYS_SNAPSHOT *const pSys, ST25DV_MEM_SIZE *const pSizeInfo)
+{
+  pSizeInfo->BlockSize = pSys->BlkSize;
+  pSizeInfo->Mem_Size = ((uint16_t)pSys->MemSizeMsb << 8) | pSys->MemSizeLsb;
+}
+
+/**
+  * @brief  Decodes the security session status from a snapshot.
+  * @return ST25DV_I2CSSO_STATUS value.
+  */
+ST25DV_I2CSSO_STATUS ST25DV_DynGetI2CSecuritySession(const ST25DV_DYN_SNAPSHOT *const pDyn)
+{
+  return (ST25DV_I2CSSO_STATUS)((pDyn->I2cSso & ST25DV_I2C_SSO_DYN_I2CSSO_MASK) >> ST25DV_I2C_SSO_DYN_I2CSSO_SHIFT);
+}
+
+/**
+  * @brief  Decodes the Energy Harvesting control register from a snapshot.
+  * @param  pEH_CTRL Pointer on a ST25DV_EH_CTRL structure used to return the dynamic EH control.
+  * @return None.
+  */
+void ST25DV_DynGetEHCtrl(const ST25DV_DYN_SNAPSHOT *const pDyn, ST25DV_EH_CTRL *const pEH_CTRL)
+{
+  pEH_CTRL->EH_EN_Mode = (ST25DV_EN_STATUS)((pDyn->EhCtrl & ST25DV_EH_CTRL_DYN_EH_EN_MASK) >> ST25DV_EH_CTRL_DYN_EH_EN_SHIFT);
+  pEH_CTRL->EH_on = (ST25DV_EN_STATUS)((pDyn->EhCtrl & ST25DV_EH_CTRL_DYN_EH_ON_MASK) >> ST25DV_EH_CTRL_DYN_EH_ON_SHIFT);
+  pEH_CTRL->Field_on = (ST25DV_EN_STATUS)((pDyn->EhCtrl & ST25DV_EH_CTRL_DYN_FIELD_ON_MASK) >> ST25DV_EH_CTRL_DYN_FIELD_ON_SHIFT);
+  pEH_CTRL->VCC_on = (ST25DV_EN_STATUS)((pDyn->EhCtrl & ST25DV_EH_CTRL_DYN_VCC_ON_MASK) >> ST25DV_EH_CTRL_DYN_VCC_ON_SHIFT);
+}
+
+/**
+  * @brief  Decodes the Mailbox control register from a snapshot.
+  * @param  pCtrlStatus Pointer on a ST25DV_MB_CTRL_DYN_STATUS structure used to return the Mailbox control.
+  * @return None.
+  */
+void ST25DV_DynGetMBCtrl(const ST25DV_DYN_SNAPSHOT *const pDyn, ST25DV_MB_CTRL_DYN_STATUS *const pCtrlStatus)
+{
+  pCtrlStatus->MbEnable = (pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_MBEN_MASK) >> ST25DV_MB_CTRL_DYN_MBEN_SHIFT;
+  pCtrlStatus->HostPutMsg = (pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_HOSTPUTMSG_MASK) >> ST25DV_MB_CTRL_DYN_HOSTPUTMSG_SHIFT;
+  pCtrlStatus->RfPutMsg = (pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK) >> ST25DV_MB_CTRL_DYN_RFPUTMSG_SHIFT;
+  pCtrlStatus->HostMissMsg = (pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_HOSTMISSMSG_MASK) >> ST25DV_MB_CTRL_DYN_HOSTMISSMSG_SHIFT;
+  pCtrlStatus->RFMissMsg = (pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_RFMISSMSG_MASK) >> ST25DV_MB_CTRL_DYN_RFMISSMSG_SHIFT;
+  pCtrlStatus->CurrentMsg = (ST25DV_CURRENT_MSG)((pDyn->MbCtrl & ST25DV_MB_CTRL_DYN_CURRENTMSG_MASK) >> ST25DV_MB_CTRL_DYN_CURRENTMSG_SHIFT);
+}
+
 static int32_t ReadRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint16_t len)
 {
   ST25DV_Object_t *pObj = (ST25DV_Object_t *)handle;
@@ -285,6 +285,54 @@ typedef struct
   uint32_t LsbPasswd;
 } ST25DV_PASSWD;
 
+/**
+ * @brief  ST25DV system configuration snapshot, registers GPO (0x0000) to IC_REF (0x0017).
+ * @details Filled by ST25DV_ReadSysSnapshot in one I2C transaction, members follow the register map.
+ */
+typedef struct
+{
+  uint8_t Gpo;
+  uint8_t ItTime;
+  uint8_t EhMode;
+  uint8_t RfMngt;
+  uint8_t Rfa1ss;
+  uint8_t Enda1;
+  uint8_t Rfa2ss;
+  uint8_t Enda2;
+  uint8_t Rfa3ss;
+  uint8_t Enda3;
+  uint8_t Rfa4ss;
+  uint8_t I2css;
+  uint8_t LockCCFile;
+  uint8_t MbMode;
+  uint8_t MbWdg;
+  uint8_t LockCfg;
+  uint8_t LockDsfid;
+  uint8_t LockAfi;
+  uint8_t Dsfid;
+  uint8_t Afi;
+  uint8_t MemSizeLsb;
+  uint8_t MemSizeMsb;
+  uint8_t BlkSize;
+  uint8_t IcRef;
+} ST25DV_SYS_SNAPSHOT;
+
+/**
+ * @brief  ST25DV dynamic registers snapshot, GPO_CTRL_Dyn (0x2000) to MB_LEN_Dyn (0x2007).
+ * @details Filled by ST25DV_ReadDynSnapshot in one I2C transaction, members follow the register map.
+ */
+typedef struct
+{
+  uint8_t GpoCtrl;
+  uint8_t Rfu;
+  uint8_t EhCtrl;
+  uint8_t RfMngt;
+  uint8_t I2cSso;
+  uint8_t ItSts;
+  uint8_t MbCtrl;
+  uint8_t MbLen;
+} ST25DV_DYN_SNAPSHOT;
+
 
 typedef int32_t (*ST25DV_Init_Func) (void);
 typedef int32_t (*ST25DV_DeInit_Func) (void);
@@ -293,6 +341,23 @@ typedef int32_t (*ST25DV_Write_Func)(uint16_t, uint16_t, const uint8_t*, uint16_
 typedef int32_t (*ST25DV_Read_Func) (uint16_t, uint16_t, uint8_t*, uint16_t);
 typedef int32_t (*ST25DV_IsReady_Func) (uint16_t, const uint32_t);
 
+/**
+ * @brief  Queued bus transfer, completed in the background by the bus.
+ */
+typedef struct ST25DV_Xfer ST25DV_Xfer_t;
+struct ST25DV_Xfer
+{
+  uint16_t          DevAddr;                      /**< I2C device address                      */
+  uint16_t          TarAddr;                      /**< Memory / register address               */
+  uint8_t          *pData;                        /**< Data buffer, must stay valid            */
+  uint16_t          NbByte;                       /**< Data length                             */
+  uint8_t           Mode;                         /**< ST25DV_XFER_READ / _WRITE               */
+  volatile int32_t  Status;                       /**< ST25DV_XFER_PENDING, then NFCTAG status */
+  void            (*Callback)(ST25DV_Xfer_t *);   /**< Optional, runs in interrupt context     */
+};
+
+typedef int32_t (*ST25DV_Submit_Func) (ST25DV_Xfer_t *);
+
 typedef struct {
   ST25DV_Init_Func    Init;
   ST25DV_DeInit_Func  DeInit;
@@ -300,6 +365,7 @@ typedef struct {
   ST25DV_Write_Func   Write;
   ST25DV_Read_Func    Read;
   ST25DV_GetTick_Func GetTick;
+  ST25DV_Submit_Func  Submit;     /**< Queued transfers, NULL if the bus is blocking only */
 } ST25DV_IO_t;
 
 
@@ -364,6 +430,12 @@ typedef struct
 /** @brief I2C Time out (ms), min value : (Max write bytes) / (Internal page write) * tw   (256/4)*5. */
 #define ST25DV_WRITE_TIMEOUT                   320 
 
+/** @brief Queued transfer modes, the write waits for the EEPROM write cycle. */
+#define ST25DV_XFER_READ                       0U
+#define ST25DV_XFER_WRITE                      2U
+/** @brief ST25DV_Xfer_t Status until the transfer completed. */
+#define ST25DV_XFER_PENDING                    1
+
 /** @brief Size of the ST25DV write buffer. */
 #define ST25DV_MAX_WRITE_BYTE                256
 /** @brief Size of the ST25DVMailbox memory. */
@@ -384,6 +456,8 @@ extern ST25DV_Drv_t St25Dv_Drv;
 int32_t ST25DV_ReadRegister( ST25DV_Object_t*, uint8_t * const, const uint16_t, const uint16_t );
 int32_t ST25DV_WriteRegister( ST25DV_Object_t*, const uint8_t * const, const uint16_t, const uint16_t );
 int32_t ST25DV_RegisterBusIO (ST25DV_Object_t* pObj, ST25DV_IO_t *pIO);
+int32_t ST25DV_ReadDataAsync( ST25DV_Object_t* pObj, ST25DV_Xfer_t * const pXfer, uint8_t * const pData, const uint16_t TarAddr, const uint16_t NbByte );
+int32_t ST25DV_WriteDataAsync( ST25DV_Object_t* pObj, ST25DV_Xfer_t * const pXfer, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t NbByte );
 int32_t ST25DV_ReadMemSize( ST25DV_Object_t* pObj, ST25DV_MEM_SIZE * const pSizeInfo );
 int32_t ST25DV_ReadICRev(ST25DV_Object_t* pObj,  uint8_t * const pICRev );
 int32_t ST25DV_ReadITPulse(ST25DV_Object_t* pObj, ST25DV_PULSE_DURATION * const pITtime );
@@ -452,6 +526,14 @@ int32_t ST25DV_GetMBEN_Dyn( ST25DV_Object_t* pObj, ST25DV_EN_STATUS * const pMBE
 int32_t ST25DV_SetMBEN_Dyn( ST25DV_Object_t* pObj );
 int32_t ST25DV_ResetMBEN_Dyn( ST25DV_Object_t* pObj );
 int32_t ST25DV_ReadMBLength_Dyn( ST25DV_Object_t* pObj, uint8_t * const pMBLength );
+int32_t ST25DV_ReadSysSnapshot( ST25DV_Object_t* pObj, ST25DV_SYS_SNAPSHOT * const pSys );
+int32_t ST25DV_ReadDynSnapshot( ST25DV_Object_t* pObj, ST25DV_DYN_SNAPSHOT * const pDyn );
+void ST25DV_SysGetI2CProtectZone( const ST25DV_SYS_SNAPSHOT * const pSys, ST25DV_I2C_PROT_ZONE * const pProtZone );
+uint8_t ST25DV_SysGetEndZonex( const ST25DV_SYS_SNAPSHOT * const pSys, const ST25DV_END_ZONE EndZone );
+void ST25DV_SysGetMemSize( const ST25DV_SYS_SNAPSHOT * const pSys, ST25DV_MEM_SIZE * const pSizeInfo );
+ST25DV_I2CSSO_STATUS ST25DV_DynGetI2CSecuritySession( const ST25DV_DYN_SNAPSHOT * const pDyn );
+void ST25DV_DynGetEHCtrl( const ST25DV_DYN_SNAPSHOT * const pDyn, ST25DV_EH_CTRL * const pEH_CTRL );
+void ST25DV_DynGetMBCtrl( const ST25DV_DYN_SNAPSHOT * const pDyn, ST25DV_MB_CTRL_DYN_STATUS * const pCtrlStatus );
 
 /**
   * @}
@@ -1,5 +1,33 @@
 #include "epd_w21_config.h"
 #include "stm32l0xx_hal.h"
+#include "stdio.h"
+
+#define EPD_POWER_OFF   0 // not initialised since power up
+#define EPD_POWER_ON    1
+#define EPD_POWER_SLEEP 2 // deep sleep mode 1: RAM kept, registers lost
+
+#define EPD_BUSY_TIMEOUT 4000 // ms, longest waveform
+
+// Waveform selection, see EpdSelectWave()
+#define EPD_FAST_MIN_TEMP 10   // degC, below it the short waveforms leave grey
+#define EPD_PART_MIN_TEMP 5    // degC
+#define EPD_FULL_EVERY    10   // fast/partial updates before a full one clears the ghosting
+#define EPD_FAST_TEMP     0x6e // temperature written to 0x1a: selects the shortest OTP waveform
+
+static unsigned char epdPower = EPD_POWER_OFF;
+static unsigned char epdRefreshing;            // waveform started, not yet reported
+static unsigned char epdRefreshCount;
+static unsigned long epdRefreshTick;           // HAL tick at the update command
+static volatile unsigned long epdBusyFallTick; // HAL tick of the last BUSY falling edge
+static signed char epdTemp = 25;               // degC, read at every wake
+static unsigned char epdWave;                  // waveform of the last update
+static unsigned char epdSinceFull;             // updates since the last full waveform
+static unsigned char epdOldValid;              // RED RAM holds the frame on the panel
+static unsigned char epdRamCmd = 0x24;         // plane EpdStreamWrite() goes to
+
+#if EPD_W21_REPORT
+static const char *const epdWaveName[] = {"full", "fast", "partial"};
+#endif
 
 void SpiDelay(unsigned char xrate)
 {
@@ -37,58 +65,53 @@ void SpiWrite(unsigned char value)
     }
 }
 
-const unsigned char LUTDefault_part[31] = {
-    0x32, // command
-
-    0x10, 0x18, 0x18, 0x28, 0x18, 0x18, 0x18, 0x18, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x13, 0x11, 0x22, 0x63, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00};
-
-const unsigned char LUTDefault_full[31] = {
-    0x32, // command
-    0x66, //machine LUT
-    0x66,
-    0x44,
-    0x66,
-    0xAA,
-    0x11,
-    0x80,
-    0x08,
-    0x11,
-    0x18,
-    0x81,
-    0x18,
-    0x11,
-    0x88,
-    0x11,
-    0x88,
-    0x11,
-    0x88,
-    0x00,
-    0x00,
-    0xFF,
-    0xFF,
-    0xFF,
-    0xFF,
-    0x5F,
-    0xAF,
-    0xFF,
-    0xFF,
-    0x2F,
-    0x00};
+/* SDA is bidirectional: the controller drives it while DC is high after a read command */
+static unsigned char SpiRead(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    unsigned char i;
+    unsigned char value = 0;
+
+    GPIO_InitStruct.Pin = GPIO_PIN_5;
+    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    for (i = 0; i < 8; i++)
+    {
+        EPD_W21_CLK_0;
+        SpiDelay(1);
+        EPD_W21_CLK_1;
+        value = (value << 1) | (HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_5) == GPIO_PIN_SET);
+        SpiDelay(1);
+    }
 
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    return value;
+}
+
+/* BUSY falling edge on PA8, called from EXTI4_15_IRQHandler */
+void EpdBusyIrq(void)
+{
+    epdBusyFallTick = HAL_GetTick();
+}
+
+/* Sleep until BUSY drops: the EXTI edge wakes the core right away */
 static unsigned char ReadBusy(void)
 {
-    unsigned long i = 0;
+    unsigned long start = HAL_GetTick();
 
-    for (i = 0; i < 400; i++)
+    while (isEPD_W21_BUSY != EPD_W21_BUSY_LEVEL)
     {
-        if (isEPD_W21_BUSY == EPD_W21_BUSY_LEVEL)
+        if ((HAL_GetTick() - start) >= EPD_BUSY_TIMEOUT)
         {
-            return 1;
+            return 0;
         }
-        DriverDelay(10);
+        __WFI();
     }
-    return 0;
+    return 1;
 }
 
 static void EpdW21WriteCMD(unsigned char command)
@@ -136,6 +159,37 @@ static void EpdW21Write(unsigned char *value, unsigned char datalen)
     EPD_W21_CS_1;
 }
 
+static void EpdW21WriteData(unsigned char command, const unsigned char *data, unsigned int len)
+{
+    EPD_W21_CS_0;
+    EPD_W21_DC_0; // command write
+    SpiWrite(command);
+
+    EPD_W21_DC_1; // data write
+    while (len--)
+    {
+        SpiWrite(*data++);
+    }
+
+    EPD_W21_CS_1;
+}
+
+/* Temperature register, as measured by the last 0x22 0xb1 load */
+static signed char EpdW21ReadTemp(void)
+{
+    signed char temp;
+
+    ReadBusy();
+    EPD_W21_CS_0;
+    EPD_W21_DC_0; // command write
+    SpiWrite(0x1b);
+    EPD_W21_DC_1; // data read: T[11:4], T[3:0]
+    temp = (signed char)SpiRead();
+    SpiRead();
+    EPD_W21_CS_1;
+    return temp;
+}
+
 static void EpdW21WriteDispRam(unsigned char XSize, unsigned int YSize,
                                unsigned char *Dispbuff)
 {
@@ -147,8 +201,6 @@ static void EpdW21WriteDispRam(unsigned char XSize, unsigned int YSize,
     }
     XSize = XSize / 8;
 
-    while (isEPD_W21_BUSY == 1)
-        ; //wait
     ReadBusy();
 
     EPD_W21_CS_0;
@@ -242,12 +294,10 @@ static void PartDisplay(unsigned char RAM_XST, unsigned char RAM_XEND, unsigned
     EpdW21SetRamPointer(RAM_XST, RAM_YST, RAM_YST1);                             /*set orginal*/
 }
 
-static void EpdW21DispInit(void)
+/* Registers lost in deep sleep */
+static void EpdW21LoadRegs(void)
 {
-    EpdW21WriteCMD(0x12);
-    while (isEPD_W21_BUSY == 1)
-        DriverDelay(10);                                     //wait
-                                                             //    EpdW21Write(GDOControl, sizeof(GDOControl));    // Pannel configuration, Gate selection
+    //    EpdW21Write(GDOControl, sizeof(GDOControl));    // Pannel configuration, Gate selection
     EpdW21Write(softStart, sizeof(softStart));               // X decrease, Y decrease
     EpdW21Write(dummyLine, sizeof(dummyLine));               // dummy line per gate
     EpdW21Write(gateTime, sizeof(gateTime));                 // Gage time setting
@@ -258,8 +308,15 @@ static void EpdW21DispInit(void)
     EpdW21WriteCMD(0x20);
     EpdW21Write(setx, sizeof(setx));
     EpdW21Write(sety, sizeof(sety));
-    while (isEPD_W21_BUSY == 1)
-        DriverDelay(10); //wait
+    ReadBusy();
+    epdTemp = EpdW21ReadTemp();
+}
+
+static void EpdW21DispInit(void)
+{
+    EpdW21WriteCMD(0x12);
+    ReadBusy();
+    EpdW21LoadRegs();
     //	EpdW21SetRamArea(0x00, (xDot - 1) / 8, (yDot - 1) % 256, (yDot - 1) / 256, 0x00,
     //                     0x00);    // X-source area,Y-gage area
     //    EpdW21SetRamPointer(0x00, (yDot - 1) % 256, (yDot - 1) / 256);    // set ram
@@ -270,47 +327,105 @@ static void EpdW21Init(void)
     EPD_W21_DC_0;
     EPD_W21_CS_0;
     EPD_W21_RST_1;
-    DriverDelay(200);
+    DriverDelay(10);
     EPD_W21_RST_0; // Module reset
     DriverDelay(10);
     EPD_W21_RST_1;
-    DriverDelay(200);
-    while (isEPD_W21_BUSY == 1)
-        DriverDelay(10); //wait
+    DriverDelay(10);
+    ReadBusy(); // controller ready, instead of a fixed 200ms
 
     EpdW21DispInit(); // pannel configure
+    epdPower = EPD_POWER_ON;
 }
 
-static void EpdW21Update(void)
+/* Out of deep sleep: a hardware reset, then only the registers again */
+static void EpdW21Wake(void)
 {
-    EpdW21WriteCMD_p1(0x22, 0xf7);
-    EpdW21WriteCMD(0x20);
-    //    EpdW21WriteCMD(0xff);
+    unsigned long start;
+
+    if (epdPower == EPD_POWER_ON)
+    {
+        return;
+    }
+    if (epdPower == EPD_POWER_OFF)
+    {
+        EpdW21Init();
+        return;
+    }
+
+    start = HAL_GetTick();
+    EPD_W21_RST_0;
+    DriverDelay(10);
+    EPD_W21_RST_1;
+    DriverDelay(10);
+    ReadBusy();
+    EpdW21LoadRegs();
+    epdPower = EPD_POWER_ON;
+#if EPD_W21_REPORT
+    printf("epd: wake %lu ms\r\n", HAL_GetTick() - start);
+#else
+    (void)start;
+#endif
 }
 
-static void EpdW21UpdatePart(void)
+static void EpdW21Sleep(void)
 {
-    EpdW21WriteCMD_p1(0x22, 0xff);
-    //EpdW21WriteCMD_p1(0x22,0x08);
-    EpdW21WriteCMD(0x20);
-    //    EpdW21WriteCMD(0xff);
+    EpdW21WriteCMD_p1(0x10, 0x01); // deep sleep mode 1
+    epdPower = EPD_POWER_SLEEP;
 }
 
-static void EpdW21WirteLUT(unsigned char *LUTvalue, unsigned char Size)
+static void EpdW21Update(unsigned char wave)
 {
-    EpdW21Write(LUTvalue, Size);
+    switch (wave)
+    {
+    case EPD_WAVE_FAST:
+        // OTP waveform of a hot panel: same voltages, far fewer frames
+        EpdW21WriteCMD_p1(0x1a, EPD_FAST_TEMP);
+        EpdW21WriteCMD_p1(0x22, 0x91); // load LUT, mode 1
+        EpdW21WriteCMD(0x20);
+        EpdW21WriteCMD_p1(0x22, 0xc7); // display with the loaded LUT
+        break;
+    case EPD_WAVE_PART:
+        EpdW21WriteCMD_p1(0x22, 0xff); // mode 2: only pixels differing from RED RAM move
+        break;
+    default:
+        wave = EPD_WAVE_FULL;
+        EpdW21WriteCMD_p1(0x22, 0xf7); // OTP waveform for the measured temperature
+        break;
+    }
+    EpdW21WriteCMD(0x20);
+    epdRefreshTick = HAL_GetTick();
+    epdRefreshing = 1;
+    epdWave = wave;
+    epdOldValid = 0; // RED RAM is the old frame until rewritten
+    epdSinceFull = (wave == EPD_WAVE_FULL) ? 0 : epdSinceFull + 1;
+#if EPD_W21_REPORT
+    if (epdRefreshCount == 0)
+    {
+        printf("epd: first refresh %lu ms after reset\r\n", epdRefreshTick);
+    }
+#endif
+    if (epdRefreshCount < 0xff)
+    {
+        epdRefreshCount++;
+    }
 }
 
 void EpdInitFull(void)
 {
-    EpdW21Init(); // display
-    //    EpdW21WirteLUT((unsigned char *) LUTDefault_full, sizeof(LUTDefault_full));
+#if EPD_W21_REPORT
+    unsigned long start = HAL_GetTick();
 
-    //    EpdW21PowerOn();
+    EpdW21Init(); // display
+    printf("epd: init %lu ms\r\n", HAL_GetTick() - start);
+#else
+    EpdW21Init(); // display
+#endif
 }
 
 void EpdDisFull(unsigned char *DisBuffer, unsigned char Label)
 {
+    EpdW21Wake();
     //    EpdW21SetRamPointer(0x00, (yDot - 1) % 256, (yDot - 1) / 256);    // set ram
     if (Label == 0)
     {
@@ -320,5 +435,90 @@ void EpdDisFull(unsigned char *DisBuffer, unsigned char Label)
     {
         EpdW21WriteDispRam(xDot, yDot, (unsigned char *)DisBuffer); // white
     }
-    EpdW21Update();
+    EpdW21Update(EPD_WAVE_FULL);
+}
+
+/* Streaming: the frame goes to the controller RAM as it arrives, in pieces */
+
+void EpdStreamBegin(void)
+{
+    EpdW21Wake();
+    ReadBusy();
+    epdRamCmd = 0x24;
+    EpdW21SetRamPointer(0x00, (yDot - 1) % 256, (yDot - 1) / 256); // first byte of the frame
+}
+
+void EpdStreamPlane(unsigned char plane)
+{
+    EpdW21Wake();
+    ReadBusy();
+    epdRamCmd = (plane == EPD_PLANE_RED) ? 0x26 : 0x24;
+    EpdW21SetRamPointer(0x00, (yDot - 1) % 256, (yDot - 1) / 256);
+}
+
+void EpdStreamSeek(unsigned int offset)
+{
+    unsigned int row = (yDot - 1) - offset / (xDot / 8); // Y decrease
+
+    EpdW21Wake();
+    EpdW21SetRamPointer(offset % (xDot / 8), row % 256, row / 256);
+}
+
+void EpdStreamWrite(const unsigned char *data, unsigned int len)
+{
+    EpdW21Wake();
+    EpdW21WriteData(epdRamCmd, data, len); // continues at the RAM address counter
+}
+
+unsigned char EpdSelectWave(unsigned char content)
+{
+    if ((epdTemp < EPD_FAST_MIN_TEMP) || (epdSinceFull >= EPD_FULL_EVERY))
+    {
+        return EPD_WAVE_FULL;
+    }
+    if ((content == EPD_CONTENT_DELTA) && epdOldValid && (epdTemp >= EPD_PART_MIN_TEMP))
+    {
+        return EPD_WAVE_PART;
+    }
+    return EPD_WAVE_FAST;
+}
+
+void EpdStreamEnd(unsigned char content)
+{
+    EpdW21Wake();
+    EpdW21Update(EpdSelectWave(content)); // starts the waveform, BUSY stays high until it is done
+}
+
+unsigned char EpdIsBusy(void)
+{
+    if (epdPower != EPD_POWER_ON)
+    {
+        return 0; // BUSY is meaningless in deep sleep
+    }
+    return (isEPD_W21_BUSY != EPD_W21_BUSY_LEVEL);
+}
+
+/* Call from the main loop: deep sleep as soon as a refresh has finished.
+ * shown is the frame now on the panel, NULL if it is not at hand any more;
+ * it goes to RED RAM as the old frame of the next partial update. */
+void EpdPowerProcess(const unsigned char *shown)
+{
+    if (!epdRefreshing || (epdPower != EPD_POWER_ON) || EpdIsBusy())
+    {
+        return;
+    }
+
+    epdRefreshing = 0;
+#if EPD_W21_REPORT
+    printf("epd: %s refresh %lu ms at %d C, sleeping\r\n", epdWaveName[epdWave],
+           epdBusyFallTick - epdRefreshTick, epdTemp);
+#endif
+    if (shown != 0)
+    {
+        EpdStreamPlane(EPD_PLANE_RED);
+        EpdStreamWrite(shown, (xDot / 8) * yDot);
+        epdRamCmd = 0x24;
+        epdOldValid = 1;
+    }
+    EpdW21Sleep();
 }
@@ -12,6 +12,41 @@ extern void EpdInitFull(void);
 
 extern void EpdInitPart(void);
 
+extern void EpdStreamBegin(void);
+
+extern void EpdStreamSeek(unsigned int offset);
+
+extern void EpdStreamPlane(unsigned char plane);
+
+extern void EpdStreamWrite(const unsigned char *data, unsigned int len);
+
+extern unsigned char EpdSelectWave(unsigned char content);
+
+extern void EpdStreamEnd(unsigned char content);
+
+extern unsigned char EpdIsBusy(void);
+
+extern void EpdPowerProcess(const unsigned char *shown);
+
+extern void EpdBusyIrq(void);
+
+/* What an update carries, picks the waveform with the panel temperature */
+#define EPD_CONTENT_FRAME 0 // a whole new frame
+#define EPD_CONTENT_DELTA 1 // a few blocks changed
+
+#define EPD_WAVE_FULL 0 // OTP waveform, clears ghosting
+#define EPD_WAVE_FAST 1 // OTP waveform of a hot panel
+#define EPD_WAVE_PART 2 // OTP mode 2, needs the old frame in RED RAM
+
+#define EPD_PLANE_BW  0 // RAM 0x24, the new frame
+#define EPD_PLANE_RED 1 // RAM 0x26, the old frame
+
+/* Print init, wake and refresh times on the UART, for bench measurements:
+   the blocking prints cost harvested energy */
+#ifndef EPD_W21_REPORT
+#define EPD_W21_REPORT 0
+#endif
+
 extern void SpiWrite(unsigned char value);
 
 #define EPD_W21_MOSI_0    HAL_GPIO_WritePin(GPIOA,GPIO_PIN_5,GPIO_PIN_RESET)
@@ -43,6 +43,21 @@
  * @{
  */
 /* Private typedef -----------------------------------------------------------*/
+/** @defgroup X_NUCLEO_NFC04A1_NFCTAG_Private_Types
+ * @{
+ */
+/**
+ * @brief  Bus transfer carrying a queued ST25DV transfer
+ */
+typedef struct
+{
+  NFC04A1_I2C_Xfer_t  Bus;    /**< First member: the bus callback gets its address */
+  ST25DV_Xfer_t      *pTag;   /**< Transfer of the component driver, NULL if free  */
+} NFC04A1_Xfer_t;
+/**
+ * @}
+ */
+
 /* Private defines -----------------------------------------------------------*/
 /** @defgroup X_NUCLEO_NFC04A1_NFCTAG_Private_Defines
  * @{
@@ -50,6 +65,8 @@
 #ifndef NULL
 #define NULL      (void *) 0
 #endif
+/** @brief Queued transfers in flight at a time */
+#define NFC04A1_XFER_MAX      2U
 /**
  * @}
  */
@@ -63,11 +80,79 @@
 static NFCTAG_DrvTypeDef *Nfctag_Drv = NULL;
 /* static uint8_t NfctagInitialized = 0; */
 static ST25DV_Object_t NfcTagObj;
+static NFC04A1_Xfer_t NfcXfer[NFC04A1_XFER_MAX];
 
 /**
  * @}
  */
 /* Private function prototypes -----------------------------------------------*/
+static int32_t NFC04A1_I2C_SubmitXfer( ST25DV_Xfer_t *pXfer );
+static void NFC04A1_I2C_XferDone( NFC04A1_I2C_Xfer_t *pBus );
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Passes a queued ST25DV transfer on to the bus
+  * @param  pXfer : transfer of the component driver
+  * @retval BSP status
+  */
+static int32_t NFC04A1_I2C_SubmitXfer( ST25DV_Xfer_t *pXfer )
+{
+  NFC04A1_Xfer_t *x = NULL;
+  uint32_t primask;
+  uint32_t i;
+  int32_t status;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  for( i = 0; i < NFC04A1_XFER_MAX; i++ )
+  {
+    if( NfcXfer[i].pTag == NULL )
+    {
+      x = &NfcXfer[i];
+      x->pTag = pXfer;
+      break;
+    }
+  }
+  __set_PRIMASK(primask);
+  if( x == NULL )
+  {
+    return BSP_ERROR_BUSY;
+  }
+
+  x->Bus.DevAddr  = pXfer->DevAddr;
+  x->Bus.Reg      = pXfer->TarAddr;
+  x->Bus.pData    = pXfer->pData;
+  x->Bus.Length   = pXfer->NbByte;
+  x->Bus.Mode     = (pXfer->Mode == ST25DV_XFER_WRITE) ? NFC04A1_I2C_XFER_WRITE_WAIT : NFC04A1_I2C_XFER_READ;
+  x->Bus.Callback = NFC04A1_I2C_XferDone;
+  pXfer->Status   = ST25DV_XFER_PENDING;
+
+  status = NFC04A1_I2C_Submit( &x->Bus );
+  if( status != BSP_ERROR_NONE )
+  {
+    x->pTag = NULL;
+  }
+  return status;
+}
+
+/**
+  * @brief  Bus completion of a transfer queued by NFC04A1_I2C_SubmitXfer()
+  * @note   Interrupt context
+  * @param  pBus : the bus transfer, first member of its NFC04A1_Xfer_t
+  * @retval None
+  */
+static void NFC04A1_I2C_XferDone( NFC04A1_I2C_Xfer_t *pBus )
+{
+  NFC04A1_Xfer_t *x = (NFC04A1_Xfer_t *)pBus;
+  ST25DV_Xfer_t *pTag = x->pTag;
+
+  x->pTag = NULL;
+  pTag->Status = pBus->Status;
+  if( pTag->Callback != NULL )
+  {
+    pTag->Callback( pTag );
+  }
+}
+
 /* Functions Definition ------------------------------------------------------*/
 /** @defgroup X_NUCLEO_NFC04A1_NFCTAG_Public_Functions
  * @{
@@ -87,6 +172,7 @@ int32_t NFC04A1_NFCTAG_Init (uint32_t Instance)
   IO.Read         = NFC04A1_I2C_ReadReg16;
   IO.Write        = (ST25DV_Write_Func)NFC04A1_I2C_WriteReg16;
   IO.GetTick      = NFC04A1_GetTick;
+  IO.Submit       = NFC04A1_I2C_SubmitXfer;
 
   status = ST25DV_RegisterBusIO (&NfcTagObj, &IO);
   if(status != NFCTAG_OK)
@@ -232,13 +318,64 @@ int32_t NFC04A1_NFCTAG_ReadData( uint32_t Instance, uint8_t * const pData, const
   */
 int32_t NFC04A1_NFCTAG_WriteData( uint32_t Instance, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size )
 {
+  ST25DV_Xfer_t xfer;
+  uint16_t done = 0;
+  uint16_t n;
+  int32_t status = NFCTAG_OK;
+
   UNUSED(Instance);
   if ( Nfctag_Drv->WriteData == NULL )
   {
     return NFCTAG_ERROR;
   }
-  
-  return Nfctag_Drv->WriteData(&NfcTagObj, pData, TarAddr, Size );
+
+  /* Queued: the bus polls for the end of the write cycle from SysTick while
+     the core sleeps, instead of spinning on IsReady */
+  xfer.Callback = NULL;
+  while( (status == NFCTAG_OK) && (done < Size) )
+  {
+    n = ((Size - done) > ST25DV_MAX_WRITE_BYTE) ? ST25DV_MAX_WRITE_BYTE : (Size - done);
+    status = ST25DV_WriteDataAsync(&NfcTagObj, &xfer, &pData[done], TarAddr + done, n );
+    if( status == NFCTAG_OK )
+    {
+      /* The bus completes it, on a timeout too */
+      while( xfer.Status == ST25DV_XFER_PENDING )
+      {
+        __WFI();
+      }
+      status = xfer.Status;
+    }
+    done += n;
+  }
+  return status;
+}
+
+/**
+  * @brief  Queues a read of data in the nfctag at specific address
+  * @param  pXfer : transfer descriptor, Status is ST25DV_XFER_PENDING until done
+  * @param  pData : pointer to store read data
+  * @param  TarAddr : I2C data memory address to read
+  * @param  Size : Size in bytes of the value to be read
+  * @retval NFCTAG enum status
+  */
+int32_t NFC04A1_NFCTAG_ReadDataAsync( uint32_t Instance, ST25DV_Xfer_t * const pXfer, uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size )
+{
+  UNUSED(Instance);
+  return ST25DV_ReadDataAsync(&NfcTagObj, pXfer, pData, TarAddr, Size );
+}
+
+/**
+  * @brief  Queues a write of data in the nfctag at specific address
+  * @param  pXfer : transfer descriptor, Status is ST25DV_XFER_PENDING until done
+  * @param  pData : pointer to the data to write
+  * @param  TarAddr : I2C data memory address to write
+  * @param  Size : Size in bytes of the value to be written
+  * @retval NFCTAG enum status
+  */
+int32_t NFC04A1_NFCTAG_WriteDataAsync( uint32_t Instance, ST25DV_Xfer_t * const pXfer, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size )
+{
+  UNUSED(Instance);
+  return ST25DV_WriteDataAsync(&NfcTagObj, pXfer, pData, TarAddr, Size );
 }
 
 /**
@@ -1060,6 +1197,28 @@ int32_t NFC04A1_NFCTAG_ReadMBLength_Dyn(uint32_t Instance, uint8_t * const pMBLe
   return ST25DV_ReadMBLength_Dyn(&NfcTagObj, pMBLength);
 }
 
+/**
+  * @brief  Reads the whole system configuration area in one transaction
+  * @param  pSys : pointer to the snapshot to fill
+  * @return int32_t enum status.
+  */
+int32_t NFC04A1_NFCTAG_ReadSysSnapshot(uint32_t Instance, ST25DV_SYS_SNAPSHOT * const pSys )
+{
+  UNUSED(Instance);
+  return ST25DV_ReadSysSnapshot(&NfcTagObj, pSys);
+}
+
+/**
+  * @brief  Reads all dynamic registers in one transaction, clears IT_STS_Dyn
+  * @param  pDyn : pointer to the snapshot to fill
+  * @return int32_t enum status.
+  */
+int32_t NFC04A1_NFCTAG_ReadDynSnapshot(uint32_t Instance, ST25DV_DYN_SNAPSHOT * const pDyn )
+{
+  UNUSED(Instance);
+  return ST25DV_ReadDynSnapshot(&NfcTagObj, pDyn);
+}
+
 
 
 /**
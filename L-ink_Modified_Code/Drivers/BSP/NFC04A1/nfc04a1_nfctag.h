@@ -74,6 +74,8 @@ int32_t NFC04A1_NFCTAG_ConfigIT( uint32_t Instance, const uint16_t ITConfig );
 int32_t NFC04A1_NFCTAG_GetITStatus( uint32_t Instance, uint16_t * const ITConfig );
 int32_t NFC04A1_NFCTAG_ReadData( uint32_t Instance, uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
 int32_t NFC04A1_NFCTAG_WriteData( uint32_t Instance, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
+int32_t NFC04A1_NFCTAG_ReadDataAsync( uint32_t Instance, ST25DV_Xfer_t * const pXfer, uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
+int32_t NFC04A1_NFCTAG_WriteDataAsync( uint32_t Instance, ST25DV_Xfer_t * const pXfer, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
 int32_t NFC04A1_NFCTAG_ReadRegister( uint32_t Instance, uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
 int32_t NFC04A1_NFCTAG_WriteRegister( uint32_t Instance, const uint8_t * const pData, const uint16_t TarAddr, const uint16_t Size );
 int32_t NFC04A1_NFCTAG_IsDeviceReady( uint32_t Instance,const uint32_t Trials );
@@ -146,6 +148,8 @@ int32_t NFC04A1_NFCTAG_GetMBEN_Dyn(uint32_t Instance, ST25DV_EN_STATUS * const p
 int32_t NFC04A1_NFCTAG_SetMBEN_Dyn(uint32_t Instance);
 int32_t NFC04A1_NFCTAG_ResetMBEN_Dyn(uint32_t Instance);
 int32_t NFC04A1_NFCTAG_ReadMBLength_Dyn(uint32_t Instance, uint8_t * const pMBLength );
+int32_t NFC04A1_NFCTAG_ReadSysSnapshot(uint32_t Instance, ST25DV_SYS_SNAPSHOT * const pSys );
+int32_t NFC04A1_NFCTAG_ReadDynSnapshot(uint32_t Instance, ST25DV_DYN_SNAPSHOT * const pDyn );
 
 
 
@@ -36,6 +36,11 @@
 #include "stdio.h"
 #include "string.h"	
 #include "epd_w21.h"
+#include "frame_store.h"
+#include "display_list.h"
+#include "eh_power.h"
+#include "clock_policy.h"
+#include "ndef_image.h"
 /** @defgroup ST25_Nucleo
   * @{
   */
@@ -46,12 +51,37 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/* Delta transfer, must match demo_fleet.h of the reader firmware */
+#define NFC_FLAG_ADDR           500     /* { flag, chunk, last, 0 }             */
+#define NFC_STATUS_ADDR         504     /* { status, chunk, frame, 0 }          */
+#define NFC_HEADER_ADDR         508     /* Slot CRC-32, big endian              */
+#define NFC_CTL_LEN             12      /* Flag, status and header block        */
+#define NFC_FLAG_SLOT           0xaa    /* Slot in 0..499: { 0xaa, slot, frame, slots } */
+#define NFC_SLOT_LEN            500
+#define NFC_SLOTS               (FRAME_STORE_LEN / NFC_SLOT_LEN)
+#define NFC_SLOT_NONE           0xff
+#define NFC_FRAME_UNKNOWN       0       /* Echoed when the flag couldn't be read, the reader never uses it */
+#define NFC_SLOT_PART           100     /* Read over DMA while the last goes out on SPI */
+#define NFC_FLAG_DELTA          0xab    /* Delta chunk in 0..499                */
+#define NFC_DELTA_HDR_LEN       8       /* Base CRC-32 + new CRC-32, big endian */
+#define NFC_DELTA_END           0xffff  /* Run start ending the chunk           */
+#define NFC_FLAG_DLIST          0xac    /* Display list in 0..499               */
+#define NFC_ST_CHUNK_OK         0x01
+#define NFC_ST_FRAME_OK         0x02
+#define NFC_ST_BASE_ERR         0xe1
+#define NFC_ST_CRC_ERR          0xe2
+#define NFC_ST_SEQ_ERR          0xe3
+#define NFC_ST_CHUNK_BAD        0xe4    /* Send the chunk in the status again   */
+#define NFC_NDEF_PART           100     /* Payload bytes read per I2C transfer  */
+#define NFC_NDEF_OUT_LEN        (NFC_SLOT_LEN - NFC_NDEF_PART)
 /* Private macro -------------------------------------------------------------*/
+#define NFC_BE16(p)             (((uint16_t)(p)[0] << 8) | (p)[1])
+#define NFC_BE32(p)             (((uint32_t)NFC_BE16(p) << 16) | NFC_BE16((p) + 2))
 /* Private variables ---------------------------------------------------------*/
+static uint8_t nfcChunk[NFC_SLOT_LEN];  //one slot or delta chunk, the frame itself is never in RAM
+static ST25DV_Xfer_t nfcXfer;
 /* Global variables ----------------------------------------------------------*/
 
-extern unsigned char nfcBuffer[];
-
 char uartmsg[80];
 
 uint32_t st25dvbmsize = 0;
@@ -67,12 +97,40 @@ uint8_t cir = 0;    //第几次循环
 
 int time = 0;
 int num = 0; 
+uint8_t slotFrame = 0;    //frame ID of the slots being received
+uint8_t slotDone = 0;     //that frame is complete, repeated slots are only acknowledged
+uint8_t slotResend = NFC_SLOT_NONE;  //slot whose flash copy is bad, asked for again
+uint32_t slotCrc[NFC_SLOTS];         //CRC-32 of each slot as the reader sent it
+uint8_t deltaActive = 0;  //stored frame matched the base CRC, chunks are applied
+uint8_t epdLive = 0;      //panel was idle at the start, the frame also goes to its RAM
+uint8_t epdPending = 0;   //stored frame waits for the running refresh to end
+uint8_t epdContent = EPD_CONTENT_FRAME;  //whole frame or delta, picks the waveform
+const unsigned char *epdShown = NULL;    //frame on the panel while the store still holds it
+uint8_t deltaChunk = 0;   //last applied chunk
+uint8_t ndefPending = 0;  //the RF side wrote the EEPROM, the NDEF area may hold a new image
 /* Private functions ---------------------------------------------------------*/
 
 void MX_NFC4_I2C_RW_DATA_Init(void);
 void MX_NFC4_I2C_R_DATA_Process(uint32_t adr);
 void MX_NFC4_I2C_W_DATA_Process(uint32_t adr,uint8_t wdata);
-int16_t checkdatainzonex(	uint32_t memindex, ST25DV_I2C_PROT_ZONE pProtZone);
+void MX_NFC4_Delta_Process(void);
+void MX_NFC4_DList_Process(void);
+static void MX_NFC4_Ndef_Init(void);
+static uint8_t MX_NFC4_Ndef_Written(void);
+static uint8_t MX_NFC4_Ndef_Covers(uint32_t adr);
+static uint8_t MX_NFC4_Private_Active(void);
+static void MX_NFC4_Ndef_Ignore(void);
+static void MX_NFC4_Ndef_Process(void);
+static void MX_NFC4_Frame_Done(void);
+static void MX_NFC4_Pending_Process(void);
+static void MX_NFC4_Clock_Transfer(void);
+static uint8_t MX_NFC4_Slot_Process(uint8_t *chunk, uint8_t *frame);
+static int32_t MX_NFC4_Slot_Read(void);
+static uint8_t MX_NFC4_Slot_Verify(uint8_t *chunk);
+static int32_t MX_NFC4_I2C_R_Block_Start(uint32_t adr, uint8_t *buf, uint16_t len);
+static int32_t MX_NFC4_I2C_R_Block_Wait(void);
+static int32_t MX_NFC4_I2C_R_Block_Process(uint32_t adr, uint8_t *buf, uint16_t len);
+int16_t checkdatainzonex(	uint32_t memindex, const ST25DV_SYS_SNAPSHOT *pSys);
 
 void MX_NFC_Init(void)
 {
@@ -87,6 +145,8 @@ void MX_NFC_Init(void)
   /* Initialize the peripherals and the NFC4 components */
 
   MX_NFC4_I2C_RW_DATA_Init();
+  MX_NFC4_Ndef_Init();
+  EhPowerInit();
 	
   //MX_NFC4_I2C_RW_DATA_Process();
   
@@ -105,28 +165,84 @@ void MX_NFC_Init(void)
 void MX_NFC_Process(void)
 {
   /* USER CODE BEGIN NFC4_Library_Process */
-  MX_NFC4_I2C_R_DATA_Process(500);//查询第500字节 
-  if(readdata==0xaa)
+  uint8_t status, chunk, frame;
+
+  if(EhPowerProcess() == EH_POWER_LOW)
+  {
+	readdata = 0;  //not even an I2C burst fits, the flag stays set until the capacitor has charged
+  }
+  else
+  {
+	MX_NFC4_I2C_R_DATA_Process(NFC_FLAG_ADDR);//查询第500字节 
+	if(((readdata == NFC_FLAG_SLOT) || (readdata == NFC_FLAG_DELTA) || (readdata == NFC_FLAG_DLIST)) &&
+	   !MX_NFC4_Private_Active() && MX_NFC4_Ndef_Covers(NFC_FLAG_ADDR))
+	{
+		readdata = 0;  //a long NDEF message, not a flag: clearing it would break the message
+	}
+  }
+  if(readdata==NFC_FLAG_DELTA)
+	{
+		HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_2);
+		time = 0;
+		MX_NFC4_Clock_Transfer();
+		MX_NFC4_Delta_Process();
+		MX_NFC4_Ndef_Ignore();  //the chunk's own RF writes
+	}
+  else if(readdata==NFC_FLAG_DLIST)
 	{
 		HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_2);
 		time = 0;
-    for(uint16_t j=0;j<500;j++)
-	  {
-	    MX_NFC4_I2C_R_DATA_Process(j);//查询第一个块
-			//nfcBuffer[(cir*500)+j] = (char)readdata;
-			nfcBuffer[num] = readdata;
-			num++;
-	  }
-		MX_NFC4_I2C_W_DATA_Process(500,0);//读完这次后 复位标志位
+		MX_NFC4_Clock_Transfer();
+		MX_NFC4_DList_Process();
+		MX_NFC4_Ndef_Ignore();  //the list's own RF writes
+	}
+  else if(readdata==NFC_FLAG_SLOT)
+	{
+		HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_2);
+		time = 0;
+		MX_NFC4_Clock_Transfer();
+		status = MX_NFC4_Slot_Process(&chunk, &frame);//边读边写入屏幕RAM
+		MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR + 2, frame);
+		MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR + 1, chunk);
+		MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR, status);
+		MX_NFC4_I2C_W_DATA_Process(NFC_FLAG_ADDR, 0);//读完这次后 复位标志位
 		HAL_Delay(100);
+		MX_NFC4_Ndef_Ignore();  //the slot's own RF writes
 		
-		if(num >= 4999)
+		if((status == NFC_ST_FRAME_OK) && !slotDone)
 		{ 
-		  EpdDisFull((unsigned char *)nfcBuffer, 1);
 			num = 0;
+			slotDone = 1;
+			MX_NFC4_Frame_Done();
 		}
 		
 	}
+	else if((EhPowerLevel() != EH_POWER_LOW) && MX_NFC4_Ndef_Written())
+	{
+		/* Quiet for one round after RF writes: the writer is done with the message */
+		HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_2);
+		time = 0;
+		MX_NFC4_Clock_Transfer();
+		MX_NFC4_Ndef_Process();
+	}
+	else
+	{
+		if((num == 0) && !deltaActive)
+		{
+			ClockPolicySet(CLOCK_IDLE);  //no transfer running, polling is slow
+		}
+		MX_NFC4_Pending_Process();
+	}
+	EpdPowerProcess(epdShown);  //刷新结束后屏幕进入深度睡眠
+	if((num == 0) && !deltaActive && !epdPending && !ndefPending && !EhPowerField())
+	{
+		/* Nothing to do until a reader comes or the refresh ends: GPO and BUSY wake it */
+		slotResend = NFC_SLOT_NONE;
+		slotDone = 0;
+		time = 0;
+		ClockPolicyStop();
+		return;
+	}
 	HAL_Delay(400);
 	
 	time+=400;
@@ -134,6 +250,9 @@ void MX_NFC_Process(void)
 	{
 	  num = 0;
 		time = 0;
+		slotResend = NFC_SLOT_NONE;
+		slotDone = 0;
+		deltaActive = 0;
 	}
   /* USER CODE END NFC4_Library_Process */
 }
@@ -163,13 +282,13 @@ void MX_NFC4_I2C_R_DATA_Process(uint32_t adr)
 {
 	uint16_t nbbytes=1;
 	uint32_t memindex = adr;
-	ST25DV_I2C_PROT_ZONE pProtZone;
+	ST25DV_SYS_SNAPSHOT sys;
 	int16_t zonexstatus;
 
-   /* Get ST25DV protection configuration */	
-	NFC04A1_NFCTAG_ReadI2CProtectZone( NFC04A1_NFCTAG_INSTANCE, &pProtZone );
+   /* Get ST25DV protection and zone configuration in one read */	
+	NFC04A1_NFCTAG_ReadSysSnapshot( NFC04A1_NFCTAG_INSTANCE, &sys );
 	
-	zonexstatus=checkdatainzonex(memindex,pProtZone);
+	zonexstatus=checkdatainzonex(memindex,&sys);
 	
 //	/* Read EEPROM */	
 	if((zonexstatus==ST25DV_NO_PROT)||(zonexstatus==ST25DV_WRITE_PROT))
@@ -187,18 +306,230 @@ void MX_NFC4_I2C_R_DATA_Process(uint32_t adr)
 	}	
 }
 
+  /**
+  * @brief  Start reading len bytes of EEPROM in one I2C transfer (DMA)
+  * @note   The protection is checked on the first and last byte
+  * @retval NFCTAG enum status
+  */
+static int32_t MX_NFC4_I2C_R_Block_Start(uint32_t adr, uint8_t *buf, uint16_t len)
+{
+	ST25DV_SYS_SNAPSHOT sys;
+	int16_t firststatus, laststatus;
+
+	NFC04A1_NFCTAG_ReadSysSnapshot( NFC04A1_NFCTAG_INSTANCE, &sys );
+
+	firststatus = checkdatainzonex(adr, &sys);
+	laststatus = checkdatainzonex(adr + len - 1, &sys);
+	if((firststatus == NFCTAG_ERROR) || (laststatus == NFCTAG_ERROR))
+	{
+		return NFCTAG_ERROR;
+	}
+	if((firststatus==ST25DV_READ_PROT)||(firststatus==ST25DV_READWRITE_PROT)||
+	   (laststatus==ST25DV_READ_PROT)||(laststatus==ST25DV_READWRITE_PROT))
+	{
+/* if I2C session is closed, present password to open session */
+		passwd.MsbPasswd = 0;
+		passwd.LsbPasswd = 0;
+		NFC04A1_NFCTAG_PresentI2CPassword(NFC04A1_NFCTAG_INSTANCE, passwd);
+	}
+
+	ret = NFC04A1_NFCTAG_ReadDataAsync(NFC04A1_NFCTAG_INSTANCE, &nfcXfer, buf, adr, len);
+	return ret;
+}
+
+  /**
+  * @brief  Sleep until the read started by MX_NFC4_I2C_R_Block_Start is done
+  * @retval NFCTAG enum status
+  */
+static int32_t MX_NFC4_I2C_R_Block_Wait(void)
+{
+	while(nfcXfer.Status == ST25DV_XFER_PENDING)
+	{
+		__WFI();
+	}
+	return nfcXfer.Status;
+}
+
+  /**
+  * @brief  Read len bytes of EEPROM in one I2C transfer (DMA)
+  * @retval NFCTAG enum status
+  */
+static int32_t MX_NFC4_I2C_R_Block_Process(uint32_t adr, uint8_t *buf, uint16_t len)
+{
+	int32_t status = MX_NFC4_I2C_R_Block_Start(adr, buf, len);
+
+	return (status == NFCTAG_OK) ? MX_NFC4_I2C_R_Block_Wait() : status;
+}
+
+  /**
+  * @brief  Read the 500 byte slot into nfcChunk, passing it on to the panel RAM
+  * @note   Read in NFC_SLOT_PART pieces: the next piece comes in over DMA
+  *         while the previous one is shifted out to the panel
+  * @retval NFCTAG enum status
+  */
+static int32_t MX_NFC4_Slot_Read(void)
+{
+	uint16_t part;
+	int32_t status;
+
+	status = MX_NFC4_I2C_R_Block_Start(0, nfcChunk, NFC_SLOT_PART);
+	for(part = 0; (status == NFCTAG_OK) && (part < NFC_SLOT_LEN); part += NFC_SLOT_PART)
+	{
+		status = MX_NFC4_I2C_R_Block_Wait();
+		if((status == NFCTAG_OK) && (part + NFC_SLOT_PART < NFC_SLOT_LEN))
+		{
+			status = MX_NFC4_I2C_R_Block_Start(part + NFC_SLOT_PART, &nfcChunk[part + NFC_SLOT_PART], NFC_SLOT_PART);
+		}
+		if((status == NFCTAG_OK) && epdLive)
+		{
+			EpdStreamWrite(&nfcChunk[part], NFC_SLOT_PART);
+		}
+	}
+	MX_NFC4_I2C_R_Block_Wait();  //nothing in flight on errors either
+	return status;
+}
+
+  /**
+  * @brief  Check the complete frame in the flash slot by slot
+  * @note   One CRC pass over the store instead of reading back every
+  *         block; the first slot that was programmed wrong is asked for again
+  * @retval NFC_ST_FRAME_OK, or NFC_ST_CHUNK_BAD with the slot in chunk
+  */
+static uint8_t MX_NFC4_Slot_Verify(uint8_t *chunk)
+{
+	uint8_t slot;
+
+	FrameStoreFlush();
+	for(slot = 0; slot < NFC_SLOTS; slot++)
+	{
+		if(FrameCrc32(FRAME_STORE_DATA + slot * NFC_SLOT_LEN, NFC_SLOT_LEN) != slotCrc[slot])
+		{
+			slotResend = slot;
+			*chunk = slot;
+			return NFC_ST_CHUNK_BAD;
+		}
+	}
+
+	slotResend = NFC_SLOT_NONE;
+	FrameStoreCommit(FrameCrc32(FRAME_STORE_DATA, FRAME_STORE_LEN));//下次只需传变化的块
+	return NFC_ST_FRAME_OK;
+}
+
+  /**
+  * @brief  Take one slot of a whole frame, streaming it to the panel RAM
+  *         and the frame store
+  * @note   The header block holds the CRC-32 of the slot. It is only stored
+  *         once it matches, a bad or unexpected one is answered with
+  *         NFC_ST_CHUNK_BAD and the slot the reader has to send next.
+  *         frame is the ID of the flag, echoed with every answer so the
+  *         reader never takes a stale status for its own.
+  * @retval NFC_ST_* status, chunk is the slot it refers to
+  */
+static uint8_t MX_NFC4_Slot_Process(uint8_t *chunk, uint8_t *frame)
+{
+	uint8_t ctl[NFC_CTL_LEN];
+	uint8_t slot;
+	uint32_t crc;
+
+	*chunk = num / NFC_SLOT_LEN;
+	*frame = NFC_FRAME_UNKNOWN;
+	if(MX_NFC4_I2C_R_Block_Process(NFC_FLAG_ADDR, ctl, sizeof(ctl)) != NFCTAG_OK)
+	{
+		return NFC_ST_CHUNK_BAD;  //slot and frame unknown: the reader sends the slot again
+	}
+	slot = ctl[1];
+	*frame = ctl[2];
+	crc = NFC_BE32(&ctl[NFC_HEADER_ADDR - NFC_FLAG_ADDR]);
+
+	if((ctl[3] != NFC_SLOTS) || (slot >= NFC_SLOTS))
+	{
+		return NFC_ST_SEQ_ERR;  //not a frame for this panel
+	}
+	if((*frame == slotFrame) && slotDone)
+	{
+		*chunk = slot;
+		return NFC_ST_FRAME_OK;  //the reader missed the answer, the frame is in already
+	}
+
+	if((slot == 0) && ((*frame != slotFrame) || (num <= NFC_SLOT_LEN)))
+	{
+		num = 0;  //new frame, or its first slot again
+		slotFrame = *frame;
+		slotDone = 0;
+		slotResend = NFC_SLOT_NONE;
+	}
+	else if(*frame != slotFrame)
+	{
+		*chunk = 0;
+		return NFC_ST_CHUNK_BAD;  //joined in the middle of a frame
+	}
+	else if(slotResend != NFC_SLOT_NONE)
+	{
+		*chunk = slotResend;
+		if(slot != slotResend)
+		{
+			return NFC_ST_CHUNK_BAD;
+		}
+		/* The panel RAM took it right the first time, only the flash is patched */
+		if((MX_NFC4_I2C_R_Block_Process(0, nfcChunk, NFC_SLOT_LEN) != NFCTAG_OK) || (crc != slotCrc[slot]) ||
+		   (FrameCrc32(nfcChunk, NFC_SLOT_LEN) != crc) ||
+		   (FrameStorePatch(slot * NFC_SLOT_LEN, nfcChunk, NFC_SLOT_LEN) != HAL_OK))
+		{
+			return NFC_ST_CHUNK_BAD;
+		}
+		return MX_NFC4_Slot_Verify(chunk);
+	}
+	else if(slot * NFC_SLOT_LEN < num)
+	{
+		*chunk = slot;
+		return NFC_ST_CHUNK_OK;  //the reader missed the answer, it is stored already
+	}
+	else if(slot * NFC_SLOT_LEN > num)
+	{
+		return NFC_ST_CHUNK_BAD;  //one got lost
+	}
+
+	if(num == 0)
+	{
+		deltaActive = 0;
+		epdContent = EPD_CONTENT_FRAME;
+		epdShown = NULL;  //the store no longer holds it
+		FrameStoreBegin();
+		/* Panel still refreshing the last frame: this one is only stored */
+		epdLive = !EpdIsBusy();
+		if(epdLive)
+		{
+			EpdStreamBegin();
+		}
+	}
+	else if(epdLive)
+	{
+		EpdStreamSeek(num);  //overwrite what a bad try of this slot left in the RAM
+	}
+
+	if((MX_NFC4_Slot_Read() != NFCTAG_OK) || (FrameCrc32(nfcChunk, NFC_SLOT_LEN) != crc))
+	{
+		return NFC_ST_CHUNK_BAD;
+	}
+	FrameStoreAppend(nfcChunk, NFC_SLOT_LEN);
+	slotCrc[slot] = crc;
+	num += NFC_SLOT_LEN;
+
+	return (num < FRAME_STORE_LEN) ? NFC_ST_CHUNK_OK : MX_NFC4_Slot_Verify(chunk);
+}
+
 void MX_NFC4_I2C_W_DATA_Process(uint32_t adr,uint8_t wdata)
 {
 	uint32_t memindex = adr;
 
 	uint8_t writedata = wdata;
-	ST25DV_I2C_PROT_ZONE pProtZone;
+	ST25DV_SYS_SNAPSHOT sys;
 	int16_t zonexstatus;
 
-  /* Get ST25DV protection configuration */	
-	NFC04A1_NFCTAG_ReadI2CProtectZone( NFC04A1_NFCTAG_INSTANCE, &pProtZone );
+  /* Get ST25DV protection and zone configuration in one read */	
+	NFC04A1_NFCTAG_ReadSysSnapshot( NFC04A1_NFCTAG_INSTANCE, &sys );
 	
-	zonexstatus=checkdatainzonex(memindex,pProtZone);
+	zonexstatus=checkdatainzonex(memindex,&sys);
 
 	/* Write EEPROM */		
 	if((zonexstatus==ST25DV_NO_PROT)||(zonexstatus==ST25DV_READ_PROT))
@@ -215,8 +546,405 @@ void MX_NFC4_I2C_W_DATA_Process(uint32_t adr,uint8_t wdata)
 	}	
 }
 
-int16_t checkdatainzonex(uint32_t memindex, ST25DV_I2C_PROT_ZONE pProtZone)
+  /**
+  * @brief  Apply one delta chunk to the stored frame and the panel RAM
+  * @note   Chunk layout: base CRC (4), new CRC (4), then runs of
+  *         first block (2), count (1), count*4 bytes, ended by 0xffff.
+  *         The result goes to the status block before the flag is cleared.
+  * @retval None
+  */
+void MX_NFC4_Delta_Process(void)
 {
+	uint32_t baseCrc, newCrc, storedCrc;
+	uint32_t pos;
+	uint16_t blk;
+	uint8_t chunk, last, cnt, status;
+
+	MX_NFC4_I2C_R_DATA_Process(NFC_FLAG_ADDR + 1);
+	chunk = readdata;
+	MX_NFC4_I2C_R_DATA_Process(NFC_FLAG_ADDR + 2);
+	last = readdata;
+	num = 0;  //a partly received full frame is void now
+	slotResend = NFC_SLOT_NONE;
+	slotDone = 0;
+
+	if(MX_NFC4_I2C_R_Block_Process(0, nfcChunk, NFC_SLOT_LEN) != NFCTAG_OK)
+	{
+		status = NFC_ST_CRC_ERR;  //the reader falls back to the whole frame
+	}
+	else if(chunk == 0)
+	{
+		baseCrc = NFC_BE32(&nfcChunk[0]);
+		/* A repeated chunk 0 was already checked and applied */
+		if(!deltaActive || (deltaChunk != 0))
+		{
+			deltaActive = FrameStoreValid(&storedCrc) && (storedCrc == baseCrc);
+			epdContent = EPD_CONTENT_DELTA;
+			epdShown = NULL;  //the store is patched from here on
+			epdLive = deltaActive && !EpdIsBusy();
+			if(epdLive)
+			{
+				/* Panel RAM starts from the stored frame, runs are patched over it */
+				EpdStreamBegin();
+				EpdStreamWrite(FRAME_STORE_DATA, FRAME_STORE_LEN);
+			}
+		}
+		status = deltaActive ? NFC_ST_CHUNK_OK : NFC_ST_BASE_ERR;
+	}
+	else
+	{
+		/* Next chunk, or the last one again if the reader missed our status */
+		status = (deltaActive && ((chunk == deltaChunk) || (chunk == deltaChunk + 1))) ? NFC_ST_CHUNK_OK : NFC_ST_SEQ_ERR;
+	}
+	newCrc = NFC_BE32(&nfcChunk[4]);
+
+	pos = NFC_DELTA_HDR_LEN;
+	while(status == NFC_ST_CHUNK_OK)
+	{
+		if(pos + 2 > NFC_FLAG_ADDR)
+		{
+			status = NFC_ST_CRC_ERR;  //no end marker
+			break;
+		}
+		blk = NFC_BE16(&nfcChunk[pos]);
+		if(blk == NFC_DELTA_END)
+		{
+			break;
+		}
+		if(pos + 3 > NFC_FLAG_ADDR)
+		{
+			status = NFC_ST_CRC_ERR;  //run header cut off
+			break;
+		}
+		cnt = nfcChunk[pos + 2];
+		pos += 3;
+		if(((blk + cnt) * 4 > FRAME_STORE_LEN) || (pos + cnt * 4 > NFC_FLAG_ADDR))
+		{
+			status = NFC_ST_CRC_ERR;  //malformed chunk
+			break;
+		}
+		/* Patch in place, runs are idempotent */
+		if(epdLive)
+		{
+			EpdStreamSeek(blk * 4);
+			EpdStreamWrite(&nfcChunk[pos], cnt * 4);
+		}
+		if(FrameStorePatch(blk * 4, &nfcChunk[pos], cnt * 4) != HAL_OK)
+		{
+			status = NFC_ST_CRC_ERR;
+			break;
+		}
+		pos += cnt * 4;
+	}
+
+	if((status == NFC_ST_CHUNK_OK) && last)
+	{
+		status = (FrameCrc32(FRAME_STORE_DATA, FRAME_STORE_LEN) == newCrc) ? NFC_ST_FRAME_OK : NFC_ST_CRC_ERR;
+	}
+	if(status == NFC_ST_CHUNK_OK)
+	{
+		deltaChunk = chunk;
+	}
+	else
+	{
+		deltaActive = 0;  //done or failed: the reader sends the whole frame on errors
+	}
+
+	MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR + 1, chunk);
+	MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR, status);
+	MX_NFC4_I2C_W_DATA_Process(NFC_FLAG_ADDR, 0);//读完这次后 复位标志位
+	HAL_Delay(100);
+
+	if(status == NFC_ST_FRAME_OK)
+	{
+		FrameStoreCommit(newCrc);
+		MX_NFC4_Frame_Done();
+	}
+}
+
+  /**
+  * @brief  Render a display list to the panel RAM and the frame store
+  * @note   One row at a time, see display_list.h for the layout.
+  *         The result goes to the status block before the flag is cleared.
+  * @retval None
+  */
+void MX_NFC4_DList_Process(void)
+{
+	uint8_t line[DLIST_LINE_LEN];
+	uint8_t status = NFC_ST_CRC_ERR;
+	uint16_t y;
+
+	num = 0;  //a partly received full frame is void now
+	slotResend = NFC_SLOT_NONE;
+	slotDone = 0;
+	deltaActive = 0;
+
+	if((MX_NFC4_I2C_R_Block_Process(0, nfcChunk, NFC_FLAG_ADDR) == NFCTAG_OK) && DListCheck(nfcChunk, NFC_FLAG_ADDR))
+	{
+		epdContent = EPD_CONTENT_FRAME;
+		epdShown = NULL;  //the store no longer holds it
+		FrameStoreBegin();
+		epdLive = !EpdIsBusy();
+		if(epdLive)
+		{
+			EpdStreamBegin();
+		}
+		for(y = 0; y < DLIST_HEIGHT; y++)
+		{
+			DListRenderLine(nfcChunk, y, line);
+			if(epdLive)
+			{
+				EpdStreamWrite(line, DLIST_LINE_LEN);
+			}
+			FrameStoreAppend(line, DLIST_LINE_LEN);
+		}
+		status = NFC_ST_FRAME_OK;
+	}
+
+	MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR + 1, 0);
+	MX_NFC4_I2C_W_DATA_Process(NFC_STATUS_ADDR, status);
+	MX_NFC4_I2C_W_DATA_Process(NFC_FLAG_ADDR, 0);//读完这次后 复位标志位
+	HAL_Delay(100);
+
+	if(status == NFC_ST_FRAME_OK)
+	{
+		FrameStoreFlush();  //the CRC covers the staged tail too
+		FrameStoreCommit(FrameCrc32(FRAME_STORE_DATA, FRAME_STORE_LEN));
+		MX_NFC4_Frame_Done();
+	}
+}
+
+  /**
+  * @brief  Latch RF writes in IT_STS_Dyn, they are only reported while
+  *         their GPO interrupt is enabled
+  * @retval None
+  */
+static void MX_NFC4_Ndef_Init(void)
+{
+	uint16_t gpo;
+
+	if((NFC04A1_NFCTAG_GetITStatus(NFC04A1_NFCTAG_INSTANCE, &gpo) == NFCTAG_OK) &&
+	   ((gpo & ST25DV_GPO_RFWRITE_MASK) == 0))
+	{
+		passwd.MsbPasswd = 0;
+		passwd.LsbPasswd = 0;
+		NFC04A1_NFCTAG_PresentI2CPassword(NFC04A1_NFCTAG_INSTANCE, passwd);
+		NFC04A1_NFCTAG_ConfigIT(NFC04A1_NFCTAG_INSTANCE, gpo | ST25DV_GPO_RFWRITE_MASK);
+	}
+}
+
+  /**
+  * @brief  Track RF writes to the EEPROM
+  * @note   Reading IT_STS_Dyn clears it
+  * @retval 1 once a round passed without writes after some were seen
+  */
+static uint8_t MX_NFC4_Ndef_Written(void)
+{
+	uint8_t itsts;
+
+	if(MX_NFC4_Private_Active())
+	{
+		MX_NFC4_Ndef_Ignore();  //slot and chunk writes, not a message
+		return 0;
+	}
+	if((NFC04A1_NFCTAG_ReadITSTStatus_Dyn(NFC04A1_NFCTAG_INSTANCE, &itsts) == NFCTAG_OK) &&
+	   (itsts & ST25DV_ITSTS_DYN_RFWRITE_MASK))
+	{
+		ndefPending = 1;
+		return 0;
+	}
+	return ndefPending;
+}
+
+  /**
+  * @brief  Drop the RF writes latched so far, they belong to a private
+  *         transfer
+  * @note   Reading IT_STS_Dyn clears it
+  * @retval None
+  */
+static void MX_NFC4_Ndef_Ignore(void)
+{
+	uint8_t itsts;
+
+	NFC04A1_NFCTAG_ReadITSTStatus_Dyn(NFC04A1_NFCTAG_INSTANCE, &itsts);
+	ndefPending = 0;
+}
+
+  /**
+  * @brief  Check whether a slot or delta transfer is under way
+  * @retval 1 if the EEPROM holds its data, not an NDEF message
+  */
+static uint8_t MX_NFC4_Private_Active(void)
+{
+	return ((num != 0) || deltaActive || (slotResend != NFC_SLOT_NONE)) ? 1 : 0;
+}
+
+  /**
+  * @brief  Check whether an NDEF message holds the byte at adr
+  * @retval 1 if it does
+  */
+static uint8_t MX_NFC4_Ndef_Covers(uint32_t adr)
+{
+	NdefImageInfo img;
+
+	if(MX_NFC4_I2C_R_Block_Process(0, nfcChunk, NDEF_IMAGE_HEAD_LEN) != NFCTAG_OK)
+	{
+		return 0;
+	}
+	NdefImageFind(nfcChunk, NDEF_IMAGE_HEAD_LEN, st25dvbmsize, &img);
+	return (img.MessageEnd > adr) ? 1 : 0;
+}
+
+  /**
+  * @brief  Show the image record an NFC Forum writer left in the EEPROM
+  * @note   See ndef_image.h for the record. The payload is read in
+  *         NFC_NDEF_PART pieces and unpacked into the rest of nfcChunk; a
+  *         compressed one is unpacked twice, the first pass only checks
+  *         that it makes exactly one frame before the store is erased.
+  *         Nothing is written back, the message stays as the writer left it.
+  * @retval None
+  */
+static void MX_NFC4_Ndef_Process(void)
+{
+	NdefImageInfo img;
+	NdefImageUnpacker unpack;
+	uint8_t *out = &nfcChunk[NFC_NDEF_PART];
+	uint16_t pos, piece, used, made, left;
+	uint32_t total;
+	uint8_t pass, ok;
+
+	ndefPending = 0;
+	if((MX_NFC4_I2C_R_Block_Process(0, nfcChunk, NDEF_IMAGE_HEAD_LEN) != NFCTAG_OK) ||
+	   !NdefImageFind(nfcChunk, NDEF_IMAGE_HEAD_LEN, st25dvbmsize, &img) ||
+	   ((img.Format == NDEF_IMAGE_RAW) && (img.PayloadLen != FRAME_STORE_LEN)))
+	{
+		return;  //other records, or a private transfer wrote the EEPROM
+	}
+
+	num = 0;  //a partly received full frame is void now
+	slotResend = NFC_SLOT_NONE;
+	slotDone = 0;
+	deltaActive = 0;
+
+	ok = 1;
+	for(pass = (img.Format == NDEF_IMAGE_RAW) ? 1 : 0; ok && (pass < 2); pass++)
+	{
+		if(pass == 1)
+		{
+			epdContent = EPD_CONTENT_FRAME;
+			epdShown = NULL;  //the store no longer holds it
+			FrameStoreBegin();
+			epdLive = !EpdIsBusy();
+			if(epdLive)
+			{
+				EpdStreamBegin();
+			}
+		}
+		NdefImageUnpackInit(&unpack, img.Format);
+		total = 0;
+		for(pos = 0; ok && (pos < img.PayloadLen); pos += piece)
+		{
+			piece = img.PayloadLen - pos;
+			piece = (piece < NFC_NDEF_PART) ? piece : NFC_NDEF_PART;
+			if(MX_NFC4_I2C_R_Block_Process(img.PayloadAddr + pos, nfcChunk, piece) != NFCTAG_OK)
+			{
+				ok = 0;
+				break;
+			}
+			for(left = 0; ok && (left < piece); left += used)
+			{
+				made = FRAME_STORE_LEN - total;
+				made = NdefImageUnpack(&unpack, &nfcChunk[left], piece - left, (pass == 1) ? out : NULL,
+				                       (made < NFC_NDEF_OUT_LEN) ? made : NFC_NDEF_OUT_LEN, &used);
+				if((made == 0) && (used == 0))
+				{
+					ok = 0;  //more payload than one frame
+					break;
+				}
+				if((pass == 1) && (made != 0))
+				{
+					if(epdLive)
+					{
+						EpdStreamWrite(out, made);
+					}
+					FrameStoreAppend(out, made);
+				}
+				total += made;
+			}
+		}
+		if((total != FRAME_STORE_LEN) || !NdefImageUnpackDone(&unpack))
+		{
+			ok = 0;
+		}
+	}
+
+	if(ok)
+	{
+		FrameStoreFlush();  //the CRC covers the staged tail too
+		FrameStoreCommit(FrameCrc32(FRAME_STORE_DATA, FRAME_STORE_LEN));
+		MX_NFC4_Frame_Done();
+	}
+}
+
+  /**
+  * @brief  A whole frame is in the store: refresh now if it is in the
+  *         panel RAM too and the energy budget allows a refresh, else once
+  *         the running refresh has ended and the capacitor has charged
+  * @retval None
+  */
+static void MX_NFC4_Frame_Done(void)
+{
+	if(epdLive && (EhPowerLevel() == EH_POWER_REFRESH))
+	{
+		EpdStreamEnd(epdContent);  //returns at once, the panel works on its own
+		epdShown = FRAME_STORE_DATA;
+		epdLive = 0;
+		epdPending = 0;
+	}
+	else
+	{
+		epdPending = 1;
+	}
+}
+
+  /**
+  * @brief  Clock for a transfer or refresh: the 32 MHz PLL only while the
+  *         harvested supply is up to a panel refresh, else stay on MSI
+  * @retval None
+  */
+static void MX_NFC4_Clock_Transfer(void)
+{
+	ClockPolicySet((EhPowerLevel() == EH_POWER_REFRESH) ? CLOCK_RUN : CLOCK_IDLE);
+}
+
+  /**
+  * @brief  Show a frame received during the last refresh
+  * @note   Only between transfers, the store must hold a complete frame
+  * @retval None
+  */
+static void MX_NFC4_Pending_Process(void)
+{
+	uint32_t crc;
+
+	if(!epdPending || EpdIsBusy() || (num != 0) || deltaActive || (EhPowerLevel() != EH_POWER_REFRESH))
+	{
+		return;
+	}
+
+	epdPending = 0;
+	if(FrameStoreValid(&crc))
+	{
+		MX_NFC4_Clock_Transfer();
+		EpdStreamBegin();
+		EpdStreamWrite(FRAME_STORE_DATA, FRAME_STORE_LEN);
+		EpdStreamEnd(epdContent);
+		epdShown = FRAME_STORE_DATA;
+	}
+}
+
+int16_t checkdatainzonex(uint32_t memindex, const ST25DV_SYS_SNAPSHOT *pSys)
+{
+	ST25DV_I2C_PROT_ZONE pProtZone;
 	uint16_t zonexstatus;
 	uint8_t end1_addr; 
 	uint8_t end2_addr;
@@ -226,14 +954,15 @@ int16_t checkdatainzonex(uint32_t memindex, ST25DV_I2C_PROT_ZONE pProtZone)
 	uint32_t lastbyte_zone3 = 0;
 	uint32_t lastbyte_zone4 = 0;	
 	
-	NFC04A1_NFCTAG_ReadEndZonex(NFC04A1_NFCTAG_INSTANCE, ST25DV_ZONE_END1, &end1_addr);
+	ST25DV_SysGetI2CProtectZone(pSys, &pProtZone);
+	end1_addr = ST25DV_SysGetEndZonex(pSys, ST25DV_ZONE_END1);
 	lastbyte_zone1 = 32*end1_addr+31;	
-	NFC04A1_NFCTAG_ReadEndZonex(NFC04A1_NFCTAG_INSTANCE, ST25DV_ZONE_END2, &end2_addr);	
+	end2_addr = ST25DV_SysGetEndZonex(pSys, ST25DV_ZONE_END2);	
 	lastbyte_zone2 = 32*end2_addr+31;
-	NFC04A1_NFCTAG_ReadEndZonex(NFC04A1_NFCTAG_INSTANCE, ST25DV_ZONE_END3, &end3_addr);
+	end3_addr = ST25DV_SysGetEndZonex(pSys, ST25DV_ZONE_END3);
 	lastbyte_zone3 = 32*end3_addr+31;
 	/* Get ST25DV EEPROM size */
-	NFC04A1_NFCTAG_ReadMemSize(NFC04A1_NFCTAG_INSTANCE, &st25dvmemsize); 
+	ST25DV_SysGetMemSize(pSys, &st25dvmemsize); 
 	/* st25dvmemsize is composed of Mem_Size (number of blocks) and BlockSize (size of each blocks in bytes) */
 	st25dvbmsize = (st25dvmemsize.Mem_Size + 1) * (st25dvmemsize.BlockSize + 1);	
 	lastbyte_zone4 = st25dvbmsize -1;	
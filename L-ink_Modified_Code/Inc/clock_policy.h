@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file           : clock_policy.h
+  * @brief          : System clock by activity: fast bursts, slow polling, STOP
+  ******************************************************************************
+  * Receiving and rendering a frame runs from the PLL at 32 MHz (range 1),
+  * polling the tag between transfers from MSI at 2.1 MHz (range 3), and
+  * with no field and nothing pending the core stops until the ST25DV GPO
+  * (field change) or the panel BUSY line raises an EXTI. I2C timing and
+  * the UART baud rate divider follow each switch.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CLOCK_POLICY_H
+#define CLOCK_POLICY_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l0xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define CLOCK_RUN           0   /* PLL 32 MHz, voltage range 1 */
+#define CLOCK_IDLE          1   /* MSI 2.1 MHz, voltage range 3 */
+#define CLOCK_STOP          2   /* STOP mode, wakes up in CLOCK_IDLE */
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start in CLOCK_IDLE, call once after the peripherals are set up
+  * @retval None
+  */
+void ClockPolicyInit(void);
+
+/**
+  * @brief  Switch to CLOCK_RUN or CLOCK_IDLE, nothing if already there
+  * @note   Waits for queued I2C transfers and the last UART byte
+  * @retval None
+  */
+void ClockPolicySet(uint8_t Mode);
+
+/**
+  * @brief  Current mode
+  * @retval CLOCK_RUN or CLOCK_IDLE
+  */
+uint8_t ClockPolicyGet(void);
+
+/**
+  * @brief  Print the time spent in each mode since the last STOP, then
+  *         STOP until an EXTI wakes the core
+  * @retval None
+  */
+void ClockPolicyStop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOCK_POLICY_H */
@@ -58,11 +58,59 @@
 #ifndef BUS_I2C1_POLL_TIMEOUT
    #define BUS_I2C1_POLL_TIMEOUT                0x1000U   
 #endif
+#ifndef BUS_I2C1_WRITE_POLL
+   #define BUS_I2C1_WRITE_POLL                  1U      /* ms between ready polls after a write  */
+#endif
+#ifndef BUS_I2C1_WRITE_TIMEOUT
+   #define BUS_I2C1_WRITE_TIMEOUT               320U    /* Longest EEPROM write cycle in ms      */
+#endif
+#define BUS_I2C1_DMA_THRESHOLD                  8U      /* Shorter transfers run on interrupts   */
+
+/* Queued transfer modes */
+#define BUS_I2C_XFER_READ                       0U      /* Memory read                           */
+#define BUS_I2C_XFER_WRITE                      1U      /* Memory write                          */
+#define BUS_I2C_XFER_WRITE_WAIT                 2U      /* Write, then wait for the write cycle  */
+
+/* Queued transfer status while it has not completed */
+#define BUS_I2C_XFER_PENDING                    1
+
 /* I2C1 Frequeny in Hz  */
 #ifndef BUS_I2C1_FREQUENCY  
-   #define BUS_I2C1_FREQUENCY  1000000U /* Frequency of I2Cn = 100 KHz*/
+   #define BUS_I2C1_FREQUENCY  1000000U /* Frequency of I2Cn = 1 MHz*/
 #endif
 
+/* I2C1 speed profiles, the timing is computed from the PCLK1 kernel clock */
+#define BUS_I2C1_SPEED_100K                     0U      /* Standard mode                         */
+#define BUS_I2C1_SPEED_400K                     1U      /* Fast mode                             */
+#define BUS_I2C1_SPEED_1M                       2U      /* Fast mode Plus, 20 mA drive on PB6/7  */
+#ifndef BUS_I2C1_DOWNSHIFT_ERRORS
+   #define BUS_I2C1_DOWNSHIFT_ERRORS            4U      /* Errors in a row before slowing down   */
+#endif
+
+/**
+  * @}
+  */
+
+/** @defgroup CUSTOM_BUS_Exported_Types CUSTOM BUS Exported types
+  * @{
+  */
+
+/**
+  * @brief  Queued I2C transfer, see BSP_I2C1_Submit()
+  */
+typedef struct BSP_I2C_Xfer BSP_I2C_Xfer_t;
+struct BSP_I2C_Xfer
+{
+  uint16_t          DevAddr;                    /* Device address                        */
+  uint16_t          Reg;                        /* 16 bit memory / register address      */
+  uint8_t          *pData;                      /* Data buffer, must stay valid          */
+  uint16_t          Length;                     /* Data length                           */
+  uint8_t           Mode;                       /* BUS_I2C_XFER_xxx                      */
+  volatile int32_t  Status;                     /* BUS_I2C_XFER_PENDING, then BSP status */
+  void            (*Callback)(BSP_I2C_Xfer_t *);/* Optional, runs in interrupt context   */
+  BSP_I2C_Xfer_t   *Next;                       /* Queue link, owned by the bus          */
+};
+
 /**
   * @}
   */
@@ -86,6 +134,8 @@ typedef struct
   */
 
 extern I2C_HandleTypeDef hi2c1;
+extern DMA_HandleTypeDef hdma_i2c1_rx;
+extern DMA_HandleTypeDef hdma_i2c1_tx;
 
 /**
   * @}
@@ -107,6 +157,12 @@ int32_t BSP_I2C1_ReadReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t
 int32_t BSP_I2C1_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
 int32_t BSP_I2C1_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
 int32_t BSP_I2C1_SendRecv(uint16_t DevAddr, uint8_t *pTxdata, uint8_t *pRxdata, uint16_t Length);
+int32_t BSP_I2C1_Submit(BSP_I2C_Xfer_t *pXfer);
+uint8_t BSP_I2C1_IsIdle(void);
+int32_t BSP_I2C1_SetSpeed(uint32_t Speed);
+uint32_t BSP_I2C1_GetSpeed(void);
+void BSP_I2C1_ClockUpdate(void);
+void BSP_I2C1_Tick(void);
 #if (USE_HAL_I2C_REGISTER_CALLBACKS == 1U)
 int32_t BSP_I2C1_RegisterDefaultMspCallbacks (void);
 int32_t BSP_I2C1_RegisterMspCallbacks (BSP_I2C_Cb_t *Callbacks);
@@ -41,7 +41,7 @@
 #define BSP_BUTTON_USER_IT_PRIORITY         15U
 
 /* I2C1 Frequeny in Hz  */
-#define BUS_I2C1_FREQUENCY                  100000U /* Frequency of I2C1 = 100 KHz*/
+#define BUS_I2C1_FREQUENCY                  1000000U /* Frequency of I2C1 = 1 MHz, the ST25DV supports FM+ */
 
 /* SPI1 Baud rate in bps  */
 #define BUS_SPI1_BAUDRATE                   16000000U /* baud rate of SPIn = 16 Mbps */
@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file           : display_list.h
+  * @brief          : Renders a compact list of drawing commands to the panel
+  ******************************************************************************
+  * Instead of a 5000 byte bitmap the reader can send a display list of a few
+  * hundred bytes: text, lines, rectangles, sprites and QR module matrices.
+  * It is rasterised one 200 pixel row at a time, so no frame buffer is
+  * needed; each row goes to the panel RAM and the frame store as it is done.
+  * The reader (epd-demo) builds lists with its dlist.c encoder and sends
+  * them with demoFleetRunList(), flag 0xac; KEY_UP + KEY_OK sends a demo label.
+  *
+  * Layout, coordinates in pixels from the top left corner:
+  *   version (1) = DLIST_VERSION, background (1) = DLIST_INK_*
+  *   then commands, each an opcode followed by its arguments:
+  *   DLIST_OP_TEXT   x, y, font, len, len characters
+  *   DLIST_OP_LINE   x0, y0, x1, y1, ink
+  *   DLIST_OP_RECT   x, y, w, h, style
+  *   DLIST_OP_SPRITE x, y, w, h, ink, ((w + 7) / 8) * h bytes, rows MSB first
+  *   DLIST_OP_QR     x, y, scale, n, (n * n + 7) / 8 bytes of modules,
+  *                   row after row without padding, 1 = dark
+  *   DLIST_OP_END
+  * font: bits 0..3 the font ID, bit 7 DLIST_INK_WHITE. Set bits of a
+  * sprite are drawn in its ink, clear bits are left as they are.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stdint.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define DLIST_VERSION       0x01
+#define DLIST_HDR_LEN       2
+
+#define DLIST_WIDTH         200
+#define DLIST_HEIGHT        200
+#define DLIST_LINE_LEN      (DLIST_WIDTH / 8)   /* Bytes per row, 1 = white  */
+
+#define DLIST_OP_END        0x00
+#define DLIST_OP_TEXT       0x01
+#define DLIST_OP_LINE       0x02
+#define DLIST_OP_RECT       0x03
+#define DLIST_OP_SPRITE     0x04
+#define DLIST_OP_QR         0x05
+
+#define DLIST_INK_BLACK     0x00
+#define DLIST_INK_WHITE     0x80
+#define DLIST_RECT_FILL     0x01                /* With an ink bit in style   */
+
+/* Font IDs: the 5x7 ASCII font in flash, scaled 1 to 4 times */
+#define DLIST_FONT_5X7      0                   /* 6x8 cell                   */
+#define DLIST_FONT_10X14    1
+#define DLIST_FONT_15X21    2
+#define DLIST_FONT_20X28    3
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Check a received list before anything is drawn
+  * @retval 1 if every command lies inside len bytes and the list is
+  *         terminated, else 0
+  */
+uint8_t DListCheck(const uint8_t *list, uint32_t len);
+
+/**
+  * @brief  Rasterise row y of a checked list
+  * @param  line DLIST_LINE_LEN bytes, MSB is the leftmost pixel
+  * @retval None
+  */
+void DListRenderLine(const uint8_t *list, uint16_t y, uint8_t *line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISPLAY_LIST_H */
@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file           : eh_power.h
+  * @brief          : Energy budget of a tag powered from the reader's field
+  ******************************************************************************
+  * Without a battery the card lives on the ST25DV energy harvesting output
+  * and its buffer capacitor. Harvesting is switched on as soon as a field is
+  * seen, and VDD, checked against the PVD thresholds, tells how much work
+  * the capacitor can carry: an I2C burst needs less than a panel refresh.
+  * With a battery VDD stays high and nothing is ever held back.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef EH_POWER_H
+#define EH_POWER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l0xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define EH_POWER_LOW        0   /* Below EH_READ_PVD: only wait and charge    */
+#define EH_POWER_READ       1   /* Enough for an I2C burst                    */
+#define EH_POWER_REFRESH    2   /* Enough for a whole panel refresh           */
+
+#define EH_READ_PVD         PWR_PVDLEVEL_1  /* 2.1V */
+#define EH_REFRESH_PVD      PWR_PVDLEVEL_4  /* 2.7V, the panel's charge pump needs margin */
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Route field changes to GPO and take a first reading
+  * @retval None
+  */
+void EhPowerInit(void);
+
+/**
+  * @brief  Enable harvesting when a field is present and measure VDD
+  * @note   Call once per main loop round, before any burst
+  * @retval EH_POWER_* level
+  */
+uint8_t EhPowerProcess(void);
+
+/**
+  * @brief  Level of the last EhPowerProcess()
+  * @retval EH_POWER_* level
+  */
+uint8_t EhPowerLevel(void);
+
+/**
+  * @brief  Field seen by the last EhPowerProcess()
+  * @retval 1 if a reader field is present
+  */
+uint8_t EhPowerField(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EH_POWER_H */
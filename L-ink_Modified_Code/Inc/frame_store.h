@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file           : frame_store.h
+  * @brief          : Keeps the last displayed frame in flash across power loss
+  ******************************************************************************
+  * The card runs from the reader's field and has no RAM to spare for a
+  * whole frame, so the frame shown on the panel is written to the top 5kB
+  * of the flash (the Keil target's IROM1 ends below FRAME_STORE_BASE) while
+  * it is received. It is the base the reader's delta transfers patch.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FRAME_STORE_H
+#define FRAME_STORE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l0xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define FRAME_STORE_BASE    0x0800EC00U   /* Last 5kB of the 64kB flash */
+#define FRAME_STORE_SIZE    0x1400U
+#define FRAME_STORE_LEN     5000U         /* 200x200 1bpp frame         */
+#define FRAME_STORE_DATA    ((const unsigned char *)FRAME_STORE_BASE)
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  CRC-32 (IEEE 802.3, as zlib) of a buffer
+  */
+uint32_t FrameCrc32(const unsigned char *buf, uint32_t len);
+
+/**
+  * @brief  Check the stored frame at FRAME_STORE_DATA
+  * @param  crc its CRC-32 when valid
+  * @retval 1 if the record is complete and matches its CRC, else 0
+  */
+uint8_t FrameStoreValid(uint32_t *crc);
+
+/**
+  * @brief  Erase the store to receive a whole frame with FrameStoreAppend()
+  * @retval HAL status
+  */
+HAL_StatusTypeDef FrameStoreBegin(void);
+
+/**
+  * @brief  Add the next len bytes of the frame
+  * @note   Programmed by half pages, a partial one is kept until
+  *         FrameStoreCommit()
+  * @retval HAL status
+  */
+HAL_StatusTypeDef FrameStoreAppend(const unsigned char *data, uint32_t len);
+
+/**
+  * @brief  Program the half page FrameStoreAppend() has staged
+  * @note   Call before reading the appended frame back from the flash,
+  *         the rest of that half page is programmed to 0
+  * @retval HAL status
+  */
+HAL_StatusTypeDef FrameStoreFlush(void);
+
+/**
+  * @brief  Overwrite len bytes of the stored frame at ofs
+  * @note   Invalidates the record until FrameStoreCommit()
+  * @retval HAL status
+  */
+HAL_StatusTypeDef FrameStorePatch(uint32_t ofs, const unsigned char *data, uint32_t len);
+
+/**
+  * @brief  Mark the stored frame complete, crc is its FrameCrc32()
+  * @note   The header is written last so a power loss while receiving
+  *         leaves no valid record instead of a broken one
+  * @retval HAL status
+  */
+HAL_StatusTypeDef FrameStoreCommit(uint32_t crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_STORE_H */
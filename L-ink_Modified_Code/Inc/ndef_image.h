@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file           : ndef_image.h
+  * @brief          : Finds an image record in the ST25DV's NDEF area
+  ******************************************************************************
+  * Besides the reader's private 0xAA/0xAB/0xAC transfers, any NFC Forum
+  * writer (a phone, the reader's NDEF path) can update the card with a
+  * standard Type 5 tag message. Its first record is a MIME media record:
+  *   NDEF_IMAGE_TYPE_RAW       the 5000 byte frame, same layout as the slots
+  *   NDEF_IMAGE_TYPE_PACKBITS  the frame PackBits compressed: a header n of
+  *                             0..127 is followed by n + 1 literal bytes,
+  *                             -1..-127 by one byte repeated 1 - n times,
+  *                             -128 is skipped
+  * The ST25DV04K only holds a compressed frame.
+  *
+  * The EEPROM is addressed as the RF side sees it: the capability container
+  * at 0, then the TLVs. Only the first NDEF_IMAGE_HEAD_LEN bytes are parsed
+  * to locate the payload, which is then read and unpacked piece by piece.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NDEF_IMAGE_H
+#define NDEF_IMAGE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stdint.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define NDEF_IMAGE_TYPE_RAW         "image/x-epd-1bpp"
+#define NDEF_IMAGE_TYPE_PACKBITS    "image/x-epd-1bpp-packbits"
+
+#define NDEF_IMAGE_NONE     0
+#define NDEF_IMAGE_RAW      1
+#define NDEF_IMAGE_PACKBITS 2
+
+#define NDEF_IMAGE_HEAD_LEN 64   /* CC, TLVs and record header must fit */
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint8_t  Format;       /* NDEF_IMAGE_* */
+  uint16_t PayloadAddr;  /* EEPROM address of the payload */
+  uint16_t PayloadLen;
+  uint16_t MessageEnd;   /* EEPROM address after the message, 0 if none */
+} NdefImageInfo;
+
+typedef struct
+{
+  uint8_t Format;        /* NDEF_IMAGE_RAW or NDEF_IMAGE_PACKBITS */
+  uint8_t State;         /* Header, literal, run value or run */
+  uint8_t Count;         /* Bytes left in the current packet  */
+  uint8_t Value;         /* Byte repeated by a run            */
+} NdefImageUnpacker;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Locate an image record
+  * @param  head the first len bytes of the EEPROM
+  * @param  memSize EEPROM size in bytes
+  * @note   MessageEnd is also set for messages that are no image
+  * @retval 1 if the first record of a complete message is an image, else 0
+  *         (no CC, empty or half written message, other record types)
+  */
+uint8_t NdefImageFind(const uint8_t *head, uint16_t len, uint32_t memSize, NdefImageInfo *info);
+
+/**
+  * @brief  Start unpacking a payload of the given format
+  * @retval None
+  */
+void NdefImageUnpackInit(NdefImageUnpacker *u, uint8_t format);
+
+/**
+  * @brief  Unpack the next payload bytes
+  * @param  out outLen bytes, NULL to only count the output
+  * @param  used bytes of in that were consumed
+  * @note   Stops when in is consumed or out is full
+  * @retval Bytes written to out
+  */
+uint16_t NdefImageUnpack(NdefImageUnpacker *u, const uint8_t *in, uint16_t inLen,
+                         uint8_t *out, uint16_t outLen, uint16_t *used);
+
+/**
+  * @brief  Check that the payload did not end inside a packet
+  * @retval 1 if complete, else 0
+  */
+uint8_t NdefImageUnpackDone(const NdefImageUnpacker *u);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NDEF_IMAGE_H */
@@ -56,6 +56,10 @@ extern "C" {
 #define NFC04A1_I2C_WriteReg16   BSP_I2C1_WriteReg16
 #define NFC04A1_I2C_Recv         BSP_I2C1_Recv
 #define NFC04A1_I2C_IsReady      BSP_I2C1_IsReady
+#define NFC04A1_I2C_Submit       BSP_I2C1_Submit
+#define NFC04A1_I2C_Xfer_t       BSP_I2C_Xfer_t
+#define NFC04A1_I2C_XFER_READ        BUS_I2C_XFER_READ
+#define NFC04A1_I2C_XFER_WRITE_WAIT  BUS_I2C_XFER_WRITE_WAIT
 
 #define NFC04A1_GetTick          HAL_GetTick
 
@@ -54,6 +54,9 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void EXTI2_3_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void EXTI4_15_IRQHandler(void);
+void DMA1_Channel2_3_IRQHandler(void);
+void I2C1_IRQHandler(void);
 
 /* USER CODE END EFP */
 
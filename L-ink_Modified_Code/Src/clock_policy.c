@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file           : clock_policy.c
+  * @brief          : System clock by activity: fast bursts, slow polling, STOP
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "clock_policy.h"
+#include "custom_bus.h"
+#include "usart.h"
+#include "stdio.h"
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t clockMode = CLOCK_RUN;   /* SystemClock_Config() leaves HSI 16 MHz */
+static uint32_t clockSince;             /* HAL tick of the last switch            */
+static uint32_t clockMs[2];             /* Time in CLOCK_RUN and CLOCK_IDLE       */
+static uint32_t clockSwitches;
+
+/* Private function prototypes -----------------------------------------------*/
+static void ClockPolicyRun(void);
+static void ClockPolicyIdle(void);
+static void ClockPolicyAccount(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  HSI 16 MHz x4 / 2 = 32 MHz, the regulator goes up first
+  */
+static void ClockPolicyRun(void)
+{
+  RCC_OscInitTypeDef osc = {0};
+  RCC_ClkInitTypeDef clk = {0};
+
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+  while (__HAL_PWR_GET_FLAG(PWR_FLAG_VOS) != RESET)
+  {
+  }
+
+  osc.OscillatorType      = RCC_OSCILLATORTYPE_HSI;
+  osc.HSIState            = RCC_HSI_ON;
+  osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  osc.PLL.PLLState        = RCC_PLL_ON;
+  osc.PLL.PLLSource       = RCC_PLLSOURCE_HSI;
+  osc.PLL.PLLMUL          = RCC_PLLMUL_4;
+  osc.PLL.PLLDIV          = RCC_PLLDIV_2;
+  if (HAL_RCC_OscConfig(&osc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  clk.ClockType      = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+  clk.SYSCLKSource   = RCC_SYSCLKSOURCE_PLLCLK;
+  clk.AHBCLKDivider  = RCC_SYSCLK_DIV1;
+  clk.APB1CLKDivider = RCC_HCLK_DIV1;
+  clk.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+  * @brief  MSI 2.1 MHz, PLL and HSI off, then the regulator goes down
+  */
+static void ClockPolicyIdle(void)
+{
+  RCC_OscInitTypeDef osc = {0};
+  RCC_ClkInitTypeDef clk = {0};
+
+  osc.OscillatorType      = RCC_OSCILLATORTYPE_MSI;
+  osc.MSIState            = RCC_MSI_ON;
+  osc.MSICalibrationValue = RCC_MSICALIBRATION_DEFAULT;
+  osc.MSIClockRange       = RCC_MSIRANGE_5;
+  osc.PLL.PLLState        = RCC_PLL_NONE;
+  if (HAL_RCC_OscConfig(&osc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  clk.ClockType      = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+  clk.SYSCLKSource   = RCC_SYSCLKSOURCE_MSI;
+  clk.AHBCLKDivider  = RCC_SYSCLK_DIV1;
+  clk.APB1CLKDivider = RCC_HCLK_DIV1;
+  clk.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_0) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* PLL before its HSI input */
+  osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+  osc.PLL.PLLState   = RCC_PLL_OFF;
+  HAL_RCC_OscConfig(&osc);
+  osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  osc.HSIState       = RCC_HSI_OFF;
+  osc.PLL.PLLState   = RCC_PLL_NONE;
+  HAL_RCC_OscConfig(&osc);
+
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
+  while (__HAL_PWR_GET_FLAG(PWR_FLAG_VOS) != RESET)
+  {
+  }
+}
+
+/**
+  * @brief  Add the time since the last switch to the current mode
+  */
+static void ClockPolicyAccount(void)
+{
+  uint32_t now = HAL_GetTick();
+
+  clockMs[clockMode] += now - clockSince;
+  clockSince = now;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void ClockPolicyInit(void)
+{
+  __HAL_RCC_PWR_CLK_ENABLE();
+  /* VREFINT off in STOP, the wake-up does not wait for it */
+  HAL_PWREx_EnableUltraLowPower();
+  HAL_PWREx_EnableFastWakeUp();
+  __HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_MSI);
+
+  clockSince = HAL_GetTick();
+  ClockPolicySet(CLOCK_IDLE);
+}
+
+void ClockPolicySet(uint8_t Mode)
+{
+  if (Mode == clockMode)
+  {
+    return;
+  }
+
+  while (!BSP_I2C1_IsIdle())
+  {
+    __WFI();
+  }
+  while (__HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) == RESET)
+  {
+  }
+
+  ClockPolicyAccount();
+  if (Mode == CLOCK_RUN)
+  {
+    ClockPolicyRun();
+  }
+  else
+  {
+    ClockPolicyIdle();
+  }
+  clockMode = Mode;
+  clockSwitches++;
+
+  BSP_I2C1_ClockUpdate();
+  __HAL_UART_DISABLE(&huart1);
+  huart1.Instance->BRR = UART_DIV_SAMPLING16(HAL_RCC_GetPCLK2Freq(), huart1.Init.BaudRate);
+  __HAL_UART_ENABLE(&huart1);
+}
+
+uint8_t ClockPolicyGet(void)
+{
+  return clockMode;
+}
+
+void ClockPolicyStop(void)
+{
+  ClockPolicySet(CLOCK_IDLE);
+  ClockPolicyAccount();
+  printf("clk: run %lu ms, idle %lu ms, %lu switches\r\n",
+         (unsigned long)clockMs[CLOCK_RUN], (unsigned long)clockMs[CLOCK_IDLE], (unsigned long)clockSwitches);
+  while (__HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) == RESET)
+  {
+  }
+  clockMs[CLOCK_RUN] = 0;
+  clockMs[CLOCK_IDLE] = 0;
+  clockSwitches = 0;
+
+  /* SysTick would wake the core every ms */
+  HAL_SuspendTick();
+  HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+  HAL_ResumeTick();
+
+  /* Back on MSI with the range and regulator of CLOCK_IDLE, the tick did not
+     run while stopped */
+  clockSince = HAL_GetTick();
+}
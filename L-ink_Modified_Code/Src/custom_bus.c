@@ -38,6 +38,31 @@ __weak HAL_StatusTypeDef MX_I2C1_Init(I2C_HandleTypeDef *hi2c);
   */
 
 I2C_HandleTypeDef hi2c1;
+DMA_HandleTypeDef hdma_i2c1_rx;
+DMA_HandleTypeDef hdma_i2c1_tx;
+/**
+  * @}
+  */
+
+/** @defgroup CUSTOM_BUS_Private_Constants BUS Private Constants
+  * @{
+  */
+
+/* Transfer queue phases */
+#define I2C1_PHASE_IDLE       0U    /* Nothing queued                              */
+#define I2C1_PHASE_XFER       1U    /* Head transfer running on the bus            */
+#define I2C1_PHASE_WAIT       2U    /* Write done, next ready poll is scheduled    */
+#define I2C1_PHASE_PROBE      3U    /* Ready poll (address only) running           */
+
+/* Speed profile selected at init */
+#if (BUS_I2C1_FREQUENCY >= 1000000U)
+#define I2C1_SPEED_DEFAULT    BUS_I2C1_SPEED_1M
+#elif (BUS_I2C1_FREQUENCY >= 400000U)
+#define I2C1_SPEED_DEFAULT    BUS_I2C1_SPEED_400K
+#else
+#define I2C1_SPEED_DEFAULT    BUS_I2C1_SPEED_100K
+#endif
+
 /**
   * @}
   */
@@ -51,6 +76,36 @@ static uint32_t IsI2C1MspCbValid = 0;
 #endif /* USE_HAL_I2C_REGISTER_CALLBACKS */
 static uint32_t I2C1InitCounter = 0;
 
+static BSP_I2C_Xfer_t *I2C1Head = NULL;
+static BSP_I2C_Xfer_t *I2C1Tail = NULL;
+static volatile uint8_t I2C1Phase = I2C1_PHASE_IDLE;
+static volatile uint32_t I2C1PollTick;
+static uint32_t I2C1WriteTick;
+static uint8_t I2C1ProbeDummy;
+
+/* I2C bus limits per speed profile: min tLOW, min tHIGH, min tSU;DAT,
+   max tr, max tf in ns, the SCL frequency aimed at and the lowest kernel
+   clock the peripheral supports the mode with (reference manual) */
+static const struct
+{
+  uint16_t Low;
+  uint16_t High;
+  uint16_t SuDat;
+  uint16_t Rise;
+  uint16_t Fall;
+  uint32_t Scl;
+  uint32_t MinClock;
+} I2C1Spec[] =
+{
+  {4700U, 4000U, 250U, 1000U, 300U, 100000U, 2000000U},
+  {1300U,  600U, 100U,  300U, 300U, 400000U, 9000000U},
+  { 500U,  260U,  50U,  120U, 120U, 1000000U, 19000000U}
+};
+static uint32_t I2C1Speed = I2C1_SPEED_DEFAULT;     /* Profile selected          */
+static uint32_t I2C1SpeedUsed = I2C1_SPEED_DEFAULT; /* Profile the clock allows  */
+static uint8_t I2C1ErrorCount;
+static volatile uint8_t I2C1DownshiftPending;
+
 /**
   * @}
   */
@@ -61,6 +116,15 @@ static uint32_t I2C1InitCounter = 0;
 
 static void I2C1_MspInit(I2C_HandleTypeDef *hI2c);
 static void I2C1_MspDeInit(I2C_HandleTypeDef *hI2c);
+static int32_t I2C1_StartNext(void);
+static void I2C1_Complete(int32_t Status);
+static void I2C1_WaitIdle(void);
+static void I2C1_ApplySpeed(uint32_t Speed);
+static uint32_t I2C1_Ticks(uint32_t Ns, uint32_t Khz);
+static uint32_t I2C1_Fit(uint32_t ClockHz, uint32_t Speed);
+static uint32_t I2C1_Timing(uint32_t ClockHz, uint32_t Speed);
+static void I2C1_Track(int32_t Status);
+static void I2C1_Downshift(void);
 #if (USE_CUBEMX_BSP_V2 == 1)
 static uint32_t I2C_GetTiming(uint32_t clock_src_hz, uint32_t i2cfreq_hz);
 static void Compute_PRESC_SCLDEL_SDADEL(uint32_t clock_src_freq, uint32_t I2C_Speed);
@@ -123,6 +187,8 @@ int32_t BSP_I2C1_Init(void)
         }
         else
         {
+          /* Pin drive for the selected speed profile */
+          I2C1_ApplySpeed(I2C1Speed);
           ret = BSP_ERROR_NONE;
         }
       }
@@ -167,6 +233,8 @@ int32_t BSP_I2C1_IsReady(uint16_t DevAddr, uint32_t Trials)
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_IsDeviceReady(&hi2c1, DevAddr, Trials, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     ret = BSP_ERROR_BUSY;
@@ -188,6 +256,8 @@ int32_t BSP_I2C1_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Mem_Write(&hi2c1, DevAddr, Reg, I2C_MEMADD_SIZE_8BIT, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) == HAL_I2C_ERROR_AF)
@@ -199,6 +269,7 @@ int32_t BSP_I2C1_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
   }
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -214,6 +285,8 @@ int32_t BSP_I2C1_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Mem_Read(&hi2c1, DevAddr, Reg, I2C_MEMADD_SIZE_8BIT, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) == HAL_I2C_ERROR_AF)
@@ -225,6 +298,7 @@ int32_t BSP_I2C1_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
   }
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -242,6 +316,8 @@ int32_t BSP_I2C1_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Mem_Write(&hi2c1, DevAddr, Reg, I2C_MEMADD_SIZE_16BIT, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) == HAL_I2C_ERROR_AF)
@@ -253,6 +329,7 @@ int32_t BSP_I2C1_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
   }
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -267,6 +344,8 @@ int32_t BSP_I2C1_ReadReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint1
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Mem_Read(&hi2c1, DevAddr, Reg, I2C_MEMADD_SIZE_16BIT, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) != HAL_I2C_ERROR_AF)
@@ -278,6 +357,7 @@ int32_t BSP_I2C1_ReadReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint1
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
   }
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -292,6 +372,8 @@ int32_t BSP_I2C1_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Master_Transmit(&hi2c1, DevAddr, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) != HAL_I2C_ERROR_AF)
@@ -304,6 +386,7 @@ int32_t BSP_I2C1_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
     }
   }
 
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -318,6 +401,8 @@ int32_t BSP_I2C1_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 {
   int32_t ret = BSP_ERROR_NONE;
 
+  I2C1_WaitIdle();
+
   if (HAL_I2C_Master_Receive(&hi2c1, DevAddr, pData, Length, BUS_I2C1_POLL_TIMEOUT) != HAL_OK)
   {
     if (HAL_I2C_GetError(&hi2c1) != HAL_I2C_ERROR_AF)
@@ -329,6 +414,7 @@ int32_t BSP_I2C1_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
   }
+  I2C1_Track(ret);
   return ret;
 }
 
@@ -386,6 +472,446 @@ int32_t BSP_I2C1_RegisterMspCallbacks(BSP_I2C_Cb_t *Callbacks)
 }
 #endif /* USE_HAL_I2C_REGISTER_CALLBACKS */
 
+/**
+  * @brief  Queue a transfer, it runs on DMA / interrupts in the background
+  * @note   BUS_I2C_XFER_WRITE_WAIT transfers complete only once the device
+  *         acknowledges its address again. The ready polls are scheduled
+  *         every BUS_I2C1_WRITE_POLL ms from BSP_I2C1_Tick() instead of
+  *         keeping the bus busy. Blocking BSP_I2C1_xxx calls wait until the
+  *         queue is empty, so they must not be used from a Callback.
+  * @param  pXfer Transfer, owned by the bus until its Status is no longer
+  *         BUS_I2C_XFER_PENDING
+  * @retval BSP status
+  */
+int32_t BSP_I2C1_Submit(BSP_I2C_Xfer_t *pXfer)
+{
+  uint32_t primask;
+  int32_t status;
+  uint8_t start;
+
+  if ((pXfer == NULL) || (pXfer->pData == NULL) || (pXfer->Length == 0U) || (pXfer->Mode > BUS_I2C_XFER_WRITE_WAIT))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+
+  /* From thread context with nothing queued, the peripheral may be reset */
+  if ((I2C1Phase == I2C1_PHASE_IDLE) && (__get_IPSR() == 0U))
+  {
+    I2C1_Downshift();
+  }
+
+  pXfer->Status = BUS_I2C_XFER_PENDING;
+  pXfer->Next = NULL;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (I2C1Head == NULL)
+  {
+    I2C1Head = pXfer;
+  }
+  else
+  {
+    I2C1Tail->Next = pXfer;
+  }
+  I2C1Tail = pXfer;
+  start = (I2C1Phase == I2C1_PHASE_IDLE) ? 1U : 0U;
+  if (start != 0U)
+  {
+    I2C1Phase = I2C1_PHASE_XFER;
+  }
+  __set_PRIMASK(primask);
+
+  if (start != 0U)
+  {
+    status = I2C1_StartNext();
+    if (status != BSP_ERROR_NONE)
+    {
+      I2C1_Complete(status);
+    }
+  }
+  return BSP_ERROR_NONE;
+}
+
+/**
+  * @brief  Check whether all queued transfers have completed
+  * @retval 1 if idle
+  */
+uint8_t BSP_I2C1_IsIdle(void)
+{
+  return (I2C1Head == NULL) ? 1U : 0U;
+}
+
+/**
+  * @brief  Select the bus speed profile
+  * @param  Speed BUS_I2C1_SPEED_100K, BUS_I2C1_SPEED_400K or BUS_I2C1_SPEED_1M
+  * @note   Waits for queued transfers first. The bus also steps down by
+  *         itself after BUS_I2C1_DOWNSHIFT_ERRORS failed transfers in a row.
+  * @retval BSP status
+  */
+int32_t BSP_I2C1_SetSpeed(uint32_t Speed)
+{
+  if (Speed > BUS_I2C1_SPEED_1M)
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+
+  I2C1_WaitIdle();
+  I2C1_ApplySpeed(Speed);
+  I2C1ErrorCount = 0;
+  I2C1DownshiftPending = 0U;
+  return BSP_ERROR_NONE;
+}
+
+/**
+  * @brief  Recompute the timing after a change of the I2C kernel clock (PCLK1)
+  * @note   Waits for queued transfers first. Below the kernel clock a
+  *         profile needs the bus runs the fastest one that clock allows,
+  *         Standard mode on the 2.1 MHz MSI of CLOCK_IDLE, and goes back
+  *         to the selected one once the clock is raised again.
+  * @retval None
+  */
+void BSP_I2C1_ClockUpdate(void)
+{
+  I2C1_WaitIdle();
+  I2C1_ApplySpeed(I2C1Speed);
+}
+
+/**
+  * @brief  Get the bus speed profile in use
+  * @retval BUS_I2C1_SPEED_xxx
+  */
+uint32_t BSP_I2C1_GetSpeed(void)
+{
+  return I2C1SpeedUsed;
+}
+
+/**
+  * @brief  Start a scheduled ready poll, called from the SysTick interrupt
+  * @retval None
+  */
+void BSP_I2C1_Tick(void)
+{
+  if ((I2C1Phase != I2C1_PHASE_WAIT) || ((int32_t)(HAL_GetTick() - I2C1PollTick) < 0))
+  {
+    return;
+  }
+
+  /* Address only write: ACK means the write cycle is over */
+  I2C1Phase = I2C1_PHASE_PROBE;
+  if (HAL_I2C_Master_Transmit_IT(&hi2c1, I2C1Head->DevAddr, &I2C1ProbeDummy, 0U) != HAL_OK)
+  {
+    I2C1PollTick = HAL_GetTick() + BUS_I2C1_WRITE_POLL;
+    I2C1Phase = I2C1_PHASE_WAIT;
+  }
+}
+
+/**
+  * @brief  Memory read completed
+  * @retval None
+  */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if ((hi2c->Instance == I2C1) && (I2C1Phase == I2C1_PHASE_XFER))
+  {
+    I2C1_Complete(BSP_ERROR_NONE);
+  }
+}
+
+/**
+  * @brief  Memory write sent, schedule the ready poll if the device needs one
+  * @retval None
+  */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if ((hi2c->Instance != I2C1) || (I2C1Phase != I2C1_PHASE_XFER))
+  {
+    return;
+  }
+
+  if (I2C1Head->Mode == BUS_I2C_XFER_WRITE_WAIT)
+  {
+    I2C1WriteTick = HAL_GetTick();
+    I2C1PollTick = I2C1WriteTick + BUS_I2C1_WRITE_POLL;
+    I2C1Phase = I2C1_PHASE_WAIT;
+  }
+  else
+  {
+    I2C1_Complete(BSP_ERROR_NONE);
+  }
+}
+
+/**
+  * @brief  Ready poll acknowledged
+  * @retval None
+  */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if ((hi2c->Instance == I2C1) && (I2C1Phase == I2C1_PHASE_PROBE))
+  {
+    I2C1_Complete(BSP_ERROR_NONE);
+  }
+}
+
+/**
+  * @brief  Transfer or ready poll failed
+  * @retval None
+  */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c->Instance != I2C1)
+  {
+    return;
+  }
+
+  if (I2C1Phase == I2C1_PHASE_PROBE)
+  {
+    /* NACK: still writing, poll again later */
+    if ((uint32_t)(HAL_GetTick() - I2C1WriteTick) < BUS_I2C1_WRITE_TIMEOUT)
+    {
+      I2C1PollTick = HAL_GetTick() + BUS_I2C1_WRITE_POLL;
+      I2C1Phase = I2C1_PHASE_WAIT;
+    }
+    else
+    {
+      I2C1_Complete(BSP_ERROR_BUSY);
+    }
+  }
+  else if (I2C1Phase == I2C1_PHASE_XFER)
+  {
+    I2C1_Complete((HAL_I2C_GetError(hi2c) == HAL_I2C_ERROR_AF) ? BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE : BSP_ERROR_PERIPH_FAILURE);
+  }
+}
+
+/**
+  * @brief  Start the transfer at the head of the queue
+  * @note   The HAL sends the memory address by polling, a NACK there
+  *         (device busy with RF) is returned right away
+  * @retval BSP status
+  */
+static int32_t I2C1_StartNext(void)
+{
+  BSP_I2C_Xfer_t *x = I2C1Head;
+  HAL_StatusTypeDef status;
+
+  if (x->Mode == BUS_I2C_XFER_READ)
+  {
+    if (x->Length >= BUS_I2C1_DMA_THRESHOLD)
+    {
+      status = HAL_I2C_Mem_Read_DMA(&hi2c1, x->DevAddr, x->Reg, I2C_MEMADD_SIZE_16BIT, x->pData, x->Length);
+    }
+    else
+    {
+      status = HAL_I2C_Mem_Read_IT(&hi2c1, x->DevAddr, x->Reg, I2C_MEMADD_SIZE_16BIT, x->pData, x->Length);
+    }
+  }
+  else
+  {
+    if (x->Length >= BUS_I2C1_DMA_THRESHOLD)
+    {
+      status = HAL_I2C_Mem_Write_DMA(&hi2c1, x->DevAddr, x->Reg, I2C_MEMADD_SIZE_16BIT, x->pData, x->Length);
+    }
+    else
+    {
+      status = HAL_I2C_Mem_Write_IT(&hi2c1, x->DevAddr, x->Reg, I2C_MEMADD_SIZE_16BIT, x->pData, x->Length);
+    }
+  }
+
+  if (status == HAL_OK)
+  {
+    return BSP_ERROR_NONE;
+  }
+  return (HAL_I2C_GetError(&hi2c1) == HAL_I2C_ERROR_AF) ? BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE : BSP_ERROR_PERIPH_FAILURE;
+}
+
+/**
+  * @brief  Retire the head transfer and start the next one
+  * @param  Status Result of the head transfer
+  * @retval None
+  */
+static void I2C1_Complete(int32_t Status)
+{
+  BSP_I2C_Xfer_t *x;
+
+  do
+  {
+    x = I2C1Head;
+    I2C1Head = x->Next;
+    if (I2C1Head == NULL)
+    {
+      I2C1Tail = NULL;
+    }
+    x->Status = Status;
+    I2C1_Track(Status);
+    if (x->Callback != NULL)
+    {
+      x->Callback(x);
+    }
+
+    if (I2C1Head == NULL)
+    {
+      I2C1Phase = I2C1_PHASE_IDLE;
+      return;
+    }
+
+    /* Transfers that can't be started are retired right away */
+    I2C1Phase = I2C1_PHASE_XFER;
+    Status = I2C1_StartNext();
+  } while (Status != BSP_ERROR_NONE);
+}
+
+/**
+  * @brief  Wait until queued transfers are done, before a blocking access
+  * @retval None
+  */
+static void I2C1_WaitIdle(void)
+{
+  while (I2C1Head != NULL)
+  {
+    __WFI();    /* SysTick wakes up at least every ms */
+  }
+  I2C1_Downshift();
+}
+
+/**
+  * @brief  Load the timing of a speed profile, the bus must be idle
+  * @param  Speed BUS_I2C1_SPEED_xxx
+  * @retval None
+  */
+static void I2C1_ApplySpeed(uint32_t Speed)
+{
+  I2C1Speed = Speed;
+  I2C1SpeedUsed = I2C1_Fit(HAL_RCC_GetPCLK1Freq(), Speed);
+
+  /* FM+ drive on the pins only where the timing needs it */
+  if (I2C1SpeedUsed == BUS_I2C1_SPEED_1M)
+  {
+    HAL_I2CEx_EnableFastModePlus(I2C_FASTMODEPLUS_PB6 | I2C_FASTMODEPLUS_PB7);
+  }
+  else
+  {
+    HAL_I2CEx_DisableFastModePlus(I2C_FASTMODEPLUS_PB6 | I2C_FASTMODEPLUS_PB7);
+  }
+
+  if (hi2c1.State != HAL_I2C_STATE_RESET)
+  {
+    /* TIMINGR can only be written with PE cleared */
+    __HAL_I2C_DISABLE(&hi2c1);
+    hi2c1.Init.Timing = I2C1_Timing(HAL_RCC_GetPCLK1Freq(), I2C1SpeedUsed);
+    hi2c1.Instance->TIMINGR = hi2c1.Init.Timing;
+    __HAL_I2C_ENABLE(&hi2c1);
+  }
+}
+
+/**
+  * @brief  Round a time up to kernel clock ticks
+  * @param  Ns time in ns
+  * @param  Khz prescaled kernel clock in kHz
+  * @retval Ticks
+  */
+static uint32_t I2C1_Ticks(uint32_t Ns, uint32_t Khz)
+{
+  return ((Ns * Khz) + 999999U) / 1000000U;
+}
+
+/**
+  * @brief  Fastest profile up to Speed that the kernel clock supports
+  * @param  ClockHz I2C kernel clock
+  * @param  Speed BUS_I2C1_SPEED_xxx
+  * @retval BUS_I2C1_SPEED_xxx, BUS_I2C1_SPEED_100K at the lowest
+  */
+static uint32_t I2C1_Fit(uint32_t ClockHz, uint32_t Speed)
+{
+  while ((Speed > BUS_I2C1_SPEED_100K) && (ClockHz < I2C1Spec[Speed].MinClock))
+  {
+    Speed--;
+  }
+  return Speed;
+}
+
+/**
+  * @brief  TIMINGR for a speed profile, analog filter on
+  * @param  ClockHz I2C kernel clock
+  * @param  Speed BUS_I2C1_SPEED_xxx
+  * @retval TIMINGR value, 0 if no prescaler fits
+  */
+static uint32_t I2C1_Timing(uint32_t ClockHz, uint32_t Speed)
+{
+  uint32_t khz = ClockHz / 1000U;
+  uint32_t presc, f, period, sync, low, high, extra, scldel, sdadel, hold;
+
+  for (presc = 0; presc < 16U; presc++)
+  {
+    f = khz / (presc + 1U);
+
+    /* SCL period = (SCLL + 1 + SCLH + 1) * tPRESC + tr + tf + about 4 kernel
+       clocks of synchronisation; the spare time goes to both phases */
+    period = (f * 1000U) / I2C1Spec[Speed].Scl;
+    sync = I2C1_Ticks(I2C1Spec[Speed].Rise + I2C1Spec[Speed].Fall, f) + ((4U + presc) / (presc + 1U));
+    low = I2C1_Ticks(I2C1Spec[Speed].Low, f);
+    high = I2C1_Ticks(I2C1Spec[Speed].High, f);
+    if (period > low + high + sync)
+    {
+      extra = period - low - high - sync;
+      low += extra - (extra / 2U);
+      high += extra / 2U;
+    }
+
+    /* Data setup before SCL rises, data hold past tf less the analog filter
+       (50ns) and 3 kernel clocks */
+    scldel = I2C1_Ticks(I2C1Spec[Speed].SuDat, f);
+    hold = 50U + (3000000U / khz);
+    sdadel = (I2C1Spec[Speed].Fall > hold) ? I2C1_Ticks(I2C1Spec[Speed].Fall - hold, f) : 0U;
+
+    if ((low <= 256U) && (high <= 256U) && (scldel <= 16U) && (sdadel <= 15U))
+    {
+      return (presc << 28) | (((scldel > 0U) ? (scldel - 1U) : 0U) << 20) | (sdadel << 16) |
+             ((high - 1U) << 8) | (low - 1U);
+    }
+  }
+  return 0U;
+}
+
+/**
+  * @brief  Count failed transfers, a step down one speed profile is due
+  *         when BUS_I2C1_DOWNSHIFT_ERRORS of them come in a row
+  * @note   Runs from the completion interrupts too: the step itself is left
+  *         to I2C1_Downshift() in thread context
+  * @param  Status BSP status of the finished transfer
+  * @retval None
+  */
+static void I2C1_Track(int32_t Status)
+{
+  if ((Status != BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE) && (Status != BSP_ERROR_PERIPH_FAILURE))
+  {
+    I2C1ErrorCount = 0;
+    return;
+  }
+
+  if (++I2C1ErrorCount >= BUS_I2C1_DOWNSHIFT_ERRORS)
+  {
+    I2C1ErrorCount = 0;
+    I2C1DownshiftPending = 1U;
+  }
+}
+
+/**
+  * @brief  Take a step down flagged by I2C1_Track(), the bus must be idle
+  * @retval None
+  */
+static void I2C1_Downshift(void)
+{
+  if (I2C1DownshiftPending == 0U)
+  {
+    return;
+  }
+
+  I2C1DownshiftPending = 0U;
+  if (I2C1SpeedUsed > BUS_I2C1_SPEED_100K)
+  {
+    I2C1_ApplySpeed(I2C1SpeedUsed - 1U);
+  }
+}
+
 /**
   * @brief  Return system tick in ms
   * @retval Current HAL time base time stamp
@@ -401,7 +927,7 @@ __weak HAL_StatusTypeDef MX_I2C1_Init(I2C_HandleTypeDef *hi2c)
 {
   HAL_StatusTypeDef ret = HAL_OK;
   hi2c->Instance = I2C1;
-  hi2c->Init.Timing = 0x0010061A;
+  hi2c->Init.Timing = I2C1_Timing(HAL_RCC_GetPCLK1Freq(), I2C1_Fit(HAL_RCC_GetPCLK1Freq(), I2C1Speed));
   hi2c->Init.OwnAddress1 = 0;
   hi2c->Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
   hi2c->Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
@@ -450,6 +976,43 @@ static void I2C1_MspInit(I2C_HandleTypeDef *i2cHandle)
   __HAL_RCC_I2C1_CLK_ENABLE();
   /* USER CODE BEGIN I2C1_MspInit 1 */
 
+  /* I2C1 DMA Init: RX on channel 3, TX on channel 2 */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  hdma_i2c1_rx.Instance = DMA1_Channel3;
+  hdma_i2c1_rx.Init.Request = DMA_REQUEST_6;
+  hdma_i2c1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  hdma_i2c1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_i2c1_rx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_i2c1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_i2c1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_i2c1_rx.Init.Mode = DMA_NORMAL;
+  hdma_i2c1_rx.Init.Priority = DMA_PRIORITY_LOW;
+  if (HAL_DMA_Init(&hdma_i2c1_rx) == HAL_OK)
+  {
+    __HAL_LINKDMA(i2cHandle, hdmarx, hdma_i2c1_rx);
+  }
+
+  hdma_i2c1_tx.Instance = DMA1_Channel2;
+  hdma_i2c1_tx.Init.Request = DMA_REQUEST_6;
+  hdma_i2c1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma_i2c1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_i2c1_tx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_i2c1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_i2c1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_i2c1_tx.Init.Mode = DMA_NORMAL;
+  hdma_i2c1_tx.Init.Priority = DMA_PRIORITY_LOW;
+  if (HAL_DMA_Init(&hdma_i2c1_tx) == HAL_OK)
+  {
+    __HAL_LINKDMA(i2cHandle, hdmatx, hdma_i2c1_tx);
+  }
+
+  /* Same priority as SysTick, so BSP_I2C1_Tick() never preempts the callbacks */
+  HAL_NVIC_SetPriority(DMA1_Channel2_3_IRQn, TICK_INT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+  HAL_NVIC_SetPriority(I2C1_IRQn, TICK_INT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(I2C1_IRQn);
+
   /* USER CODE END I2C1_MspInit 1 */
 }
 
@@ -468,6 +1031,10 @@ static void I2C1_MspDeInit(I2C_HandleTypeDef *i2cHandle)
   HAL_GPIO_DeInit(GPIOB, GPIO_PIN_6 | GPIO_PIN_7);
 
   /* USER CODE BEGIN I2C1_MspDeInit 1 */
+  HAL_DMA_DeInit(i2cHandle->hdmarx);
+  HAL_DMA_DeInit(i2cHandle->hdmatx);
+  HAL_NVIC_DisableIRQ(I2C1_IRQn);
+  HAL_NVIC_DisableIRQ(DMA1_Channel2_3_IRQn);
 
   /* USER CODE END I2C1_MspDeInit 1 */
 }
@@ -0,0 +1,348 @@
+/**
+  ******************************************************************************
+  * @file           : display_list.c
+  * @brief          : Renders a compact list of drawing commands to the panel
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "display_list.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+#define DLIST_FONT_FIRST    0x20
+#define DLIST_FONT_LAST     0x7e
+#define DLIST_FONT_W        5
+#define DLIST_FONT_H        7
+#define DLIST_FONT_CELL_W   6
+#define DLIST_FONT_MAX      DLIST_FONT_20X28
+
+/* Private variables ---------------------------------------------------------*/
+/* 5x7 ASCII 0x20..0x7e, one byte per column, bit 0 is the top row */
+static const uint8_t font5x7[DLIST_FONT_LAST - DLIST_FONT_FIRST + 1][DLIST_FONT_W] =
+{
+  {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5f, 0x00, 0x00}, /*   ! */
+  {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7f, 0x14, 0x7f, 0x14}, /* " # */
+  {0x24, 0x2a, 0x7f, 0x2a, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, /* $ % */
+  {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, /* & ' */
+  {0x00, 0x1c, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1c, 0x00}, /* ( ) */
+  {0x08, 0x2a, 0x1c, 0x2a, 0x08}, {0x08, 0x08, 0x3e, 0x08, 0x08}, /* * + */
+  {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, /* , - */
+  {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02}, /* . / */
+  {0x3e, 0x51, 0x49, 0x45, 0x3e}, {0x00, 0x42, 0x7f, 0x40, 0x00}, /* 0 1 */
+  {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4b, 0x31}, /* 2 3 */
+  {0x18, 0x14, 0x12, 0x7f, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, /* 4 5 */
+  {0x3c, 0x4a, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03}, /* 6 7 */
+  {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1e}, /* 8 9 */
+  {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00}, /* : ; */
+  {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14}, /* < = */
+  {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, /* > ? */
+  {0x32, 0x49, 0x79, 0x41, 0x3e}, {0x7e, 0x11, 0x11, 0x11, 0x7e}, /* @ A */
+  {0x7f, 0x49, 0x49, 0x49, 0x36}, {0x3e, 0x41, 0x41, 0x41, 0x22}, /* B C */
+  {0x7f, 0x41, 0x41, 0x22, 0x1c}, {0x7f, 0x49, 0x49, 0x49, 0x41}, /* D E */
+  {0x7f, 0x09, 0x09, 0x01, 0x01}, {0x3e, 0x41, 0x41, 0x51, 0x32}, /* F G */
+  {0x7f, 0x08, 0x08, 0x08, 0x7f}, {0x00, 0x41, 0x7f, 0x41, 0x00}, /* H I */
+  {0x20, 0x40, 0x41, 0x3f, 0x01}, {0x7f, 0x08, 0x14, 0x22, 0x41}, /* J K */
+  {0x7f, 0x40, 0x40, 0x40, 0x40}, {0x7f, 0x02, 0x04, 0x02, 0x7f}, /* L M */
+  {0x7f, 0x04, 0x08, 0x10, 0x7f}, {0x3e, 0x41, 0x41, 0x41, 0x3e}, /* N O */
+  {0x7f, 0x09, 0x09, 0x09, 0x06}, {0x3e, 0x41, 0x51, 0x21, 0x5e}, /* P Q */
+  {0x7f, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31}, /* R S */
+  {0x01, 0x01, 0x7f, 0x01, 0x01}, {0x3f, 0x40, 0x40, 0x40, 0x3f}, /* T U */
+  {0x1f, 0x20, 0x40, 0x20, 0x1f}, {0x7f, 0x20, 0x18, 0x20, 0x7f}, /* V W */
+  {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03}, /* X Y */
+  {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7f, 0x41, 0x41, 0x00}, /* Z [ */
+  {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7f, 0x00}, /* \ ] */
+  {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40}, /* ^ _ */
+  {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78}, /* ` a */
+  {0x7f, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, /* b c */
+  {0x38, 0x44, 0x44, 0x48, 0x7f}, {0x38, 0x54, 0x54, 0x54, 0x18}, /* d e */
+  {0x08, 0x7e, 0x09, 0x01, 0x02}, {0x08, 0x14, 0x54, 0x54, 0x3c}, /* f g */
+  {0x7f, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7d, 0x40, 0x00}, /* h i */
+  {0x20, 0x40, 0x44, 0x3d, 0x00}, {0x00, 0x7f, 0x10, 0x28, 0x44}, /* j k */
+  {0x00, 0x41, 0x7f, 0x40, 0x00}, {0x7c, 0x04, 0x18, 0x04, 0x78}, /* l m */
+  {0x7c, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, /* n o */
+  {0x7c, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7c}, /* p q */
+  {0x7c, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20}, /* r s */
+  {0x04, 0x3f, 0x44, 0x40, 0x20}, {0x3c, 0x40, 0x40, 0x20, 0x7c}, /* t u */
+  {0x1c, 0x20, 0x40, 0x20, 0x1c}, {0x3c, 0x40, 0x30, 0x40, 0x3c}, /* v w */
+  {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0c, 0x50, 0x50, 0x50, 0x3c}, /* x y */
+  {0x44, 0x64, 0x54, 0x4c, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, /* z { */
+  {0x00, 0x00, 0x7f, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, /* | } */
+  {0x10, 0x08, 0x08, 0x10, 0x08}                                  /* ~   */
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t DListCmdLen(const uint8_t *cmd, uint32_t left);
+static void DListSpan(uint8_t *line, int32_t x0, int32_t x1, uint8_t ink);
+static void DListText(const uint8_t *cmd, uint16_t y, uint8_t *line);
+static void DListLine(const uint8_t *cmd, uint16_t y, uint8_t *line);
+static void DListRect(const uint8_t *cmd, uint16_t y, uint8_t *line);
+static void DListSprite(const uint8_t *cmd, uint16_t y, uint8_t *line);
+static void DListQr(const uint8_t *cmd, uint16_t y, uint8_t *line);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Size of one command with its arguments
+  * @retval 0 if it is unknown or runs past left bytes
+  */
+static uint32_t DListCmdLen(const uint8_t *cmd, uint32_t left)
+{
+  uint32_t len;
+
+  switch (cmd[0])
+  {
+    case DLIST_OP_END:
+      return 1;
+    case DLIST_OP_TEXT:
+      len = (left >= 5U) ? (5U + cmd[4]) : 0U;
+      break;
+    case DLIST_OP_LINE:
+    case DLIST_OP_RECT:
+      len = 6;
+      break;
+    case DLIST_OP_SPRITE:
+      len = (left >= 6U) ? (6U + ((cmd[3] + 7U) / 8U) * cmd[4]) : 0U;
+      break;
+    case DLIST_OP_QR:
+      len = (left >= 5U) ? (5U + ((uint32_t)cmd[4] * cmd[4] + 7U) / 8U) : 0U;
+      break;
+    default:
+      return 0;
+  }
+  return (len <= left) ? len : 0U;
+}
+
+/**
+  * @brief  Draw pixels x0..x1 of the row, clipped to the panel
+  * @note   int32_t: a scaled glyph or QR module may start far past the edge
+  */
+static void DListSpan(uint8_t *line, int32_t x0, int32_t x1, uint8_t ink)
+{
+  if (x0 < 0)
+  {
+    x0 = 0;
+  }
+  if (x1 >= DLIST_WIDTH)
+  {
+    x1 = DLIST_WIDTH - 1;
+  }
+  for (; x0 <= x1; x0++)
+  {
+    if (ink == DLIST_INK_WHITE)
+    {
+      line[x0 >> 3] |= (uint8_t)(0x80U >> (x0 & 7));
+    }
+    else
+    {
+      line[x0 >> 3] &= (uint8_t)~(0x80U >> (x0 & 7));
+    }
+  }
+}
+
+static void DListText(const uint8_t *cmd, uint16_t y, uint8_t *line)
+{
+  uint8_t font = cmd[3] & 0x0fU;
+  uint8_t ink = cmd[3] & DLIST_INK_WHITE;
+  uint8_t scale;
+  uint8_t row, col, i, c;
+  int32_t x;
+
+  if (font > DLIST_FONT_MAX)
+  {
+    font = DLIST_FONT_MAX;
+  }
+  scale = font + 1U;
+  if ((y < cmd[2]) || (y >= cmd[2] + DLIST_FONT_H * scale))
+  {
+    return;
+  }
+
+  row = (uint8_t)((y - cmd[2]) / scale);
+  x = cmd[1];
+  for (i = 0; (i < cmd[4]) && (x < DLIST_WIDTH); i++)
+  {
+    c = cmd[5 + i];
+    if ((c < DLIST_FONT_FIRST) || (c > DLIST_FONT_LAST))
+    {
+      c = '?';
+    }
+    for (col = 0; col < DLIST_FONT_W; col++)
+    {
+      if (font5x7[c - DLIST_FONT_FIRST][col] & (1U << row))
+      {
+        DListSpan(line, x + col * scale, x + (col + 1) * scale - 1, ink);
+      }
+    }
+    x += DLIST_FONT_CELL_W * scale;
+  }
+}
+
+/**
+  * @brief  The pixels of a Bresenham line that fall on row y
+  */
+static void DListLine(const uint8_t *cmd, uint16_t y, uint8_t *line)
+{
+  int16_t x0 = cmd[1], y0 = cmd[2], x1 = cmd[3], y1 = cmd[4];
+  int16_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+  int16_t dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);
+  int16_t sx = (x0 < x1) ? 1 : -1;
+  int16_t sy = (y0 < y1) ? 1 : -1;
+  int16_t err = dx + dy;
+  int16_t e2;
+
+  if (((int16_t)y < y0 && (int16_t)y < y1) || ((int16_t)y > y0 && (int16_t)y > y1))
+  {
+    return;
+  }
+
+  for (;;)
+  {
+    if (y0 == (int16_t)y)
+    {
+      DListSpan(line, x0, x0, cmd[5] & DLIST_INK_WHITE);
+    }
+    if ((x0 == x1) && (y0 == y1))
+    {
+      break;
+    }
+    e2 = 2 * err;
+    if (e2 >= dy)
+    {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx)
+    {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+static void DListRect(const uint8_t *cmd, uint16_t y, uint8_t *line)
+{
+  int16_t x0 = cmd[1];
+  int16_t x1 = cmd[1] + cmd[3] - 1;
+  uint8_t ink = cmd[5] & DLIST_INK_WHITE;
+
+  if ((cmd[3] == 0U) || (cmd[4] == 0U) || (y < cmd[2]) || (y >= cmd[2] + cmd[4]))
+  {
+    return;
+  }
+
+  if ((cmd[5] & DLIST_RECT_FILL) || (y == cmd[2]) || (y == cmd[2] + cmd[4] - 1))
+  {
+    DListSpan(line, x0, x1, ink);
+  }
+  else
+  {
+    DListSpan(line, x0, x0, ink);
+    DListSpan(line, x1, x1, ink);
+  }
+}
+
+static void DListSprite(const uint8_t *cmd, uint16_t y, uint8_t *line)
+{
+  const uint8_t *row;
+  uint8_t i;
+
+  if ((y < cmd[2]) || (y >= cmd[2] + cmd[4]))
+  {
+    return;
+  }
+
+  row = &cmd[6 + ((cmd[3] + 7U) / 8U) * (y - cmd[2])];
+  for (i = 0; i < cmd[3]; i++)
+  {
+    if (row[i >> 3] & (0x80U >> (i & 7)))
+    {
+      DListSpan(line, (int32_t)cmd[1] + i, (int32_t)cmd[1] + i, cmd[5] & DLIST_INK_WHITE);
+    }
+  }
+}
+
+static void DListQr(const uint8_t *cmd, uint16_t y, uint8_t *line)
+{
+  uint8_t scale = cmd[3];
+  uint8_t n = cmd[4];
+  uint32_t bit;
+  uint8_t col;
+  int32_t x;
+
+  if ((scale == 0U) || (y < cmd[2]) || (y >= cmd[2] + (uint16_t)n * scale))
+  {
+    return;
+  }
+
+  bit = (uint32_t)((y - cmd[2]) / scale) * n;
+  x = cmd[1];
+  for (col = 0; (col < n) && (x < DLIST_WIDTH); col++, bit++, x += scale)
+  {
+    if (cmd[5 + (bit >> 3)] & (0x80U >> (bit & 7U)))
+    {
+      DListSpan(line, x, x + (int32_t)scale - 1, DLIST_INK_BLACK);
+    }
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint8_t DListCheck(const uint8_t *list, uint32_t len)
+{
+  uint32_t pos = DLIST_HDR_LEN;
+  uint32_t n;
+
+  if ((len <= DLIST_HDR_LEN) || (list[0] != DLIST_VERSION))
+  {
+    return 0;
+  }
+
+  while (pos < len)
+  {
+    n = DListCmdLen(&list[pos], len - pos);
+    if (n == 0U)
+    {
+      return 0;
+    }
+    if (list[pos] == DLIST_OP_END)
+    {
+      return 1;
+    }
+    pos += n;
+  }
+  return 0;  /* No end marker */
+}
+
+void DListRenderLine(const uint8_t *list, uint16_t y, uint8_t *line)
+{
+  const uint8_t *cmd = &list[DLIST_HDR_LEN];
+
+  memset(line, (list[1] == DLIST_INK_BLACK) ? 0x00 : 0xff, DLIST_LINE_LEN);
+
+  /* Checked by DListCheck(), the length can't run past the end any more */
+  while (cmd[0] != DLIST_OP_END)
+  {
+    switch (cmd[0])
+    {
+      case DLIST_OP_TEXT:
+        DListText(cmd, y, line);
+        break;
+      case DLIST_OP_LINE:
+        DListLine(cmd, y, line);
+        break;
+      case DLIST_OP_RECT:
+        DListRect(cmd, y, line);
+        break;
+      case DLIST_OP_SPRITE:
+        DListSprite(cmd, y, line);
+        break;
+      case DLIST_OP_QR:
+        DListQr(cmd, y, line);
+        break;
+      default:
+        break;
+    }
+    cmd += DListCmdLen(cmd, 0xffffU);
+  }
+}
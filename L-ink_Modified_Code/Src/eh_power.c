@@ -0,0 +1,102 @@
+/**
+  ******************************************************************************
+  * @file           : eh_power.c
+  * @brief          : Energy budget of a tag powered from the reader's field
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "eh_power.h"
+#include "nfc04a1_nfctag.h"
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t ehLevel = EH_POWER_REFRESH;
+static uint8_t ehField;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t EhVddAbove(uint32_t pvdLevel);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Compare VDD with one PVD threshold
+  * @retval 1 if VDD is above it
+  */
+static uint8_t EhVddAbove(uint32_t pvdLevel)
+{
+  PWR_PVDTypeDef pvd;
+  uint8_t above;
+
+  pvd.PVDLevel = pvdLevel;
+  pvd.Mode     = PWR_PVD_MODE_NORMAL;
+  HAL_PWR_ConfigPVD(&pvd);
+  HAL_PWR_EnablePVD();
+  HAL_Delay(1);  /* PVD settling */
+  above = (__HAL_PWR_GET_FLAG(PWR_FLAG_PVDO) == RESET);
+  HAL_PWR_DisablePVD();
+
+  return above;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void EhPowerInit(void)
+{
+  ST25DV_PASSWD passwd = {0, 0};
+  uint16_t gpo;
+
+  __HAL_RCC_PWR_CLK_ENABLE();
+
+  /* GPO pulses on field changes: the EXTI wake-up out of STOP */
+  if ((NFC04A1_NFCTAG_GetITStatus(NFC04A1_NFCTAG_INSTANCE, &gpo) == NFCTAG_OK) &&
+      ((gpo & (ST25DV_GPO_FIELDCHANGE_MASK | ST25DV_GPO_ENABLE_MASK)) != (ST25DV_GPO_FIELDCHANGE_MASK | ST25DV_GPO_ENABLE_MASK)))
+  {
+    NFC04A1_NFCTAG_PresentI2CPassword(NFC04A1_NFCTAG_INSTANCE, passwd);
+    NFC04A1_NFCTAG_ConfigIT(NFC04A1_NFCTAG_INSTANCE, gpo | ST25DV_GPO_FIELDCHANGE_MASK | ST25DV_GPO_ENABLE_MASK);
+  }
+  NFC04A1_NFCTAG_SetGPO_en_Dyn(NFC04A1_NFCTAG_INSTANCE);
+
+  EhPowerProcess();
+}
+
+uint8_t EhPowerProcess(void)
+{
+  ST25DV_EH_CTRL ctrl;
+  uint8_t level;
+
+  if (NFC04A1_NFCTAG_ReadEHCtrl_Dyn(NFC04A1_NFCTAG_INSTANCE, &ctrl) == NFCTAG_OK)
+  {
+    /* On demand mode: harvesting has to be asked for each time a field comes up */
+    if ((ctrl.Field_on == ST25DV_ENABLE) && (ctrl.EH_EN_Mode != ST25DV_ENABLE))
+    {
+      NFC04A1_NFCTAG_SetEHENMode_Dyn(NFC04A1_NFCTAG_INSTANCE);
+    }
+    ehField = ctrl.Field_on;
+  }
+
+  if (EhVddAbove(EH_REFRESH_PVD))
+  {
+    level = EH_POWER_REFRESH;
+  }
+  else if (EhVddAbove(EH_READ_PVD))
+  {
+    level = EH_POWER_READ;
+  }
+  else
+  {
+    level = EH_POWER_LOW;
+  }
+
+  ehLevel = level;
+  return level;
+}
+
+uint8_t EhPowerLevel(void)
+{
+  return ehLevel;
+}
+
+uint8_t EhPowerField(void)
+{
+  return (ehField == ST25DV_ENABLE) ? 1U : 0U;
+}
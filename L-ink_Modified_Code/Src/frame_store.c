@@ -0,0 +1,247 @@
+/**
+  ******************************************************************************
+  * @file           : frame_store.c
+  * @brief          : Keeps the last displayed frame in flash across power loss
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "frame_store.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+#define FRAME_STORE_MAGIC       0x46524D31U   /* "FRM1" */
+#define FRAME_STORE_HALF_PAGE   (FLASH_PAGE_SIZE / 2U)
+#define FRAME_STORE_HDR         (FRAME_STORE_BASE + FRAME_STORE_SIZE - FRAME_STORE_HALF_PAGE)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t magic;
+  uint32_t crc;
+  uint32_t len;
+} FrameStoreHdr;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t pageBuf[FLASH_PAGE_SIZE / 4U];  /* Append staging / page copy */
+static uint32_t appendOfs;                      /* Bytes appended so far      */
+
+/* Private function prototypes -----------------------------------------------*/
+static HAL_StatusTypeDef FrameStoreProgram(uint32_t addr, const uint32_t *data, uint32_t len);
+static HAL_StatusTypeDef FrameStoreRewrite(uint32_t page);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Program len bytes (whole words) of erased flash at addr
+  * @note   Word by word: half page programming has to run from RAM, the
+  *         Keil build places nothing there
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef FrameStoreProgram(uint32_t addr, const uint32_t *data, uint32_t len)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+
+  HAL_FLASH_Unlock();
+  for (; (status == HAL_OK) && (len >= 4U); len -= 4U)
+  {
+    status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, *data++);
+    addr += 4U;
+  }
+  HAL_FLASH_Lock();
+  return status;
+}
+
+/**
+  * @brief  Erase one flash page and program it from pageBuf
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef FrameStoreRewrite(uint32_t page)
+{
+  FLASH_EraseInitTypeDef erase;
+  uint32_t pageErr;
+  HAL_StatusTypeDef status;
+
+  HAL_FLASH_Unlock();
+
+  erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+  erase.PageAddress = page;
+  erase.NbPages     = 1;
+  status = HAL_FLASHEx_Erase(&erase, &pageErr);
+  HAL_FLASH_Lock();
+
+  if (status == HAL_OK)
+  {
+    status = FrameStoreProgram(page, pageBuf, FLASH_PAGE_SIZE);
+  }
+  return status;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint32_t FrameCrc32(const unsigned char *buf, uint32_t len)
+{
+  uint32_t crc = 0xFFFFFFFFU;
+  uint8_t bit;
+
+  while (len--)
+  {
+    crc ^= *buf++;
+    for (bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 1U) ? ((crc >> 1) ^ 0xEDB88320U) : (crc >> 1);
+    }
+  }
+  return ~crc;
+}
+
+uint8_t FrameStoreValid(uint32_t *crc)
+{
+  const FrameStoreHdr *hdr = (const FrameStoreHdr *)FRAME_STORE_HDR;
+
+  if ((hdr->magic != FRAME_STORE_MAGIC) || (hdr->len != FRAME_STORE_LEN))
+  {
+    return 0;
+  }
+  if (FrameCrc32(FRAME_STORE_DATA, FRAME_STORE_LEN) != hdr->crc)
+  {
+    return 0;
+  }
+
+  *crc = hdr->crc;
+  return 1;
+}
+
+HAL_StatusTypeDef FrameStoreBegin(void)
+{
+  FLASH_EraseInitTypeDef erase;
+  uint32_t pageErr;
+  HAL_StatusTypeDef status;
+
+  appendOfs = 0;
+
+  HAL_FLASH_Unlock();
+  erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+  erase.PageAddress = FRAME_STORE_BASE;
+  erase.NbPages     = FRAME_STORE_SIZE / FLASH_PAGE_SIZE;
+  status = HAL_FLASHEx_Erase(&erase, &pageErr);
+  HAL_FLASH_Lock();
+
+  return status;
+}
+
+HAL_StatusTypeDef FrameStoreAppend(const unsigned char *data, uint32_t len)
+{
+  uint32_t staged;
+  uint32_t n;
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if (appendOfs + len > FRAME_STORE_LEN)
+  {
+    return HAL_ERROR;
+  }
+
+  /* Staged by half pages, the flash is only touched once per 64 bytes */
+  while ((status == HAL_OK) && (len > 0U))
+  {
+    staged = appendOfs % FRAME_STORE_HALF_PAGE;
+    n = FRAME_STORE_HALF_PAGE - staged;
+    if (n > len)
+    {
+      n = len;
+    }
+    memcpy((uint8_t *)pageBuf + staged, data, n);
+    appendOfs += n;
+    data += n;
+    len -= n;
+
+    if ((appendOfs % FRAME_STORE_HALF_PAGE) == 0U)
+    {
+      status = FrameStoreProgram(FRAME_STORE_BASE + appendOfs - FRAME_STORE_HALF_PAGE, pageBuf, FRAME_STORE_HALF_PAGE);
+    }
+  }
+  return status;
+}
+
+HAL_StatusTypeDef FrameStoreFlush(void)
+{
+  uint32_t staged = appendOfs % FRAME_STORE_HALF_PAGE;
+  HAL_StatusTypeDef status;
+
+  if (staged == 0U)
+  {
+    return HAL_OK;
+  }
+
+  memset((uint8_t *)pageBuf + staged, 0, FRAME_STORE_HALF_PAGE - staged);
+  status = FrameStoreProgram(FRAME_STORE_BASE + appendOfs - staged, pageBuf, FRAME_STORE_HALF_PAGE);
+  appendOfs += FRAME_STORE_HALF_PAGE - staged;
+  return status;
+}
+
+HAL_StatusTypeDef FrameStorePatch(uint32_t ofs, const unsigned char *data, uint32_t len)
+{
+  uint32_t page;
+  uint32_t n;
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if (ofs + len > FRAME_STORE_LEN)
+  {
+    return HAL_ERROR;
+  }
+
+  /* The stored frame is about to change: drop the header first */
+  if (((const FrameStoreHdr *)FRAME_STORE_HDR)->magic != 0U)
+  {
+    memcpy(pageBuf, (const void *)(FRAME_STORE_HDR & ~(FLASH_PAGE_SIZE - 1U)), FLASH_PAGE_SIZE);
+    memset(&pageBuf[FRAME_STORE_HALF_PAGE / 4U], 0, FRAME_STORE_HALF_PAGE);
+    status = FrameStoreRewrite(FRAME_STORE_HDR & ~(FLASH_PAGE_SIZE - 1U));
+  }
+
+  /* Read-modify-write of each touched page, unchanged pages are left alone */
+  while ((status == HAL_OK) && (len > 0U))
+  {
+    page = (FRAME_STORE_BASE + ofs) & ~(FLASH_PAGE_SIZE - 1U);
+    n = page + FLASH_PAGE_SIZE - (FRAME_STORE_BASE + ofs);
+    if (n > len)
+    {
+      n = len;
+    }
+    if (memcmp((const void *)(FRAME_STORE_BASE + ofs), data, n) != 0)
+    {
+      memcpy(pageBuf, (const void *)page, FLASH_PAGE_SIZE);
+      memcpy((uint8_t *)pageBuf + (FRAME_STORE_BASE + ofs - page), data, n);
+      status = FrameStoreRewrite(page);
+    }
+    ofs += n;
+    data += n;
+    len -= n;
+  }
+  return status;
+}
+
+HAL_StatusTypeDef FrameStoreCommit(uint32_t crc)
+{
+  const FrameStoreHdr *cur = (const FrameStoreHdr *)FRAME_STORE_HDR;
+  FrameStoreHdr *hdr;
+  HAL_StatusTypeDef status;
+
+  if ((cur->magic == FRAME_STORE_MAGIC) && (cur->crc == crc))
+  {
+    return HAL_OK;  /* Nothing changed */
+  }
+
+  status = FrameStoreFlush();
+  appendOfs = 0;
+
+  if (status == HAL_OK)
+  {
+    memset(pageBuf, 0, FRAME_STORE_HALF_PAGE);
+    hdr = (FrameStoreHdr *)pageBuf;
+    hdr->magic = FRAME_STORE_MAGIC;
+    hdr->crc   = crc;
+    hdr->len   = FRAME_STORE_LEN;
+    status = FrameStoreProgram(FRAME_STORE_HDR, pageBuf, sizeof(FrameStoreHdr));
+  }
+  return status;
+}
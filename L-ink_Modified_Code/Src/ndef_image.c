@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file           : ndef_image.c
+  * @brief          : Finds an image record in the ST25DV's NDEF area
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ndef_image.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+#define NDEF_CC_MAGIC_1B    0xe1    /* One byte address mode           */
+#define NDEF_CC_MAGIC_2B    0xe2    /* Two byte address mode           */
+#define NDEF_CC_VERSION_1   0x40    /* Major version in bits 7..6      */
+#define NDEF_CC_VERSION     0xc0
+
+#define NDEF_TLV_NULL       0x00
+#define NDEF_TLV_NDEF       0x03
+#define NDEF_TLV_TERMINATOR 0xfe
+#define NDEF_TLV_LEN_3B     0xff    /* Length in the next two bytes    */
+
+#define NDEF_REC_MB         0x80
+#define NDEF_REC_CF         0x20
+#define NDEF_REC_SR         0x10
+#define NDEF_REC_IL         0x08
+#define NDEF_REC_TNF        0x07
+#define NDEF_TNF_MEDIA      0x02
+
+#define NDEF_UNPACK_HEADER  0
+#define NDEF_UNPACK_LITERAL 1
+#define NDEF_UNPACK_VALUE   2       /* Run header seen, byte to repeat next */
+#define NDEF_UNPACK_RUN     3
+
+/* Private macro -------------------------------------------------------------*/
+#define NDEF_BE16(p)        (((uint16_t)(p)[0] << 8) | (p)[1])
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t NdefImageType(const uint8_t *type, uint8_t len);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Map a MIME type to NDEF_IMAGE_*
+  */
+static uint8_t NdefImageType(const uint8_t *type, uint8_t len)
+{
+  if ((len == sizeof(NDEF_IMAGE_TYPE_RAW) - 1) && (memcmp(type, NDEF_IMAGE_TYPE_RAW, len) == 0))
+  {
+    return NDEF_IMAGE_RAW;
+  }
+  if ((len == sizeof(NDEF_IMAGE_TYPE_PACKBITS) - 1) && (memcmp(type, NDEF_IMAGE_TYPE_PACKBITS, len) == 0))
+  {
+    return NDEF_IMAGE_PACKBITS;
+  }
+  return NDEF_IMAGE_NONE;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint8_t NdefImageFind(const uint8_t *head, uint16_t len, uint32_t memSize, NdefImageInfo *info)
+{
+  uint32_t pos, tlvLen, msg, payLen;
+  uint8_t tlvType, flags, typeLen, idLen;
+
+  info->Format = NDEF_IMAGE_NONE;
+  info->MessageEnd = 0;
+
+  if ((len < 8) || ((head[0] != NDEF_CC_MAGIC_1B) && (head[0] != NDEF_CC_MAGIC_2B)) ||
+      ((head[1] & NDEF_CC_VERSION) != NDEF_CC_VERSION_1))
+  {
+    return 0;  /* Not formatted, or the private transfer's slot */
+  }
+  pos = (head[2] != 0) ? 4 : 8;  /* MLEN 0: 8 byte CC with a 16 bit MLEN */
+
+  /* Skip NULL and foreign TLVs up to the NDEF TLV */
+  for (;;)
+  {
+    if (pos + 2 > len)
+    {
+      return 0;
+    }
+    if (head[pos] == NDEF_TLV_NULL)
+    {
+      pos++;
+      continue;
+    }
+    if (head[pos] == NDEF_TLV_TERMINATOR)
+    {
+      return 0;
+    }
+    tlvType = head[pos];
+    tlvLen = head[pos + 1];
+    pos += 2;
+    if (tlvLen == NDEF_TLV_LEN_3B)
+    {
+      if (pos + 2 > len)
+      {
+        return 0;
+      }
+      tlvLen = NDEF_BE16(&head[pos]);
+      pos += 2;
+    }
+    if (tlvType == NDEF_TLV_NDEF)
+    {
+      break;
+    }
+    pos += tlvLen;
+  }
+
+  /* L = 0 while a writer is still busy with the message */
+  msg = pos;
+  if ((tlvLen == 0) || (msg + tlvLen > memSize) || (msg + 3 > len))
+  {
+    return 0;
+  }
+  info->MessageEnd = (uint16_t)(msg + tlvLen);
+
+  flags = head[msg];
+  if (((flags & NDEF_REC_MB) == 0) || ((flags & NDEF_REC_CF) != 0) || ((flags & NDEF_REC_TNF) != NDEF_TNF_MEDIA))
+  {
+    return 0;
+  }
+  typeLen = head[msg + 1];
+  pos = msg + 2;
+  if (flags & NDEF_REC_SR)
+  {
+    payLen = head[pos];
+    pos += 1;
+  }
+  else
+  {
+    if (pos + 4 > len)
+    {
+      return 0;
+    }
+    payLen = ((uint32_t)NDEF_BE16(&head[pos]) << 16) | NDEF_BE16(&head[pos + 2]);
+    pos += 4;
+  }
+  idLen = 0;
+  if (flags & NDEF_REC_IL)
+  {
+    if (pos + 1 > len)
+    {
+      return 0;
+    }
+    idLen = head[pos];
+    pos += 1;
+  }
+  if ((pos + typeLen > len) || (pos + typeLen + idLen + payLen > msg + tlvLen))
+  {
+    return 0;
+  }
+
+  info->Format = NdefImageType(&head[pos], typeLen);
+  info->PayloadAddr = (uint16_t)(pos + typeLen + idLen);
+  info->PayloadLen = (uint16_t)payLen;
+  return (info->Format != NDEF_IMAGE_NONE) ? 1 : 0;
+}
+
+void NdefImageUnpackInit(NdefImageUnpacker *u, uint8_t format)
+{
+  u->Format = format;
+  u->State = NDEF_UNPACK_HEADER;
+  u->Count = 0;
+  u->Value = 0;
+}
+
+uint16_t NdefImageUnpack(NdefImageUnpacker *u, const uint8_t *in, uint16_t inLen,
+                         uint8_t *out, uint16_t outLen, uint16_t *used)
+{
+  uint16_t i = 0, o = 0, n;
+
+  if (u->Format == NDEF_IMAGE_RAW)
+  {
+    n = (inLen < outLen) ? inLen : outLen;
+    if (out != NULL)
+    {
+      memcpy(out, in, n);
+    }
+    *used = n;
+    return n;
+  }
+
+  while (o < outLen)
+  {
+    if (u->State == NDEF_UNPACK_RUN)
+    {
+      n = ((uint16_t)(outLen - o) < u->Count) ? (outLen - o) : u->Count;
+      if (out != NULL)
+      {
+        memset(&out[o], u->Value, n);
+      }
+      o += n;
+      u->Count -= n;
+      if (u->Count == 0)
+      {
+        u->State = NDEF_UNPACK_HEADER;
+      }
+      continue;
+    }
+    if (i >= inLen)
+    {
+      break;
+    }
+    switch (u->State)
+    {
+      case NDEF_UNPACK_HEADER:
+        if (in[i] < 0x80)
+        {
+          u->Count = in[i] + 1;
+          u->State = NDEF_UNPACK_LITERAL;
+        }
+        else if (in[i] > 0x80)
+        {
+          u->Count = 257 - in[i];
+          u->State = NDEF_UNPACK_VALUE;
+        }
+        i++;
+        break;
+
+      case NDEF_UNPACK_LITERAL:
+        n = inLen - i;
+        n = (n < u->Count) ? n : u->Count;
+        n = (n < outLen - o) ? n : (outLen - o);
+        if (out != NULL)
+        {
+          memcpy(&out[o], &in[i], n);
+        }
+        i += n;
+        o += n;
+        u->Count -= n;
+        if (u->Count == 0)
+        {
+          u->State = NDEF_UNPACK_HEADER;
+        }
+        break;
+
+      default:  /* NDEF_UNPACK_VALUE */
+        u->Value = in[i++];
+        u->State = NDEF_UNPACK_RUN;
+        break;
+    }
+  }
+
+  /* A header or run value with no room left is taken with the next call */
+  *used = i;
+  return o;
+}
+
+uint8_t NdefImageUnpackDone(const NdefImageUnpacker *u)
+{
+  return (u->State == NDEF_UNPACK_HEADER) ? 1 : 0;
+}
@@ -23,6 +23,8 @@
 #include "stm32l0xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "custom_bus.h"
+#include "epd_w21.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -128,6 +130,7 @@ void SysTick_Handler(void)
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
+  BSP_I2C1_Tick();
 
   /* USER CODE END SysTick_IRQn 1 */
 }
@@ -155,5 +158,41 @@ void EXTI2_3_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles EXTI line 4 to 15 interrupts (e-paper BUSY).
+  */
+void EXTI4_15_IRQHandler(void)
+{
+  if (__HAL_GPIO_EXTI_GET_IT(INK_IS_BUSY_Pin) != 0x00u)
+  {
+    __HAL_GPIO_EXTI_CLEAR_IT(INK_IS_BUSY_Pin);
+    EpdBusyIrq();
+  }
+}
+
+/**
+  * @brief This function handles DMA1 channel 2 and channel 3 interrupts (I2C1 TX / RX).
+  */
+void DMA1_Channel2_3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_tx);
+  HAL_DMA_IRQHandler(&hdma_i2c1_rx);
+}
+
+/**
+  * @brief This function handles I2C1 event and error interrupts.
+  */
+void I2C1_IRQHandler(void)
+{
+  if (hi2c1.Instance->ISR & (I2C_FLAG_BERR | I2C_FLAG_ARLO | I2C_FLAG_OVR))
+  {
+    HAL_I2C_ER_IRQHandler(&hi2c1);
+  }
+  else
+  {
+    HAL_I2C_EV_IRQHandler(&hi2c1);
+  }
+}
+
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,63 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Startup time profiler
+ *
+ *  Named marks are timestamped with the Cortex-M3 cycle counter, which
+ *  resolves the few milliseconds an RF calibration takes where the 1ms
+ *  SysTick doesn't. bootProfilePrint() lists each mark with the time since
+ *  bootProfileStart() and since the previous mark. Marks beyond
+ *  BOOT_PROFILE_MARKS are dropped.
+ *
+ */
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <stdint.h>
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define BOOT_PROFILE_MARKS        12U            /*!< Marks kept until printed                  */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Start the cycle counter and forget earlier marks
+ *
+ * Call once the system clock is set up.
+ *****************************************************************************
+ */
+void bootProfileStart( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Timestamp the end of a startup step
+ *
+ * \param[in]  name : step name, must stay valid until printed
+ *****************************************************************************
+ */
+void bootProfileMark( const char *name );
+
+/*!
+ *****************************************************************************
+ * \brief  Print all marks to the console
+ *****************************************************************************
+ */
+void bootProfilePrint( void );
+
+#endif /* BOOT_PROFILE_H */
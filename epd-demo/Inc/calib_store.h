@@ -0,0 +1,72 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief ST25R3911 calibration results kept across resets
+ *
+ *  rfalInitialize() adjusts the regulators and calibrates the antenna on
+ *  every boot. The results are stored in one flash page together with the
+ *  supply voltage and the antenna amplitude and phase measured right after
+ *  calibrating. On the next boot the regulator and trim settings are written
+ *  back as manual settings and the three values are measured again; only if
+ *  one of them moved by more than its drift limit (other supply, metal near
+ *  the antenna) is the full calibration run and the page rewritten.
+ *
+ *  The page sits right below FRAME_STORE_BASE; the Keil target's IROM1 size
+ *  stops below CALIB_STORE_ADDR.
+ *
+ */
+
+#ifndef CALIB_STORE_H
+#define CALIB_STORE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define CALIB_STORE_ADDR          0x0801AC00U    /*!< Calibration page, keep in sync with IROM1 */
+#define CALIB_STORE_VDD_DRIFT     4U             /*!< Supply drift limit, 23.4mV steps           */
+#define CALIB_STORE_AMP_DRIFT     6U             /*!< Amplitude drift limit, A/D steps           */
+#define CALIB_STORE_PHASE_DRIFT   6U             /*!< Phase drift limit, A/D steps               */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Apply stored calibration results
+ *
+ * Called by rfalInitialize() instead of rfalCalibrate(). Briefly turns the
+ * field on to check the antenna against the stored measurements. On a
+ * mismatch the manual settings are cleared again.
+ *
+ * \return true  : Settings restored, no calibration needed
+ * \return false : No valid record or drift detected, calibrate
+ *****************************************************************************
+ */
+bool calibStoreRestore( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Store the results of the calibration that just ran
+ *
+ * Called by rfalInitialize() after rfalCalibrate(). Nothing is written if the
+ * antenna calibration reported an error. Blocks for the page erase and
+ * programming time (about 25ms).
+ *****************************************************************************
+ */
+void calibStoreSave( void );
+
+#endif /* CALIB_STORE_H */
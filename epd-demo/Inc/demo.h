@@ -46,15 +46,19 @@ extern "C" {
 #include "platform.h"
 #include "st_errno.h"
 #include "stdio.h"
+#include "frame_source.h"
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+#define DEMO_SERVICE_MODE   true    /*!< Serve tags hands-free from the low power wake-up mode */
 /* Exported macro ------------------------------------------------------------*/
 
 /* Exported functions ------------------------------------------------------- */
 bool demoIni( void );
 extern void demoCycle(void);
-void nfcBufInit(void);
-void nfcBuf2Init(void);
+void demoIdle( void );
+void demoSetFrameSource( frameSource *src );
+void demoFleetUpdate( void );
+void demoFleetLabel( void );
 #ifdef __cplusplus
 }
 #endif
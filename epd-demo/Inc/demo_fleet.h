@@ -0,0 +1,205 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Multi-tag frame transfer engine
+ *
+ *  Pushes one frame to every tag of a job table in addressed mode. Each
+ *  frame slot is written to a tag's EEPROM followed by the 0xAA flag block;
+ *  instead of waiting a fixed time for the tag to copy the slot out, the
+ *  engine polls the flag block and meanwhile writes slots to other tags,
+ *  so one tag's I2C copy / display refresh overlaps another's RF transfer.
+ *
+ *  Each slot is preceded by its CRC-32 (big endian) in the header block
+ *  and flagged with { 0xAA, slot, frame ID, slots }. The tag checks the
+ *  slot against the CRC as it copies it out, then once more over its flash
+ *  after the last slot, and reports { status, slot, frame ID, 0 } in the
+ *  status block before clearing the flag. A slot that failed comes back as
+ *  0xE4 with the slot to send again; the frame goes on from there instead
+ *  of from the start. Without a frame ID echo (older tag firmware) a
+ *  cleared flag counts as success; once a tag has echoed the ID, a status
+ *  with a stale or unknown ID (the tag couldn't read the flag) has the
+ *  slot sent again.
+ *
+ *  The tag firmware drops a partially received frame when no slot arrives
+ *  for about 4s, so only DEMO_FLEET_ACTIVE_MAX tags are served at a time;
+ *  the others are queued and started as active ones complete.
+ *
+ *  When the frame store holds the last frame delivered to a tag, only the
+ *  blocks that changed are sent. Delta chunks use the same EEPROM area and
+ *  the 0xAB flag { 0xAB, chunk, last, 0 }; chunk layout (big endian):
+ *
+ *    | base CRC-32 (4) | new CRC-32 (4) | run | run | ... | 0xFFFF |
+ *    run: | first frame block (2) | count (1) | count * 4 data bytes |
+ *
+ *  The tag checks its frame against the base CRC on chunk 0, patches it in
+ *  place and checks the new CRC after the last chunk. Before clearing the
+ *  flag it reports { status, chunk, 0, 0 } in the status block; on any
+ *  error status the engine falls back to sending the whole frame.
+ *
+ *  A display list (dlist.h) fits in one slot: it is written to blocks
+ *  0.., flagged with { 0xAC, 0, 0, 0 } and the tag reports FRAME_OK or
+ *  CRC_ERR (list rejected) in the status block before clearing the flag.
+ *
+ */
+
+#ifndef DEMO_FLEET_H
+#define DEMO_FLEET_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+#include "rfal_nfcv.h"
+#include "frame_source.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define DEMO_FLEET_MAX_TAGS        16U      /*!< Job table size                           */
+#define DEMO_FLEET_ACTIVE_MAX      3U       /*!< Tags served concurrently                 */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! Job state */
+typedef enum
+{
+    DEMO_FLEET_QUEUED,                      /*!< Waiting for an active slot               */
+    DEMO_FLEET_SEND,                        /*!< Next slot ready to be written            */
+    DEMO_FLEET_WAIT,                        /*!< Flag written, tag copying the slot       */
+    DEMO_FLEET_DONE,                        /*!< Whole frame delivered                    */
+    DEMO_FLEET_FAILED                       /*!< Gave up after DEMO_FLEET_MAX_RETRIES     */
+} demoFleetState;
+
+/*! Per tag job */
+typedef struct
+{
+    uint8_t        uid[RFAL_NFCV_UID_LEN];  /*!< Tag UID (as received, LSB first)         */
+    demoFleetState state;                   /*!< Job state                                */
+    uint8_t        slot;                    /*!< Slot being sent / waited for             */
+    uint8_t        retries;                 /*!< Slot retries so far                      */
+    uint8_t        restarts;                /*!< Frame restarts after a tag timeout       */
+    uint16_t       blkErrors;               /*!< Block writes that needed a retry         */
+    uint32_t       flagTick;                /*!< Time the last flag was written           */
+    uint32_t       pollTick;                /*!< Time of the last flag poll               */
+    uint32_t       startTick;               /*!< Time the job became active               */
+    uint32_t       doneTick;                /*!< Time the job completed                   */
+    ReturnCode     lastErr;                 /*!< Last RF or source error                  */
+    bool           delta;                   /*!< Sending changed blocks only              */
+    uint8_t        chunk;                   /*!< Delta chunk being sent / waited for      */
+    uint8_t        chunks;                  /*!< Delta chunks needed for this frame       */
+    uint8_t        fallbacks;               /*!< Deltas the tag rejected                  */
+    uint8_t        resends;                 /*!< Slots the tag asked for again            */
+    bool           echoed;                  /*!< Tag echoed the frame ID in this run      */
+    uint16_t       deltaBlock;              /*!< First frame block of the current chunk   */
+    uint16_t       deltaNext;               /*!< First frame block of the next chunk      */
+    const uint8_t *base;                    /*!< Frame the tag holds, NULL if unknown     */
+    uint32_t       baseCrc;                 /*!< CRC-32 of base                           */
+} demoFleetJob;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Clear the job table
+ *****************************************************************************
+ */
+void demoFleetReset( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a tag to the job table
+ *
+ * \param[in]  uid : tag UID, RFAL_NFCV_UID_LEN bytes as received
+ *
+ * \return ERR_NOMEM : Job table full
+ * \return ERR_NONE  : Added, or already in the table
+ *****************************************************************************
+ */
+ReturnCode demoFleetAdd( const uint8_t *uid );
+
+/*!
+ *****************************************************************************
+ * \brief  Inventory all NFC-V tags in the field and add them as jobs
+ *
+ * Turns the field on and runs the sleep based collision resolution, which
+ * keeps every found tag quiet so the remaining ones answer. Quiet tags
+ * still execute addressed commands.
+ *
+ * \return number of tags in the job table
+ *****************************************************************************
+ */
+uint8_t demoFleetInventory( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Deliver a frame to every job in the table
+ *
+ * Blocks until each job is done or failed. The RF field must be on.
+ * Tags found in the frame store get a delta, and every tag that received
+ * a seekable FRAME_LEN frame is recorded in the frame store afterwards.
+ *
+ * A source that isn't seekable (a UART upload) is read once, in order: it
+ * is sent to a single tag, and a slot that tag asks for again fails the
+ * job with ERR_NOTSUPP instead of being resent.
+ *
+ * \param[in]  src : frame to send
+ *
+ * \return ERR_PARAM   : Invalid frame source
+ * \return ERR_NOTSUPP : Source not seekable and more than one job
+ * \return ERR_IO      : At least one tag failed
+ * \return ERR_NONE    : All tags received the frame
+ *****************************************************************************
+ */
+ReturnCode demoFleetRun( frameSource *src );
+
+/*!
+ *****************************************************************************
+ * \brief  Send a display list to every job in the table
+ *
+ * Blocks until each job is done or failed. The RF field must be on.
+ * The frame store keeps its entries: a later delta against them is
+ * refused by the tag and falls back to the whole frame.
+ *
+ * \param[in]  list : list built with dlistBegin() .. dlistEnd()
+ * \param[in]  len  : list length, at most DLIST_MAX_LEN
+ *
+ * \return ERR_PARAM : Invalid list
+ * \return ERR_IO    : At least one tag failed
+ * \return ERR_NONE  : All tags show the list
+ *****************************************************************************
+ */
+ReturnCode demoFleetRunList( const uint8_t *list, uint16_t len );
+
+/*!
+ *****************************************************************************
+ * \brief  Get a job of the table, with the result of the last run
+ *
+ * \param[in]  idx : job index
+ *
+ * \return job, NULL once idx is past the last one
+ *****************************************************************************
+ */
+const demoFleetJob *demoFleetGetJob( uint8_t idx );
+
+/*!
+ *****************************************************************************
+ * \brief  Print the per tag status of the last run
+ *****************************************************************************
+ */
+void demoFleetReport( void );
+
+#endif /* DEMO_FLEET_H */
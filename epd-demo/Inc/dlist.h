@@ -0,0 +1,156 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Display list encoder
+ *
+ *  Builds the drawing command lists the tag firmware renders row by row
+ *  (L-ink_Modified_Code/Inc/display_list.h). A list replaces the 5000 byte
+ *  bitmap with a few hundred bytes and is sent in a single slot, see
+ *  demoFleetRunList().
+ *
+ *  Layout, coordinates in pixels from the top left corner:
+ *
+ *    | version | background | command | command | ... | DLIST_OP_END |
+ *
+ *    DLIST_OP_TEXT   x, y, font, len, len characters
+ *    DLIST_OP_LINE   x0, y0, x1, y1, ink
+ *    DLIST_OP_RECT   x, y, w, h, style
+ *    DLIST_OP_SPRITE x, y, w, h, ink, ((w + 7) / 8) * h bytes, rows MSB first
+ *    DLIST_OP_QR     x, y, scale, n, (n * n + 7) / 8 bytes of modules,
+ *                    row after row without padding, 1 = dark
+ *
+ *  The builder stops adding commands once one does not fit; dlistEnd()
+ *  then reports the list as incomplete.
+ *
+ */
+
+#ifndef DLIST_H
+#define DLIST_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define DLIST_VERSION              0x01U    /*!< List format understood by the tag        */
+#define DLIST_MAX_LEN              500U     /*!< Tag EEPROM below the flag block          */
+
+#define DLIST_OP_END               0x00U    /*!< End of the list                          */
+#define DLIST_OP_TEXT              0x01U    /*!< Text in one of the DLIST_FONT_*          */
+#define DLIST_OP_LINE              0x02U    /*!< One pixel wide line                      */
+#define DLIST_OP_RECT              0x03U    /*!< Rectangle outline or filled              */
+#define DLIST_OP_SPRITE            0x04U    /*!< 1 bpp bitmap                             */
+#define DLIST_OP_QR                0x05U    /*!< Square module matrix, scaled             */
+
+#define DLIST_INK_BLACK            0x00U    /*!< Ink / background black                   */
+#define DLIST_INK_WHITE            0x80U    /*!< Ink / background white                   */
+#define DLIST_RECT_FILL            0x01U    /*!< Rectangle style: filled                  */
+
+#define DLIST_FONT_5X7             0x00U    /*!< 6x8 cell                                 */
+#define DLIST_FONT_10X14           0x01U    /*!< 5x7 font scaled twice                    */
+#define DLIST_FONT_15X21           0x02U    /*!< 5x7 font scaled three times              */
+#define DLIST_FONT_20X28           0x03U    /*!< 5x7 font scaled four times               */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! List being built */
+typedef struct
+{
+    uint8_t  *buf;                          /*!< Caller's buffer                          */
+    uint16_t size;                          /*!< Size of buf                              */
+    uint16_t len;                           /*!< Bytes used                               */
+    bool     overflow;                      /*!< A command did not fit                    */
+} dlist;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Start a list
+ *
+ * \param[out] dl         : list
+ * \param[in]  buf        : buffer, up to DLIST_MAX_LEN bytes are sent
+ * \param[in]  size       : size of buf
+ * \param[in]  background : DLIST_INK_BLACK or DLIST_INK_WHITE
+ *****************************************************************************
+ */
+void dlistBegin( dlist *dl, uint8_t *buf, uint16_t size, uint8_t background );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a text
+ *
+ * \param[in]  font : DLIST_FONT_*, or'ed with DLIST_INK_WHITE for white text
+ * \param[in]  text : zero terminated, at most 255 characters
+ *****************************************************************************
+ */
+void dlistText( dlist *dl, uint8_t x, uint8_t y, uint8_t font, const char *text );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a line from x0,y0 to x1,y1
+ *****************************************************************************
+ */
+void dlistLine( dlist *dl, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t ink );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a rectangle
+ *
+ * \param[in]  style : ink, or'ed with DLIST_RECT_FILL for a filled one
+ *****************************************************************************
+ */
+void dlistRect( dlist *dl, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a sprite
+ *
+ * Set bits are drawn in ink, clear bits leave the pixel as it is.
+ *
+ * \param[in]  bits : ((w + 7) / 8) * h bytes, rows MSB first
+ *****************************************************************************
+ */
+void dlistSprite( dlist *dl, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t ink, const uint8_t *bits );
+
+/*!
+ *****************************************************************************
+ * \brief  Add a QR code module matrix
+ *
+ * \param[in]  scale   : pixels per module
+ * \param[in]  n       : modules per side
+ * \param[in]  modules : (n * n + 7) / 8 bytes, row after row, 1 = dark
+ *****************************************************************************
+ */
+void dlistQr( dlist *dl, uint8_t x, uint8_t y, uint8_t scale, uint8_t n, const uint8_t *modules );
+
+/*!
+ *****************************************************************************
+ * \brief  Terminate the list
+ *
+ * \param[out] len : list length to send
+ *
+ * \return ERR_NOMEM : A command or the end marker did not fit
+ * \return ERR_NONE  : List complete
+ *****************************************************************************
+ */
+ReturnCode dlistEnd( dlist *dl, uint16_t *len );
+
+#endif /* DLIST_H */
@@ -0,0 +1,94 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame source streaming an image file from the SD card
+ *
+ *  The file is read one slot (FRAME_SLOT_LEN bytes) at a time into one of
+ *  two slot buffers. While the tag is busy storing slot N the transfer
+ *  engine's prefetch hint loads slot N+1 into the other buffer, so SD
+ *  access time is hidden behind the tag's own processing time and only
+ *  two slots of the frame are ever held in RAM.
+ *
+ */
+
+#ifndef FRAME_FILE_H
+#define FRAME_FILE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_source.h"
+#include "ff.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define FRAME_FILE_BUFS       2U          /*!< Slot buffers (double buffering)          */
+#define FRAME_FILE_PATH_LEN   32U         /*!< Max path length of an image file         */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! File frame source context */
+typedef struct
+{
+    FIL      fil;                                         /*!< Open image file                   */
+    bool     isOpen;                                      /*!< fil is valid                      */
+    int16_t  slot[FRAME_FILE_BUFS];                       /*!< Slot held by each buffer, -1: none */
+    uint8_t  buf[FRAME_FILE_BUFS][FRAME_SLOT_LEN];        /*!< Slot buffers                      */
+    TCHAR    path[FRAME_FILE_PATH_LEN];                   /*!< Path of the open file             */
+} frameFile;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Initialize a frame source over an image file
+ *
+ * Any file previously opened through \a file is closed first. The file
+ * must hold exactly one raw FRAME_LEN bytes 1bpp frame.
+ *
+ * \param[out] src  : frame source to initialize
+ * \param[in]  file : file context, must stay valid while src is in use
+ * \param[in]  path : image file path
+ *
+ * \return ERR_PARAM : Invalid parameters or file size is not FRAME_LEN
+ * \return ERR_IO    : File could not be opened
+ * \return ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode frameSourceInitFile( frameSource *src, frameFile *file, const TCHAR *path );
+
+/*!
+ *****************************************************************************
+ * \brief  Open the next image file of a directory
+ *
+ * Walks \a dir, wrapping to its first entry at the end, and opens the next
+ * regular file as frame source. Subdirectories and files of the wrong size
+ * are skipped.
+ *
+ * \param[out] src     : frame source to initialize
+ * \param[in]  file    : file context
+ * \param[in]  dir     : directory object, opened on first use
+ * \param[in]  dirPath : directory path
+ *
+ * \return ERR_NOTFOUND : No image in the directory
+ * \return ERR_IO       : Directory could not be read
+ * \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode frameFileOpenNext( frameSource *src, frameFile *file, DIR *dir, const TCHAR *dirPath );
+
+#endif /* FRAME_FILE_H */
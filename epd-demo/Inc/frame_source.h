@@ -0,0 +1,156 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame source interface used by the NFC-V transfer engine
+ *
+ *  A frame source hands out the image one NFC-V block at a time. The
+ *  transfer engine never owns a copy of the frame: in-flash frames are
+ *  returned by pointer, streaming sources fill a block-sized scratch area.
+ *
+ *  The ST25DV04K exposes FRAME_SLOT_BLOCKS blocks of user memory per round,
+ *  so a frame is sent as consecutive slots. Slot and slot-relative block
+ *  numbers are derived from the absolute block number on the fly.
+ *
+ */
+
+#ifndef FRAME_SOURCE_H
+#define FRAME_SOURCE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define FRAME_BLOCK_LEN       4U                                        /*!< ST25DV04K NFC-V block length                 */
+#define FRAME_SLOT_BLOCKS     125U                                      /*!< Blocks per round: tag EEPROM bytes 0..499    */
+#define FRAME_SLOT_LEN        (FRAME_SLOT_BLOCKS * FRAME_BLOCK_LEN)     /*!< Bytes per round                              */
+#define FRAME_LEN             5000U                                     /*!< 200x200 1bpp e-paper frame                   */
+
+/*
+******************************************************************************
+* GLOBAL MACROS
+******************************************************************************
+*/
+#define frameSourceSlot( blockNo )       ((uint8_t)((blockNo) / FRAME_SLOT_BLOCKS))  /*!< Round a frame block is sent in       */
+#define frameSourceSlotBlock( blockNo )  ((uint8_t)((blockNo) % FRAME_SLOT_BLOCKS))  /*!< Tag block number within its round   */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+typedef struct frameSourceStruct frameSource;
+
+/*! Block accessor: point *blockData at FRAME_BLOCK_LEN bytes of block blockNo */
+typedef ReturnCode (*frameSourceBlockFunc)( frameSource *src, uint16_t blockNo, const uint8_t **blockData );
+
+/*! Prefetch hint: block blockNo will be requested next */
+typedef void (*frameSourcePrefetchFunc)( frameSource *src, uint16_t blockNo );
+
+/*! Frame source */
+struct frameSourceStruct
+{
+    uint32_t                len;                     /*!< Frame length in bytes                               */
+    frameSourceBlockFunc    getBlock;                /*!< Block accessor                                      */
+    frameSourcePrefetchFunc prefetch;                /*!< Optional prefetch hint, NULL if not needed          */
+    const uint8_t          *mem;                     /*!< Frame data for memory mapped (flash) sources        */
+    void                   *ctx;                     /*!< Private context of streaming sources                */
+    bool                    seekable;                /*!< Blocks may be requested in any order, more than once */
+    uint8_t                 pad[FRAME_BLOCK_LEN];    /*!< Scratch for a trailing partial block                */
+};
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Initialize a frame source over a frame stored in memory
+ *
+ * The frame is not copied; blocks are returned as pointers into \a frame,
+ * so a const array placed in flash is served without using any RAM.
+ *
+ * \param[out] src   : frame source to initialize
+ * \param[in]  frame : frame data
+ * \param[in]  len   : frame length in bytes
+ *
+ * \return ERR_PARAM : Invalid parameters
+ * \return ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode frameSourceInitMem( frameSource *src, const uint8_t *frame, uint32_t len );
+
+/*!
+ *****************************************************************************
+ * \brief  Number of NFC-V blocks needed to carry the frame
+ *****************************************************************************
+ */
+uint16_t frameSourceBlockCount( const frameSource *src );
+
+/*!
+ *****************************************************************************
+ * \brief  Get one block of the frame
+ *
+ * \param[in]  src       : frame source
+ * \param[in]  blockNo   : absolute block number within the frame
+ * \param[out] blockData : set to FRAME_BLOCK_LEN bytes of block data, valid
+ *                         until the next call on the same source
+ *
+ * \return ERR_PARAM : Invalid parameters or block out of range
+ * \return ERR_BUSY  : Block not available yet, retry later (streaming sources)
+ * \return ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode frameSourceGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData );
+
+/*!
+ *****************************************************************************
+ * \brief  Hint that the transfer engine is idle and will ask for blockNo next
+ *
+ * Streaming sources use it to load the next slot while the tag is still
+ * busy with the current one. Memory sources ignore it.
+ *
+ * \param[in]  src     : frame source
+ * \param[in]  blockNo : next block to be requested
+ *****************************************************************************
+ */
+void frameSourcePrefetch( frameSource *src, uint16_t blockNo );
+
+/*!
+ *****************************************************************************
+ * \brief  CRC-32 (IEEE 802.3, as zlib) over the whole frame
+ *
+ * Reads every block once, so it needs a seekable source. The trailing
+ * partial block is covered up to the frame length only.
+ *
+ * \param[in]  src : frame source
+ * \param[out] crc : frame CRC
+ *
+ * \return ERR_WRONG_STATE : Source can't be read twice
+ * \return ERR_PARAM       : Invalid parameters
+ * \return ERR_NONE        : No error
+ *****************************************************************************
+ */
+ReturnCode frameSourceCrc32( frameSource *src, uint32_t *crc );
+
+/*!
+ *****************************************************************************
+ * \brief  Update a CRC-32 (IEEE 802.3) with len bytes of buf
+ *
+ * Start with 0xFFFFFFFF and invert the result, frameSourceCrc32() does both.
+ *****************************************************************************
+ */
+uint32_t frameSourceCrc32Update( uint32_t crc, const uint8_t *buf, uint32_t len );
+
+#endif /* FRAME_SOURCE_H */
@@ -0,0 +1,77 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Per tag record of the last delivered frame
+ *
+ *  The last frame that was completely delivered to a tag is kept in the
+ *  reader's flash together with the tag UID and the frame CRC-32. The
+ *  transfer engine compares a new frame against this record and only sends
+ *  the blocks that changed.
+ *
+ *  FRAME_STORE_RECORDS records of FRAME_STORE_RECORD_PAGES flash pages sit
+ *  at the top of the 128kB flash, with the calibration page of
+ *  calib_store.h below them; the Keil target's IROM1 size stops below both
+ *  so code never ends up there. When all records are in
+ *  use the least recently written one is replaced.
+ *
+ */
+
+#ifndef FRAME_STORE_H
+#define FRAME_STORE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_source.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define FRAME_STORE_BASE          0x0801B000U    /*!< First record, keep in sync with IROM1  */
+#define FRAME_STORE_RECORDS       4U             /*!< Tags remembered                        */
+#define FRAME_STORE_RECORD_PAGES  5U             /*!< 1kB pages per record: frame + header   */
+#define FRAME_STORE_UID_LEN       8U             /*!< NFC-V UID length                       */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Find the last frame delivered to a tag
+ *
+ * The record CRC is verified before the frame is returned.
+ *
+ * \param[in]  uid : tag UID, FRAME_STORE_UID_LEN bytes as received
+ * \param[out] crc : CRC-32 of the returned frame
+ *
+ * \return pointer to FRAME_LEN bytes in flash, NULL if the tag is unknown
+ *****************************************************************************
+ */
+const uint8_t *frameStoreLookup( const uint8_t *uid, uint32_t *crc );
+
+/*!
+ *****************************************************************************
+ * \brief  Remember the frame a tag has just received
+ *
+ * Blocks for the page erase and programming time (about 150ms).
+ *
+ * \param[in]  uid : tag UID, FRAME_STORE_UID_LEN bytes as received
+ * \param[in]  src : delivered frame, seekable and FRAME_LEN bytes long
+ * \param[in]  crc : CRC-32 of the frame as returned by frameSourceCrc32()
+ *
+ * \return ERR_PARAM : Invalid parameters or source
+ * \return ERR_WRITE : Flash erase or programming failed
+ * \return ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode frameStoreSave( const uint8_t *uid, frameSource *src, uint32_t crc );
+
+#endif /* FRAME_STORE_H */
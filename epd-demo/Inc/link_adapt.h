@@ -0,0 +1,83 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief RF output power adapted to the link quality
+ *
+ *  Every block write reports whether it needed a retry or failed, and the
+ *  RSSI of the tag's answer where the receiver provides one. Every
+ *  LINK_ADAPT_WINDOW writes these are condensed into a score that the RFAL
+ *  dynamic power module takes as its measurement:
+ *
+ *    errors, some answers weak      -> score >= LINK_ADAPT_RAISE, power up
+ *    errors, all answers strong     -> score <= LINK_ADAPT_LOWER, power down
+ *                                      (tag overcoupled, too close)
+ *    no errors, weakest RSSI strong -> score <= LINK_ADAPT_LOWER, power down
+ *    anything else                  -> hold
+ *
+ *  A failed write is decided on at once. Stepping down on a clean link
+ *  waits for LINK_ADAPT_HOLDOFF_MIN clean windows; each time such a step
+ *  had to be taken back, twice as many are needed before trying it again.
+ *  Without RSSI a run of clean windows alone counts as a strong link.
+ *  With several tags in the field the weakest answer decides.
+ *
+ */
+
+#ifndef LINK_ADAPT_H
+#define LINK_ADAPT_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define LINK_ADAPT_WINDOW         16U            /*!< Block writes per power decision           */
+#define LINK_ADAPT_RAISE          128U           /*!< Score from which the power is raised       */
+#define LINK_ADAPT_LOWER          32U            /*!< Score up to which the power is lowered     */
+#define LINK_ADAPT_RSSI_STRONG    500U           /*!< Answers this strong [mV] need less power   */
+#define LINK_ADAPT_HOLDOFF_MIN    2U             /*!< Clean windows before stepping down         */
+#define LINK_ADAPT_HOLDOFF_MAX    16U            /*!< Upper limit after repeated step backs      */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Start over at full power
+ *
+ * Loads the power table into the RFAL dynamic power module and enables it.
+ * Called before each transfer, the tags may sit farther away than the last
+ * ones.
+ *****************************************************************************
+ */
+void linkAdaptReset( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Account one block write
+ *
+ * \param[in]  retried : the first attempt failed
+ * \param[in]  err     : result of the last attempt
+ *****************************************************************************
+ */
+void linkAdaptBlock( bool retried, ReturnCode err );
+
+/*!
+ *****************************************************************************
+ * \brief  Current RFO driver setting, for reports
+ *****************************************************************************
+ */
+uint8_t linkAdaptGetRfo( void );
+
+#endif /* LINK_ADAPT_H */
@@ -0,0 +1,88 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame delivery as a standard NDEF image record
+ *
+ *  The private slot protocol (see demo_fleet.h) only works with this
+ *  reader. Here the frame is written as an NFC Forum Type 5 tag message
+ *  holding one MIME media record, which the tag firmware also accepts from
+ *  phones and any other NDEF writer:
+ *
+ *    NDEF_IMAGE_TYPE_PACKBITS : the frame PackBits compressed, used when it
+ *                               fits NDEF_IMAGE_PACK_LEN; a header n of
+ *                               0..127 is followed by n + 1 literal bytes,
+ *                               -1..-127 by one byte repeated 1 - n times
+ *    NDEF_IMAGE_TYPE_RAW      : the FRAME_LEN bytes as they are, for memory
+ *                               mapped frames on tags with room for them
+ *
+ *  The ST25DV04K only holds the compressed form. An unformatted tag, or one
+ *  whose CC was overwritten by a slot transfer, is formatted first.
+ *
+ */
+
+#ifndef NDEF_IMAGE_H
+#define NDEF_IMAGE_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+#include "rfal_nfc.h"
+#include "frame_source.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define NDEF_IMAGE_TYPE_RAW        "image/x-epd-1bpp"            /*!< Uncompressed frame, must match the tag firmware */
+#define NDEF_IMAGE_TYPE_PACKBITS   "image/x-epd-1bpp-packbits"   /*!< PackBits frame, must match the tag firmware     */
+#define NDEF_IMAGE_PACK_LEN        1024U                         /*!< Compressed frame buffer                         */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  PackBits compress a frame
+ *
+ * Runs of three or more equal bytes become run packets, everything else
+ * literal packets.
+ *
+ * \param[in]  src    : frame to compress, seekable
+ * \param[out] buf    : compressed frame
+ * \param[in]  bufLen : size of buf
+ * \param[out] outLen : compressed length
+ *
+ * \return ERR_WRONG_STATE : Source can't be read twice
+ * \return ERR_NOMEM       : Compressed frame larger than bufLen
+ * \return ERR_PARAM       : Invalid parameters
+ * \return ERR_NONE        : No error
+ *****************************************************************************
+ */
+ReturnCode ndefImagePack( frameSource *src, uint8_t *buf, uint32_t bufLen, uint32_t *outLen );
+
+/*!
+ *****************************************************************************
+ * \brief  Write a frame to an activated NFC-V tag as an NDEF image record
+ *
+ * \param[in]  dev : activated device
+ * \param[in]  src : frame to send, seekable and FRAME_LEN bytes long
+ *
+ * \return ERR_WRONG_STATE : Tag is read only, or source can't be read twice
+ * \return ERR_NOMEM       : Frame doesn't fit the tag in any form
+ * \return ERR_PARAM       : Invalid parameters
+ * \return ERR_NONE        : No error
+ * \return Other           : RF or NDEF error
+ *****************************************************************************
+ */
+ReturnCode ndefImageWrite( const rfalNfcDevice *dev, frameSource *src );
+
+#endif /* NDEF_IMAGE_H */
@@ -65,6 +65,7 @@
 #include "timer.h"
 #include "main.h"
 #include "logger.h"
+#include "calib_store.h"
 
 
 /*
@@ -142,6 +143,9 @@
 
 #define platformGetSysTick()                          HAL_GetTick()                                 /*!< Get System Tick ( 1 tick = 1 ms)            */
 
+#define platformCalibrationRestore()                  calibStoreRestore()                           /*!< Restore earlier ST25R3911 calibration results, true if valid */
+#define platformCalibrationSave()                     calibStoreSave()                              /*!< Keep the results of the calibration that just ran            */
+
 #define platformSpiSelect()                           platformGpioClear( ST25R391X_SS_PORT, ST25R391X_SS_PIN ) /*!< SPI SS\CS: Chip|Slave Select                */
 #define platformSpiDeselect()                         platformGpioSet( ST25R391X_SS_PORT, ST25R391X_SS_PIN )   /*!< SPI SS\CS: Chip|Slave Deselect              */
 #define platformSpiTxRx( txBuf, rxBuf, len )          spiTxRx( (txBuf), (rxBuf), (len) )            /*!< SPI transceive                              */
@@ -182,7 +186,8 @@ extern uint8_t globalCommProtectCnt;                      /* Global Protection C
 #define RFAL_FEATURE_ST25TB                    false       /*!< Enable/Disable RFAL support for ST25TB                                    */
 #define RFAL_FEATURE_ST25xV                    true       //CL/*!< Enable/Disable RFAL support for ST25TV/ST25DV                             */
 #define RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG     false      /*!< Enable/Disable Analog Configs to be dynamically updated (RAM)             */
-#define RFAL_FEATURE_DYNAMIC_POWER             false      /*!< Enable/Disable RFAL dynamic power support                                 */
+#define RFAL_FEATURE_DYNAMIC_POWER             true       /*!< Enable/Disable RFAL dynamic power support                                 */
+#define RFAL_FEATURE_DPO                       RFAL_FEATURE_DYNAMIC_POWER /*!< Switch name used by rfal_dpo.c                        */
 #define RFAL_FEATURE_ISO_DEP                   false       /*!< Enable/Disable RFAL support for ISO-DEP (ISO14443-4)                      */
 #define RFAL_FEATURE_ISO_DEP_POLL              false       /*!< Enable/Disable RFAL support for Poller mode (PCD) ISO-DEP (ISO14443-4)    */
 #define RFAL_FEATURE_ISO_DEP_LISTEN            false      /*!< Enable/Disable RFAL support for Listen mode (PICC) ISO-DEP (ISO14443-4)   */
@@ -0,0 +1,115 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief SD card driver in SPI mode on SPI2
+ *
+ *  Provides 512-byte sector access to an SD/SDHC card wired to SPI2
+ *  (PB13/PB14/PB15) with chip select on SD_CS. Data blocks are moved by
+ *  DMA1 channel 4 (SPI2_RX) and channel 5 (SPI2_TX); multi-sector
+ *  transfers use READ/WRITE_MULTIPLE_BLOCK so the card streams without
+ *  re-addressing every sector.
+ *
+ */
+
+#ifndef SD_SPI_H
+#define SD_SPI_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "st_errno.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define SD_SPI_SECTOR_LEN     512U    /*!< SD sector length in bytes                */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Initialize the SD card
+ *
+ * Runs the SPI mode power up sequence (CMD0, CMD8, ACMD41, CMD58) at
+ * identification clock speed and switches SPI2 to full speed afterwards.
+ *
+ * \return ERR_TIMEOUT : Card did not answer or did not leave idle state
+ * \return ERR_NOTSUPP : Card type not supported
+ * \return ERR_NONE    : No error
+ *****************************************************************************
+ */
+ReturnCode sdSpiInit( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Check whether the card has been initialized successfully
+ *****************************************************************************
+ */
+bool sdSpiIsReady( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Read sectors
+ *
+ * \param[out] buf    : destination, count * SD_SPI_SECTOR_LEN bytes
+ * \param[in]  sector : first sector (LBA)
+ * \param[in]  count  : number of sectors
+ *
+ * \return ERR_WRONG_STATE : Card not initialized
+ * \return ERR_TIMEOUT     : Card or DMA timeout
+ * \return ERR_IO          : Card returned an error
+ * \return ERR_NONE        : No error
+ *****************************************************************************
+ */
+ReturnCode sdSpiReadBlocks( uint8_t *buf, uint32_t sector, uint32_t count );
+
+/*!
+ *****************************************************************************
+ * \brief  Write sectors
+ *
+ * \param[in]  buf    : source, count * SD_SPI_SECTOR_LEN bytes
+ * \param[in]  sector : first sector (LBA)
+ * \param[in]  count  : number of sectors
+ *
+ * \return ERR_WRONG_STATE : Card not initialized
+ * \return ERR_TIMEOUT     : Card or DMA timeout
+ * \return ERR_IO          : Card rejected the data
+ * \return ERR_NONE        : No error
+ *****************************************************************************
+ */
+ReturnCode sdSpiWriteBlocks( const uint8_t *buf, uint32_t sector, uint32_t count );
+
+/*!
+ *****************************************************************************
+ * \brief  Wait until the card has finished any internal write
+ *
+ * \return ERR_TIMEOUT : Card still busy
+ * \return ERR_NONE    : No error
+ *****************************************************************************
+ */
+ReturnCode sdSpiSync( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Card capacity in sectors, read from the CSD register
+ *
+ * \param[out] sectors : number of sectors
+ *
+ * \return ERR_WRONG_STATE : Card not initialized
+ * \return ERR_IO          : CSD could not be read
+ * \return ERR_NONE        : No error
+ *****************************************************************************
+ */
+ReturnCode sdSpiGetSectorCount( uint32_t *sectors );
+
+#endif /* SD_SPI_H */
@@ -60,6 +60,10 @@ void EXTI0_IRQHandler(void);
 void EXTI2_IRQHandler(void);
 void TIM3_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA1_Channel4_IRQHandler(void);
+void DMA1_Channel5_IRQHandler(void);
+void DMA1_Channel6_IRQHandler(void);
+void USART2_IRQHandler(void);
 
 /* USER CODE END EFP */
 
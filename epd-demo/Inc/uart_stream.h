@@ -0,0 +1,130 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Host to reader image upload over USART2
+ *
+ *  USART2 RX runs into a circular DMA buffer; the IDLE line interrupt and
+ *  the DMA half/full events tell the parser that new bytes are pending.
+ *  Every packet carries a CRC and is answered with an ACK packet, the host
+ *  sends the next chunk only after the ACK (stop-and-wait).
+ *
+ *  Packet layout (multi-byte fields big endian, as on the NFC side):
+ *
+ *    | 0xA5 | 0x5A | type | seq | len (2) | payload (len) | crc (2) |
+ *
+ *  crc is CRC-16/MCRF4XX (rfalCrcCalculateCcitt, preload 0xFFFF) over
+ *  type..payload. Reader log output shares the TX line, the host skips
+ *  everything that does not start with the SOF pattern.
+ *
+ *  Received data lands in a ring of UART_STREAM_SLOTS slot buffers that is
+ *  exposed as a frame source. The transfer engine may start writing a tag
+ *  as soon as the first block arrived; chunks that do not fit yet are
+ *  answered with UART_STREAM_ST_BUSY and retried by the host, so upload
+ *  and RF transmission overlap.
+ *
+ *  The frame is read once, in order, and slots are refilled as soon as the
+ *  tag took them: it goes to a single tag, which can't ask for a slot again
+ *  (see demoFleetRun()). START only accepts a FRAME_LEN frame.
+ *
+ */
+
+#ifndef UART_STREAM_H
+#define UART_STREAM_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_source.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define UART_STREAM_SOF0            0xA5U   /*!< Start of frame, first byte               */
+#define UART_STREAM_SOF1            0x5AU   /*!< Start of frame, second byte              */
+
+#define UART_STREAM_PKT_START       0x01U   /*!< Host: new frame, payload FRAME_LEN (4)   */
+#define UART_STREAM_PKT_DATA        0x02U   /*!< Host: offset (2) + data                  */
+#define UART_STREAM_PKT_ACK         0x81U   /*!< Reader: status (1) + rxLen (2)           */
+
+#define UART_STREAM_ST_OK           0x00U   /*!< Packet accepted                          */
+#define UART_STREAM_ST_CRC          0x01U   /*!< CRC error, resend                        */
+#define UART_STREAM_ST_BUSY         0x02U   /*!< No room yet, resend later                */
+#define UART_STREAM_ST_SEQ          0x03U   /*!< Offset beyond received data, resend from rxLen */
+#define UART_STREAM_ST_PARAM        0x04U   /*!< Malformed packet or frame length         */
+#define UART_STREAM_ST_STATE        0x05U   /*!< DATA without a START                     */
+
+#define UART_STREAM_CHUNK_MAX       256U    /*!< Max data bytes per DATA packet           */
+#define UART_STREAM_SLOTS           2U      /*!< Slot buffers in the receive ring         */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! Events reported by uartStreamProcess() */
+typedef enum
+{
+    UART_STREAM_EVT_NONE,                   /*!< Nothing new                              */
+    UART_STREAM_EVT_START,                  /*!< Host started a new frame                 */
+    UART_STREAM_EVT_DATA                    /*!< Frame data received                      */
+} uartStreamEvt;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Start circular DMA reception and IDLE line detection on USART2
+ *****************************************************************************
+ */
+void uartStreamInit( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Parse pending bytes and answer complete packets
+ *
+ * Called from the main loop and from the frame source while the transfer
+ * engine waits for data.
+ *****************************************************************************
+ */
+uartStreamEvt uartStreamProcess( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Check whether an uploaded frame is still waiting to be sent
+ *****************************************************************************
+ */
+bool uartStreamActive( void );
+
+/*!
+ *****************************************************************************
+ * \brief  Initialize a frame source over the frame being uploaded
+ *
+ * getBlock returns ERR_BUSY while the block has not been received yet.
+ * The source is not seekable.
+ *
+ * \param[out] src : frame source to initialize
+ *
+ * \return ERR_PARAM : Invalid parameters
+ * \return ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode frameSourceInitUart( frameSource *src );
+
+/*!
+ *****************************************************************************
+ * \brief  USART2 IDLE line / DMA event notification, called from the ISRs
+ *****************************************************************************
+ */
+void uartStreamRxEvent( void );
+
+#endif /* UART_STREAM_H */
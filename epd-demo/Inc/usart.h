@@ -34,6 +34,7 @@ extern "C" {
 extern UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_usart2_rx;
 
 /* USER CODE END Private defines */
 
@@ -40,6 +40,12 @@
  *    <br>&nbsp; ndefMessageEncode()
  *    <br>&nbsp; ndefMessageDecode()
  *
+ * A message too large to be held in RAM can be decoded while it is being
+ * read with the streaming decoder:
+ *    <br>&nbsp; ndefMessageDecoderInit()
+ *    <br>&nbsp; ndefMessageDecoderFeed()
+ *    <br>&nbsp; ndefMessageDecoderEnd()
+ *
  * \addtogroup NDEF
  * @{
  *
@@ -91,6 +97,34 @@ struct ndefMessageStruct
 };
 
 
+/*! Streaming decoder callback, once the record header, type and ID are known. The payload buffer is NULL, its length is set */
+typedef ReturnCode (*ndefMessageDecoderRecordCb)(void* param, const ndefRecord* record);
+
+/*! Streaming decoder callback, for each payload slice at offset in the record payload. The slice points into the chunk being fed */
+typedef ReturnCode (*ndefMessageDecoderPayloadCb)(void* param, const ndefRecord* record, uint32_t offset, const ndefConstBuffer* bufSlice);
+
+
+/*! Streaming NDEF message decoder */
+typedef struct
+{
+    ndefRecord*                 recordArena;                   /*!< Caller's records, used in turn                    */
+    uint32_t                    recordArenaCount;              /*!< Number of records in the arena                    */
+    uint8_t*                    typeIdArena;                   /*!< Caller's storage for type and ID, one slot/record */
+    uint32_t                    typeIdSlotLen;                 /*!< Slot length for each record type and ID           */
+    ndefMessageDecoderRecordCb  recordCb;                      /*!< Record callback                                   */
+    ndefMessageDecoderPayloadCb payloadCb;                     /*!< Payload slice callback                            */
+    void*                       param;                         /*!< Callback parameter                                */
+    ndefRecord*                 record;                        /*!< Record being decoded                              */
+    uint32_t                    recordCount;                   /*!< Number of records started                         */
+    uint32_t                    length;                        /*!< Number of bytes fed                               */
+    uint32_t                    offset;                        /*!< Bytes received in the current record part         */
+    uint32_t                    partLength;                    /*!< Length of the current record part                 */
+    uint8_t                     state;                         /*!< Current record part                               */
+    bool                        lastRecord;                    /*!< Record with ME bit completed                      */
+    uint8_t                     header[NDEF_RECORD_HEADER_LEN];/*!< Record header being received                      */
+} ndefMessageDecoder;
+
+
 /*
  ******************************************************************************
  * GLOBAL FUNCTION PROTOTYPES
@@ -188,6 +222,62 @@ ReturnCode ndefMessageDecode(const ndefConstBuffer* bufPayload, ndefMessage* mes
 ReturnCode ndefMessageEncode(const ndefMessage* message, ndefBuffer* bufPayload);
 
 
+/*!
+ *****************************************************************************
+ * Initialize a streaming NDEF message decoder
+ *
+ * Records are decoded into the caller's record arena, the arena records being
+ * reused in turn so that a single one is enough for messages of any length.
+ * Record type and ID are copied to the typeIdArena, split evenly between the
+ * arena records. Payloads are never copied.
+ * The static record pool used by ndefMessageDecode() is left untouched.
+ *
+ * \param[out] decoder:     Decoder to initialize
+ * \param[in]  recordArena: Records to decode into
+ * \param[in]  recordCount: Number of records in recordArena
+ * \param[in]  typeIdArena: Storage for record type and ID
+ * \param[in]  recordCb:    Called once the record type and ID are received, may be NULL
+ * \param[in]  payloadCb:   Called for each payload slice, may be NULL
+ * \param[in]  param:       Parameter passed to the callbacks
+ *
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageDecoderInit(ndefMessageDecoder* decoder, ndefRecord* recordArena, uint32_t recordCount, const ndefBuffer* typeIdArena, ndefMessageDecoderRecordCb recordCb, ndefMessageDecoderPayloadCb payloadCb, void* param);
+
+
+/*!
+ *****************************************************************************
+ * Feed the next chunk of a raw NDEF message to a streaming decoder
+ *
+ * The chunk may be cut anywhere in the message. Callbacks are run from this
+ * function, payload slices pointing into bufChunk.
+ *
+ * \param[in,out] decoder:  Decoder
+ * \param[in]     bufChunk: Next message bytes
+ *
+ * \return ERR_PROTO if data follows the Message End record
+ * \return ERR_NOMEM if the record type and ID exceed their arena slot
+ * \return ERR_NONE if successful, a callback error code otherwise
+ *****************************************************************************
+ */
+ReturnCode ndefMessageDecoderFeed(ndefMessageDecoder* decoder, const ndefConstBuffer* bufChunk);
+
+
+/*!
+ *****************************************************************************
+ * Check that a streaming decoder has received a complete message
+ *
+ * \param[in]  decoder: Decoder
+ * \param[out] info:    Message length and number of records, may be NULL
+ *
+ * \return ERR_PROTO if the message stops before the end of its last record
+ * \return ERR_NONE if successful
+ *****************************************************************************
+ */
+ReturnCode ndefMessageDecoderEnd(const ndefMessageDecoder* decoder, ndefMessageInfo* info);
+
+
 #endif /* NDEF_MESSAGE_H */
 
 /**
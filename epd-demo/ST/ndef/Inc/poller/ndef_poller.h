@@ -41,6 +41,7 @@
  *    <br>&nbsp; ndefPollerContextInitialization()
  *    <br>&nbsp; ndefPollerNdefDetect()
  *    <br>&nbsp; ndefPollerReadRawMessage()
+ *    <br>&nbsp; ndefPollerDecodeRawMessage()
  *    <br>&nbsp; ndefPollerWriteRawMessage()
  *    <br>&nbsp; ndefPollerTagFormat()
  *    <br>&nbsp; ndefPollerWriteMessage()
@@ -278,6 +279,9 @@ typedef struct {
     ndefSystemInformation        sysInfo;                      /*!< System Information (when supported)                */
     bool                         sysInfoSupported;             /*!< System Information Supported flag                  */
     bool                         legacySTHighDensity;          /*!< Legacy ST High Density flag                        */
+    bool                         mbReadSupported;              /*!< (EXTENDED_)READ_MULTIPLE_BLOCKS usable for reads   */
+    bool                         fastReadSupported;            /*!< ST FAST_(EXTENDED_)READ_MULTIPLE_BLOCKS usable     */
+    bool                         mbWriteSupported;             /*!< (EXTENDED_)WRITE_MULTIPLE_BLOCKS usable for writes */
     uint8_t                      txrxBuf[NDEF_T5T_TxRx_BUFF_SIZE];  /*!< Tx Rx Buffer                                  */
 } ndefT5TContext;
 
@@ -320,6 +324,7 @@ typedef struct ndefPollerWrapperStruct
     ReturnCode (* pollerCheckAvailableSpace)(const ndefContext *ctx, uint32_t messageLen);                              /*!< CheckAvailableSpace function pointer                   */
     ReturnCode (* pollerBeginWriteMessage)(ndefContext *ctx, uint32_t messageLen);                                      /*!< BeginWriteMessage function pointer                     */
     ReturnCode (* pollerEndWriteMessage)(ndefContext *ctx, uint32_t messageLen);                                        /*!< EndWriteMessage function pointer                       */
+    ReturnCode (* pollerWriteMessage)(ndefContext *ctx, const ndefMessage *message);                                    /*!< WriteMessage function pointer (NULL: generic)          */
 #endif /* NDEF_FEATURE_ALL */
 } ndefPollerWrapper;
 
@@ -435,6 +440,30 @@ ReturnCode ndefPollerWriteBytes(ndefContext *ctx, uint32_t offset, const uint8_t
 ReturnCode ndefPollerReadRawMessage(ndefContext *ctx, uint8_t *buf, uint32_t bufLen, uint32_t *rcvdLen);
 
 
+/*!
+ *****************************************************************************
+ * \brief Read and decode NDEF message chunk by chunk
+ *
+ * This method reads the NDEF message bufLen bytes at a time and feeds each
+ * chunk to a streaming decoder, so that the message does not have to fit
+ * in RAM. Prior to NDEF Read procedure, a successful ndefPollerNdefDetect()
+ * has to be performed.
+ *
+ * \param[in]   ctx     : ndef Context
+ * \param[in]   decoder : decoder set up with ndefMessageDecoderInit()
+ * \param[in]   buf     : chunk buffer
+ * \param[in]   bufLen  : chunk buffer length
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_REQUEST      : read failed
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_PROTO        : Protocol error or malformed message
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode ndefPollerDecodeRawMessage(ndefContext *ctx, ndefMessageDecoder *decoder, uint8_t *buf, uint32_t bufLen);
+
+
 /*!
  *****************************************************************************
  * \brief Write raw NDEF message
@@ -405,6 +405,29 @@ ReturnCode ndefT5TPollerBeginWriteMessage(ndefContext *ctx, uint32_t messageLen)
 ReturnCode ndefT5TPollerEndWriteMessage(ndefContext *ctx, uint32_t messageLen);
 
 
+/*!
+ *****************************************************************************
+ * \brief T5T Write NDEF message
+ *
+ * This method encodes the records of message into a block sized staging
+ * buffer and writes whole blocks only, with Write Multiple Blocks when the
+ * tag supports it. No block is read back: the bytes in front of the NDEF
+ * TLV come from the CC and the space after the Terminator TLV is zeroed.
+ * As in the T5T write procedure the L-field is written as 0 first and set
+ * once the message is complete, so the block(s) holding it are written twice.
+ *
+ * \param[in]   ctx     : ndef Context
+ * \param[in]   message : message to write
+ *
+ * \return ERR_WRONG_STATE  : Library not initialized or mode not set
+ * \return ERR_REQUEST      : write failed
+ * \return ERR_PARAM        : Invalid parameter or not enough space
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode ndefT5TPollerWriteMessage(ndefContext *ctx, const ndefMessage *message);
+
+
 #endif /* NDEF_T5T_H */
 
 /**
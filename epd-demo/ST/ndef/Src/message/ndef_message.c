@@ -54,6 +54,10 @@
 
 #define NDEF_MAX_RECORD          10U    /*!< Maximum number of records */
 
+#define NDEF_DECODER_HEADER       0U    /*!< Streaming decoder receives the record header      */
+#define NDEF_DECODER_TYPE_ID      1U    /*!< Streaming decoder receives the record type and ID */
+#define NDEF_DECODER_PAYLOAD      2U    /*!< Streaming decoder receives the record payload     */
+
 /*
  ******************************************************************************
  * GLOBAL TYPES
@@ -75,6 +79,10 @@ static uint8_t ndefRecordPoolIndex = 0;
  ******************************************************************************
  */
 
+static ReturnCode ndefMessageDecoderHeader(ndefMessageDecoder* decoder);
+static ReturnCode ndefMessageDecoderTypeId(ndefMessageDecoder* decoder);
+static ReturnCode ndefMessageDecoderPayloadEnd(ndefMessageDecoder* decoder);
+
 
 /*****************************************************************************/
 static ndefRecord* ndefAllocRecord(void)
@@ -297,3 +305,250 @@ ReturnCode ndefMessageEncode(const ndefMessage* message, ndefBuffer* bufPayload)
     bufPayload->length = offset;
     return ERR_NONE;
 }
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageDecoderInit(ndefMessageDecoder* decoder, ndefRecord* recordArena, uint32_t recordCount, const ndefBuffer* typeIdArena, ndefMessageDecoderRecordCb recordCb, ndefMessageDecoderPayloadCb payloadCb, void* param)
+{
+    if ( (decoder == NULL) || (recordArena == NULL) || (recordCount == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    decoder->recordArena      = recordArena;
+    decoder->recordArenaCount = recordCount;
+    decoder->typeIdArena      = NULL;
+    decoder->typeIdSlotLen    = 0;
+    if ( (typeIdArena != NULL) && (typeIdArena->buffer != NULL) )
+    {
+        decoder->typeIdArena   = typeIdArena->buffer;
+        decoder->typeIdSlotLen = typeIdArena->length / recordCount;
+    }
+    decoder->recordCb    = recordCb;
+    decoder->payloadCb   = payloadCb;
+    decoder->param       = param;
+    decoder->record      = NULL;
+    decoder->recordCount = 0;
+    decoder->length      = 0;
+    decoder->offset      = 0;
+    decoder->partLength  = 0;
+    decoder->state       = NDEF_DECODER_HEADER;
+    decoder->lastRecord  = false;
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageDecoderFeed(ndefMessageDecoder* decoder, const ndefConstBuffer* bufChunk)
+{
+    ReturnCode      err;
+    ndefConstBuffer bufSlice;
+    uint32_t        offset;
+    uint32_t        length;
+    uint8_t*        typeId;
+
+    if ( (decoder == NULL) || (bufChunk == NULL) || ( (bufChunk->buffer == NULL) && (bufChunk->length != 0U) ) )
+    {
+        return ERR_PARAM;
+    }
+
+    offset = 0;
+    while (offset < bufChunk->length)
+    {
+        length = bufChunk->length - offset;
+
+        switch (decoder->state)
+        {
+            case NDEF_DECODER_HEADER:
+                if (decoder->offset == 0U)
+                {
+                    if (decoder->lastRecord)
+                    {
+                        /* Nothing may follow the Message End record */
+                        return ERR_PROTO;
+                    }
+                    /* The flags tell the header length: short record and ID length presence */
+                    decoder->header[0]  = bufChunk->buffer[offset];
+                    decoder->partLength = sizeof(uint8_t) + sizeof(uint8_t);
+                    decoder->partLength += ((decoder->header[0] & 0x10U) != 0U) ? sizeof(uint8_t) : sizeof(uint32_t);
+                    decoder->partLength += ((decoder->header[0] & 0x08U) != 0U) ? sizeof(uint8_t) : 0U;
+                    decoder->offset     = 1;
+                    length              = 1;
+                }
+                else
+                {
+                    length = MIN(length, decoder->partLength - decoder->offset);
+                    (void)ST_MEMCPY(&decoder->header[decoder->offset], &bufChunk->buffer[offset], length);
+                    decoder->offset += length;
+                }
+                err = ndefMessageDecoderHeader(decoder);
+                break;
+
+            case NDEF_DECODER_TYPE_ID:
+                length = MIN(length, decoder->partLength - decoder->offset);
+                typeId = &decoder->typeIdArena[decoder->typeIdSlotLen * ((decoder->recordCount - 1U) % decoder->recordArenaCount)];
+                (void)ST_MEMCPY(&typeId[decoder->offset], &bufChunk->buffer[offset], length);
+                decoder->offset += length;
+                err = ndefMessageDecoderTypeId(decoder);
+                break;
+
+            case NDEF_DECODER_PAYLOAD:
+                length = MIN(length, decoder->partLength - decoder->offset);
+                err    = ERR_NONE;
+                if (decoder->payloadCb != NULL)
+                {
+                    /* Zero copy: the slice points into the chunk */
+                    bufSlice.buffer = &bufChunk->buffer[offset];
+                    bufSlice.length = length;
+                    err = decoder->payloadCb(decoder->param, decoder->record, decoder->offset, &bufSlice);
+                }
+                decoder->offset += length;
+                if (err == ERR_NONE)
+                {
+                    err = ndefMessageDecoderPayloadEnd(decoder);
+                }
+                break;
+
+            default:
+                err = ERR_INTERNAL;
+                break;
+        }
+
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        offset          += length;
+        decoder->length += length;
+    }
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageDecoderEnd(const ndefMessageDecoder* decoder, ndefMessageInfo* info)
+{
+    if (decoder == NULL)
+    {
+        return ERR_PARAM;
+    }
+
+    if (info != NULL)
+    {
+        info->length      = decoder->length;
+        info->recordCount = decoder->recordCount;
+    }
+
+    /* Between two records */
+    if ( (decoder->state != NDEF_DECODER_HEADER) || (decoder->offset != 0U) )
+    {
+        return ERR_PROTO;
+    }
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+static ReturnCode ndefMessageDecoderHeader(ndefMessageDecoder* decoder)
+{
+    ndefRecord* record;
+    uint32_t    offset;
+
+    if (decoder->offset < decoder->partLength)
+    {
+        return ERR_NONE;
+    }
+
+    /* Header complete, same layout as ndefRecordDecode() */
+    record = &decoder->recordArena[decoder->recordCount % decoder->recordArenaCount];
+    if (ndefRecordReset(record) != ERR_NONE)
+    {
+        return ERR_INTERNAL;
+    }
+    decoder->record = record;
+    decoder->recordCount++;
+
+    offset             = 0;
+    record->header     = decoder->header[offset];
+    offset++;
+    record->typeLength = decoder->header[offset];
+    offset++;
+    if (ndefHeaderIsSetSR(record))
+    {
+        record->bufPayload.length = decoder->header[offset];
+        offset++;
+    }
+    else
+    {
+        record->bufPayload.length = GETU32(&decoder->header[offset]);
+        offset += sizeof(uint32_t);
+    }
+    record->idLength = ndefHeaderIsSetIL(record) ? decoder->header[offset] : 0U;
+    record->bufPayload.buffer = NULL;
+    record->next = NULL;
+
+    decoder->state      = NDEF_DECODER_TYPE_ID;
+    decoder->offset     = 0;
+    decoder->partLength = (uint32_t)record->typeLength + record->idLength;
+    if (decoder->partLength > decoder->typeIdSlotLen)
+    {
+        return ERR_NOMEM;
+    }
+
+    return ndefMessageDecoderTypeId(decoder);
+}
+
+
+/*****************************************************************************/
+static ReturnCode ndefMessageDecoderTypeId(ndefMessageDecoder* decoder)
+{
+    ReturnCode  err;
+    ndefRecord* record;
+    uint8_t*    typeId;
+
+    if (decoder->offset < decoder->partLength)
+    {
+        return ERR_NONE;
+    }
+
+    /* Type and ID complete, the record is known but for its payload */
+    record = decoder->record;
+    typeId = (decoder->partLength == 0U) ? NULL : &decoder->typeIdArena[decoder->typeIdSlotLen * ((decoder->recordCount - 1U) % decoder->recordArenaCount)];
+    record->type = (record->typeLength == 0U) ? NULL : typeId;
+    record->id   = (record->idLength   == 0U) ? NULL : &typeId[record->typeLength];
+
+    if (decoder->recordCb != NULL)
+    {
+        err = decoder->recordCb(decoder->param, record);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+    }
+
+    decoder->state      = NDEF_DECODER_PAYLOAD;
+    decoder->offset     = 0;
+    decoder->partLength = record->bufPayload.length;
+
+    return ndefMessageDecoderPayloadEnd(decoder);
+}
+
+
+/*****************************************************************************/
+static ReturnCode ndefMessageDecoderPayloadEnd(ndefMessageDecoder* decoder)
+{
+    if (decoder->offset < decoder->partLength)
+    {
+        return ERR_NONE;
+    }
+
+    decoder->lastRecord = (ndefHeaderME(decoder->record) == 1U) ? true : false;
+    decoder->state      = NDEF_DECODER_HEADER;
+    decoder->offset     = 0;
+    decoder->partLength = 0;
+
+    return ERR_NONE;
+}
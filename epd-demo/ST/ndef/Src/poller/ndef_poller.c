@@ -116,7 +116,8 @@ ReturnCode ndefPollerContextInitialization(ndefContext *ctx, const rfalNfcDevice
         NULL, /* ndefT1TPollerCheckPresence          */
         NULL, /* ndefT1TPollerCheckAvailableSpace    */
         NULL, /* ndefT1TPollerBeginWriteMessage      */
-        NULL  /* ndefT1TPollerEndWriteMessage        */
+        NULL, /* ndefT1TPollerEndWriteMessage        */
+        NULL  /* ndefT1TPollerWriteMessage           */
 #endif /* NDEF_FEATURE_ALL */
     };
 #endif /* RFAL_FEATURE_T1T */
@@ -136,7 +137,8 @@ ReturnCode ndefPollerContextInitialization(ndefContext *ctx, const rfalNfcDevice
         ndefT2TPollerCheckPresence,
         ndefT2TPollerCheckAvailableSpace,
         ndefT2TPollerBeginWriteMessage,
-        ndefT2TPollerEndWriteMessage
+        ndefT2TPollerEndWriteMessage,
+        NULL  /* generic record by record writer */
 #endif /* NDEF_FEATURE_ALL */
     };
 #endif /* RFAL_FEATURE_T2T */
@@ -156,7 +158,8 @@ ReturnCode ndefPollerContextInitialization(ndefContext *ctx, const rfalNfcDevice
         ndefT3TPollerCheckPresence,
         ndefT3TPollerCheckAvailableSpace,
         ndefT3TPollerBeginWriteMessage,
-        ndefT3TPollerEndWriteMessage
+        ndefT3TPollerEndWriteMessage,
+        NULL  /* generic record by record writer */
 #endif /* NDEF_FEATURE_ALL */
     };
 #endif /* RFAL_FEATURE_NFCF */
@@ -176,7 +179,8 @@ ReturnCode ndefPollerContextInitialization(ndefContext *ctx, const rfalNfcDevice
         ndefT4TPollerCheckPresence,
         ndefT4TPollerCheckAvailableSpace,
         ndefT4TPollerBeginWriteMessage,
-        ndefT4TPollerEndWriteMessage
+        ndefT4TPollerEndWriteMessage,
+        NULL  /* generic record by record writer */
 #endif /* NDEF_FEATURE_ALL */
     };
 #endif /* RFAL_FEATURE_T4T */
@@ -196,7 +200,8 @@ ReturnCode ndefPollerContextInitialization(ndefContext *ctx, const rfalNfcDevice
         ndefT5TPollerCheckPresence,
         ndefT5TPollerCheckAvailableSpace,
         ndefT5TPollerBeginWriteMessage,
-        ndefT5TPollerEndWriteMessage
+        ndefT5TPollerEndWriteMessage,
+        ndefT5TPollerWriteMessage
 #endif /* NDEF_FEATURE_ALL */
     };
 #endif /* RFAL_FEATURE_NFCV */
@@ -279,6 +284,48 @@ ReturnCode ndefPollerReadRawMessage(ndefContext *ctx, uint8_t *buf, uint32_t buf
     return (ctx->ndefPollWrapper->pollerReadRawMessage)(ctx, buf, bufLen, rcvdLen);
 }
 
+/*******************************************************************************/
+ReturnCode ndefPollerDecodeRawMessage(ndefContext *ctx, ndefMessageDecoder *decoder, uint8_t *buf, uint32_t bufLen)
+{
+    ReturnCode      ret;
+    ndefConstBuffer bufChunk;
+    uint32_t        offset;
+    uint32_t        rcvdLen;
+
+    if( (ctx == NULL) || (decoder == NULL) || (buf == NULL) || (bufLen == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( (ctx->state != NDEF_STATE_READWRITE) && (ctx->state != NDEF_STATE_READONLY) )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    for( offset = 0U; offset < ctx->messageLen; offset += rcvdLen )
+    {
+        ret = ndefPollerReadBytes(ctx, ctx->messageOffset + offset, MIN(bufLen, ctx->messageLen - offset), buf, &rcvdLen);
+        if( ret != ERR_NONE )
+        {
+            return ret;
+        }
+        if( rcvdLen == 0U )
+        {
+            return ERR_REQUEST;
+        }
+
+        bufChunk.buffer = buf;
+        bufChunk.length = rcvdLen;
+        ret = ndefMessageDecoderFeed(decoder, &bufChunk);
+        if( ret != ERR_NONE )
+        {
+            return ret;
+        }
+    }
+
+    return ndefMessageDecoderEnd(decoder, NULL);
+}
+
 /*******************************************************************************/
 ReturnCode ndefPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t len, uint8_t *buf, uint32_t *rcvdLen)
 {
@@ -447,6 +494,12 @@ ReturnCode ndefPollerWriteMessage(ndefContext *ctx, const ndefMessage* message)
         return ERR_WRONG_STATE;
     }
 
+    if ( (ctx->ndefPollWrapper != NULL) && (ctx->ndefPollWrapper->pollerWriteMessage != NULL) )
+    {
+        /* Tag specific writer, e.g. coalescing records into whole blocks */
+        return (ctx->ndefPollWrapper->pollerWriteMessage)(ctx, message);
+    }
+
     (void)ndefMessageGetInfo(message, &info);
 
     /* Verify length of the NDEF message */
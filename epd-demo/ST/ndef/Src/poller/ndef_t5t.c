@@ -76,6 +76,16 @@
 
 #define NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR       256U    /*!< Max number of blocks for 1 byte addressing        */
 #define NDEF_T5T_MAX_MLEN_1_BYTE_ENCODING    256U    /*!< MLEN max value for 1 byte encoding                */
+#define NDEF_T5T_MAX_BLOCKS_PER_READ         256U    /*!< Max number of blocks in one Read Multiple Blocks  */
+#define NDEF_T5T_MAX_DATA_PER_READ           256U    /*!< Max data in one response (RFAL NFC-V decoding)    */
+#define NDEF_T5T_RESP_OVERHEAD                 3U    /*!< Response flags + CRC around the block data        */
+#define NDEF_T5T_READ_RETRIES                  1U    /*!< Retries of a multiple block read that got no answer */
+#define NDEF_T5T_MAX_BLOCKS_PER_WRITE          4U    /*!< Max number of blocks in one Write Multiple Blocks */
+#define NDEF_T5T_WR_MUL_OVERHEAD  (5U + RFAL_NFCV_UID_LEN) /*!< Flags, cmd, UID, BNo and NBo of Write Multiple  */
+
+#define NDEF_T5T_STAGE_LEN    (NDEF_T5T_MAX_BLOCKS_PER_WRITE \
+                              * RFAL_NFCV_MAX_BLOCK_LEN) /*!< Staging buffer of the message writer             */
+#define NDEF_T5T_HEAD_LEN   (2U * RFAL_NFCV_MAX_BLOCK_LEN) /*!< TLV T and L-field span at most 2 blocks         */
 
 #define NDEF_T5T_TL_MAX_SIZE  (NDEF_T5T_TLV_T_LEN \
                        + NDEF_T5T_TLV_L_3_BYTES_LEN) /*!< Max TL size                                       */
@@ -91,6 +101,19 @@
  ******************************************************************************
  */
 
+#if NDEF_FEATURE_ALL
+/*! Block aligned staging buffer of ndefT5TPollerWriteMessage() */
+typedef struct {
+    ndefContext *            ctx;                              /*!< ndef Context                                       */
+    uint16_t                 firstBlock;                       /*!< Block holding the TLV T-field                      */
+    uint16_t                 headBlock;                        /*!< Block holding the end of the TLV L-field           */
+    uint16_t                 block;                            /*!< Block of buf[0]                                    */
+    uint16_t                 len;                              /*!< Bytes staged in buf                                */
+    uint8_t                  head[NDEF_T5T_HEAD_LEN];          /*!< firstBlock..headBlock as first written             */
+    uint8_t                  buf[NDEF_T5T_STAGE_LEN];          /*!< Staged bytes                                       */
+} ndefT5TStage;
+#endif /* NDEF_FEATURE_ALL */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -112,12 +135,19 @@
  */
 
 static ReturnCode ndefT5TPollerReadSingleBlock(ndefContext *ctx, uint16_t blockNum, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+static ReturnCode ndefT5TPollerFastReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+static ReturnCode ndefT5TPollerReadBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t nbBlocks, uint8_t *rxBuf, uint16_t rxBufLen);
+static bool       ndefT5TPollerCmdRefused(ReturnCode ret, const uint8_t *rxBuf, uint16_t rcvLen);
+static uint16_t   ndefT5TPollerMaxBlocks(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t bufLen);
 static ReturnCode ndefT5TGetSystemInformation(ndefContext *ctx, bool extended);
 
 #if NDEF_FEATURE_ALL
 static ReturnCode ndefT5TWriteCC(ndefContext *ctx);
 static ReturnCode ndefT5TPollerWriteSingleBlock(ndefContext *ctx, uint16_t blockNum, const uint8_t* wrData);
-static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+static ReturnCode ndefT5TPollerWriteBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t nbBlocks, const uint8_t* wrData);
+static ReturnCode ndefT5TStagePut(ndefT5TStage *stage, const uint8_t *data, uint32_t len);
+static ReturnCode ndefT5TStageFlush(ndefT5TStage *stage);
 #endif /* NDEF_FEATURE_ALL */
 
 /*
@@ -130,12 +160,12 @@ static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t fir
 ReturnCode ndefT5TPollerReadBytes(ndefContext * ctx, uint32_t offset, uint32_t len, uint8_t* buf, uint32_t * rcvdLen )
 {
     uint8_t         lastVal;
-    uint8_t         status;
-    uint16_t        res;
+    uint16_t        nbBlocks;
     uint16_t        nbRead;
     uint16_t        blockLen;
     uint16_t        startBlock;
-    uint16_t        startAddr;
+    uint16_t        skip;
+    ReturnCode      res;
     ReturnCode      result     = ERR_PARAM;
     uint32_t        currentLen = len;
     uint32_t        lvRcvLen   = 0U;
@@ -148,62 +178,47 @@ ReturnCode ndefT5TPollerReadBytes(ndefContext * ctx, uint32_t offset, uint32_t l
             return ERR_SYSTEM;
         }
         startBlock = (uint16_t) (offset / blockLen);
-        startAddr  = (uint16_t) (startBlock * blockLen);
+        skip       = (uint16_t) (offset - ((uint32_t)startBlock * blockLen));
 
-        res = ndefT5TPollerReadSingleBlock(ctx, startBlock, ctx->subCtx.t5t.txrxBuf, blockLen + 3U, &nbRead);
-        if ( (res == ERR_NONE) && (ctx->subCtx.t5t.txrxBuf[0U] == 0U) && (nbRead > 0U) )
+        while (currentLen > 0U)
         {
-            nbRead = (uint16_t) (nbRead  + startAddr - (uint16_t)offset - 1U );
-            if ((uint32_t) nbRead > currentLen)
-            {
-                nbRead = (uint16_t) currentLen;
-            }
-            if (nbRead > 0U)
-            {
-                (void)ST_MEMCPY(buf, &ctx->subCtx.t5t.txrxBuf[1U - startAddr + (uint16_t)offset], (uint32_t)nbRead);
-            }
-            lvRcvLen   += (uint32_t) nbRead;
-            currentLen -= (uint32_t) nbRead;
-            while (currentLen >= ((uint32_t)blockLen + 2U) )
+            if ( (lvRcvLen > 0U) && (currentLen >= ((uint32_t)blockLen + 2U)) )
             {
-                startBlock++;
-                lastVal = buf[lvRcvLen - 1U];
-                res = ndefT5TPollerReadSingleBlock(ctx, startBlock, &buf[lvRcvLen - 1U], blockLen + 3U, &nbRead);
-                status  = buf[lvRcvLen - 1U]; /* Keep status */
+                /* Read in place: the response flags overwrite the last byte already received, the CRC lands in the space still to be filled */
+                nbBlocks = ndefT5TPollerMaxBlocks(ctx, startBlock, currentLen - 2U);
+                lastVal  = buf[lvRcvLen - 1U];
+                res      = ndefT5TPollerReadBlocks(ctx, startBlock, nbBlocks, &buf[lvRcvLen - 1U], (uint16_t)((nbBlocks * blockLen) + NDEF_T5T_RESP_OVERHEAD));
                 buf[lvRcvLen - 1U] = lastVal; /* Restore previous value */
-                if ( (res == ERR_NONE) && (nbRead > 0U) && (status == 0U))
-                {
-                    lvRcvLen   += blockLen;
-                    currentLen -= blockLen;
-                }
-                else
+                if (res != ERR_NONE)
                 {
                     break;
                 }
+                nbRead = (uint16_t) (nbBlocks * blockLen);
             }
-            while (currentLen > 0U)
+            else
             {
-                startBlock++;
-                res = ndefT5TPollerReadSingleBlock(ctx, startBlock, ctx->subCtx.t5t.txrxBuf, blockLen + 3U, &nbRead);
-                if ( (res == ERR_NONE) && (ctx->subCtx.t5t.txrxBuf[0U] == 0U) && (nbRead > 0U))
+                /* Unaligned start or short tail: through the working buffer */
+                nbBlocks = ndefT5TPollerMaxBlocks(ctx, startBlock, (uint32_t)sizeof(ctx->subCtx.t5t.txrxBuf) - NDEF_T5T_RESP_OVERHEAD);
+                if ( ((uint32_t)nbBlocks * blockLen) > (currentLen + skip) )
                 {
-                    -- nbRead; /* remove status char */
-                    if (nbRead > currentLen)
-                    {
-                        nbRead = (uint16_t)currentLen;
-                    }
-                    if (nbRead > 0U)
-                    {
-                        (void)ST_MEMCPY(&buf[lvRcvLen], & ctx->subCtx.t5t.txrxBuf[1U], nbRead);
-                    }
-                    lvRcvLen   += nbRead;
-                    currentLen -= nbRead;
+                    nbBlocks = (uint16_t) (((currentLen + skip) + blockLen - 1U) / blockLen);
                 }
-                else
+                res = ndefT5TPollerReadBlocks(ctx, startBlock, nbBlocks, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf));
+                if (res != ERR_NONE)
                 {
                     break;
                 }
+                nbRead = (uint16_t) ((nbBlocks * blockLen) - skip);
+                if ((uint32_t) nbRead > currentLen)
+                {
+                    nbRead = (uint16_t) currentLen;
+                }
+                (void)ST_MEMCPY(&buf[lvRcvLen], &ctx->subCtx.t5t.txrxBuf[1U + skip], (uint32_t)nbRead);
+                skip = 0U;
             }
+            startBlock += nbBlocks;
+            lvRcvLen   += (uint32_t) nbRead;
+            currentLen -= (uint32_t) nbRead;
         }
     }
     if (currentLen == 0U)
@@ -283,6 +298,18 @@ ReturnCode ndefT5TPollerContextInitialization(ndefContext *ctx, const rfalNfcDev
             ctx->subCtx.t5t.sysInfoSupported = true;
         }
     }
+
+    /* Multiple block reads by default, ST fast ones on ST tags. A tag listing its commands is trusted, others are found out by ndefT5TPollerReadBlocks() */
+    ctx->subCtx.t5t.mbReadSupported   = true;
+    ctx->subCtx.t5t.fastReadSupported = (ctx->device.dev.nfcv.InvRes.UID[NDEF_T5T_UID_MANUFACTURER_ID_POS] == NDEF_T5T_MANUFACTURER_ID_ST);
+    if( ctx->subCtx.t5t.sysInfoSupported && (ndefT5TSysInfoCmdListPresent(ctx->subCtx.t5t.sysInfo.infoFlags) != 0U) )
+    {
+        ctx->subCtx.t5t.mbReadSupported   = (ndefT5TSysInfoReadMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) != 0U);
+        ctx->subCtx.t5t.fastReadSupported = ctx->subCtx.t5t.fastReadSupported && (ndefT5TSysInfoFastReadMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) != 0U);
+    }
+    /* Writes are not probed: multiple block writes only when listed */
+    ctx->subCtx.t5t.mbWriteSupported = ctx->subCtx.t5t.sysInfoSupported && (ndefT5TSysInfoCmdListPresent(ctx->subCtx.t5t.sysInfo.infoFlags) != 0U) &&
+                                       (ndefT5TSysInfoWriteMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) != 0U);
     return result;
 }
 
@@ -961,6 +988,150 @@ ReturnCode ndefT5TPollerEndWriteMessage(ndefContext *ctx, uint32_t messageLen)
     return ERR_NONE;
 }
 
+/*******************************************************************************/
+ReturnCode ndefT5TPollerWriteMessage(ndefContext *ctx, const ndefMessage *message)
+{
+    ReturnCode      result;
+    ndefT5TStage    stage;
+    ndefMessageInfo info;
+    ndefRecord*     record;
+    uint8_t         recordHeaderBuf[NDEF_RECORD_HEADER_LEN];
+    ndefBuffer      bufHeader;
+    ndefConstBuffer bufPayloadItem;
+    bool            firstPayloadItem;
+    uint8_t         TLV[NDEF_T5T_TL_MAX_SIZE];
+    uint32_t        lLen;
+    uint32_t        blockLen;
+    uint32_t        startAddr;
+    uint32_t        headPos;
+    uint32_t        rcvdLen;
+
+    if( (ctx == NULL) || !ndefT5TisT5TDevice(&ctx->device) || (message == NULL) || (ctx->subCtx.t5t.blockLen == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( (ctx->state != NDEF_STATE_INITIALIZED) && (ctx->state != NDEF_STATE_READWRITE) )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    (void)ndefMessageGetInfo(message, &info);
+
+    /* TS T5T v1.0 7.5.3.3: verify available space */
+    if( ndefT5TPollerCheckAvailableSpace(ctx, info.length) != ERR_NONE )
+    {
+        return ERR_PARAM;
+    }
+
+    if( info.length == 0U )
+    {
+        /* Empty NDEF TLV and Terminator TLV */
+        return ndefT5TPollerBeginWriteMessage(ctx, 0U);
+    }
+
+    blockLen         = ctx->subCtx.t5t.blockLen;
+    lLen             = ( info.length > NDEF_SHORT_VFIELD_MAX_LEN) ? NDEF_T5T_TLV_L_3_BYTES_LEN : NDEF_T5T_TLV_L_1_BYTES_LEN;
+    stage.ctx        = ctx;
+    stage.firstBlock = (uint16_t)(ctx->subCtx.t5t.TlvNDEFOffset / blockLen);
+    stage.headBlock  = (uint16_t)((ctx->subCtx.t5t.TlvNDEFOffset + NDEF_T5T_TLV_T_LEN + lLen - 1U) / blockLen);
+    stage.block      = stage.firstBlock;
+    stage.len        = 0U;
+    startAddr        = (uint32_t)stage.firstBlock * blockLen;
+    headPos          = ctx->subCtx.t5t.TlvNDEFOffset - startAddr;
+
+    /* Bytes in front of the NDEF TLV: the CC tail, or whatever TLVs precede it */
+    if( headPos > 0U )
+    {
+        if( ctx->subCtx.t5t.TlvNDEFOffset <= ctx->cc.t5t.ccLen )
+        {
+            (void)ST_MEMCPY(stage.buf, &ctx->ccBuf[startAddr], headPos);
+        }
+        else
+        {
+            result = ndefT5TPollerReadBytes(ctx, startAddr, headPos, stage.buf, &rcvdLen);
+            if( result != ERR_NONE )
+            {
+                return result;
+            }
+        }
+        stage.len = (uint16_t)headPos;
+    }
+
+    /* TS T5T v1.0 7.5.3.4: L-Field is 0 until the message is complete, as ndefT5TPollerBeginWriteMessage() leaves it */
+    TLV[0U] = NDEF_T5T_TLV_NDEF;
+    TLV[1U] = 0U;
+    TLV[2U] = NDEF_TERMINATOR_TLV_T;
+    TLV[3U] = 0U;
+    ctx->messageOffset = ctx->subCtx.t5t.TlvNDEFOffset + NDEF_T5T_TLV_T_LEN + lLen;
+    ctx->state         = NDEF_STATE_INITIALIZED;
+    result = ndefT5TStagePut(&stage, TLV, NDEF_T5T_TLV_T_LEN + lLen);
+
+    /* TS T5T v1.0 7.5.3.5: records, the Terminator TLV, then zeros up to the block end */
+    record = ndefMessageGetFirstRecord(message);
+    while( (record != NULL) && (result == ERR_NONE) )
+    {
+        bufHeader.buffer = recordHeaderBuf;
+        bufHeader.length = sizeof(recordHeaderBuf);
+        (void)ndefRecordEncodeHeader(record, &bufHeader);
+        result = ndefT5TStagePut(&stage, bufHeader.buffer, bufHeader.length);
+        if( (result == ERR_NONE) && (record->typeLength != 0U) )
+        {
+            result = ndefT5TStagePut(&stage, record->type, record->typeLength);
+        }
+        if( (result == ERR_NONE) && (record->idLength != 0U) )
+        {
+            result = ndefT5TStagePut(&stage, record->id, record->idLength);
+        }
+        firstPayloadItem = true;
+        while( (result == ERR_NONE) && (ndefRecordGetPayloadItem(record, &bufPayloadItem, firstPayloadItem) != NULL) )
+        {
+            firstPayloadItem = false;
+            result = ndefT5TStagePut(&stage, bufPayloadItem.buffer, bufPayloadItem.length);
+        }
+        record = ndefMessageGetNextRecord(record);
+    }
+    if( result == ERR_NONE )
+    {
+        result = ndefT5TStagePut(&stage, &TLV[2U], NDEF_T5T_TLV_T_LEN);
+    }
+    while( (result == ERR_NONE) && ((stage.len % blockLen) != 0U) )
+    {
+        result = ndefT5TStagePut(&stage, &TLV[3U], 1U);
+    }
+    if( (result == ERR_NONE) && (stage.len != 0U) )
+    {
+        result = ndefT5TStageFlush(&stage);
+    }
+
+    /* TS T5T v1.0 7.5.3.6: update L-Field */
+    if( result == ERR_NONE )
+    {
+        headPos++;
+        if( lLen == NDEF_T5T_TLV_L_1_BYTES_LEN )
+        {
+            stage.head[headPos] = (uint8_t) info.length;
+        }
+        else
+        {
+            stage.head[headPos]      = (uint8_t) 0xFFU;
+            stage.head[headPos + 1U] = (uint8_t) (info.length >> 8U);
+            stage.head[headPos + 2U] = (uint8_t) info.length;
+        }
+        result = ndefT5TPollerWriteBlocks(ctx, stage.firstBlock, (uint16_t)(stage.headBlock - stage.firstBlock + 1U), stage.head);
+    }
+
+    if( result != ERR_NONE )
+    {
+        /* Conclude procedure */
+        ctx->state = NDEF_STATE_INVALID;
+        return result;
+    }
+    ctx->messageLen = info.length;
+    ctx->state      = NDEF_STATE_READWRITE;
+    return ERR_NONE;
+}
+
 /*******************************************************************************/
 static ReturnCode ndefT5TPollerWriteSingleBlock(ndefContext *ctx, uint16_t blockNum, const uint8_t* wrData)
 {
@@ -993,6 +1164,116 @@ static ReturnCode ndefT5TPollerWriteSingleBlock(ndefContext *ctx, uint16_t block
     return ret;
 }
 
+/*******************************************************************************/
+static ReturnCode ndefT5TPollerWriteBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t nbBlocks, const uint8_t* wrData)
+{
+    ReturnCode                ret;
+    uint8_t                   txBuf[NDEF_T5T_STAGE_LEN + NDEF_T5T_WR_MUL_OVERHEAD];
+    uint16_t                  blockLen;
+    uint16_t                  nbWrite;
+
+    if( (ctx == NULL) || !ndefT5TisT5TDevice(&ctx->device) || (wrData == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    blockLen = (uint16_t)ctx->subCtx.t5t.blockLen;
+    while( nbBlocks > 0U )
+    {
+        nbWrite = 1U;
+        /* Special frames need the EOF the multiple block write does not send */
+        if( ctx->subCtx.t5t.mbWriteSupported && !ctx->subCtx.t5t.legacySTHighDensity && !ctx->cc.t5t.specialFrame )
+        {
+            nbWrite = (uint16_t)MIN(nbBlocks, MIN(NDEF_T5T_MAX_BLOCKS_PER_WRITE, NDEF_T5T_STAGE_LEN / blockLen));
+            if( firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR )
+            {
+                nbWrite = (uint16_t)MIN(nbWrite, NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR - firstBlockNum);
+            }
+        }
+
+        if( nbWrite > 1U )
+        {
+            if( firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR )
+            {
+                ret = rfalNfcvPollerWriteMultipleBlocks((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, ctx->subCtx.t5t.pAddressedUid, (uint8_t)firstBlockNum, (uint8_t)nbWrite, txBuf, (uint16_t)sizeof(txBuf), (uint8_t)blockLen, wrData, (uint16_t)(nbWrite * blockLen));
+            }
+            else
+            {
+                ret = rfalNfcvPollerExtendedWriteMultipleBlocks((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, ctx->subCtx.t5t.pAddressedUid, firstBlockNum, nbWrite, txBuf, (uint16_t)sizeof(txBuf), (uint8_t)blockLen, wrData, (uint16_t)(nbWrite * blockLen));
+            }
+            if( ret != ERR_NONE )
+            {
+                /* Write the same blocks again one by one, and so on from now */
+                ctx->subCtx.t5t.mbWriteSupported = false;
+                continue;
+            }
+        }
+        else
+        {
+            ret = ndefT5TPollerWriteSingleBlock(ctx, firstBlockNum, wrData);
+            if( ret != ERR_NONE )
+            {
+                return ret;
+            }
+        }
+        firstBlockNum += nbWrite;
+        nbBlocks      -= nbWrite;
+        wrData         = &wrData[nbWrite * blockLen];
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefT5TStagePut(ndefT5TStage *stage, const uint8_t *data, uint32_t len)
+{
+    ReturnCode                ret;
+    uint32_t                  stageLen;
+    uint32_t                  nbPut;
+
+    /* Whole blocks only */
+    stageLen = ((uint32_t)NDEF_T5T_STAGE_LEN / stage->ctx->subCtx.t5t.blockLen) * stage->ctx->subCtx.t5t.blockLen;
+    while( len > 0U )
+    {
+        nbPut = MIN(len, stageLen - stage->len);
+        (void)ST_MEMCPY(&stage->buf[stage->len], data, nbPut);
+        stage->len = (uint16_t)(stage->len + nbPut);
+        data       = &data[nbPut];
+        len       -= nbPut;
+        if( stage->len == stageLen )
+        {
+            ret = ndefT5TStageFlush(stage);
+            if( ret != ERR_NONE )
+            {
+                return ret;
+            }
+        }
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefT5TStageFlush(ndefT5TStage *stage)
+{
+    uint16_t                  blockLen;
+    uint16_t                  nbBlocks;
+    uint16_t                  block;
+
+    blockLen = (uint16_t)stage->ctx->subCtx.t5t.blockLen;
+    nbBlocks = stage->len / blockLen;
+
+    /* Keep the blocks holding the L-field for its final update */
+    for( block = stage->block; (block <= stage->headBlock) && (block < (stage->block + nbBlocks)); block++ )
+    {
+        (void)ST_MEMCPY(&stage->head[(block - stage->firstBlock) * blockLen], &stage->buf[(block - stage->block) * blockLen], blockLen);
+    }
+
+    stage->len    = 0U;
+    stage->block += nbBlocks;
+    return ndefT5TPollerWriteBlocks(stage->ctx, (uint16_t)(stage->block - nbBlocks), nbBlocks, stage->buf);
+}
+
+#endif /* NDEF_FEATURE_ALL */
+
 /*******************************************************************************/
 static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen)
 {
@@ -1023,7 +1304,142 @@ static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t fir
     return ret;
 }
 
-#endif /* NDEF_FEATURE_ALL */
+/*******************************************************************************/
+static ReturnCode ndefT5TPollerFastReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen)
+{
+    ReturnCode                ret;
+
+    if( (ctx == NULL) || !ndefT5TisT5TDevice(&ctx->device) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( ctx->subCtx.t5t.legacySTHighDensity )
+    {
+
+        ret = rfalST25xVPollerM24LRFastReadMultipleBlocks((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, ctx->subCtx.t5t.pAddressedUid, firstBlockNum, numOfBlocks, rxBuf, rxBufLen, rcvLen);
+    }
+    else
+    {
+        if( firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR )
+        {
+            ret = rfalST25xVPollerFastReadMultipleBlocks((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, ctx->subCtx.t5t.pAddressedUid, (uint8_t)firstBlockNum, numOfBlocks, rxBuf, rxBufLen, rcvLen);
+        }
+        else
+        {
+            ret = rfalST25xVPollerFastExtReadMultipleBlocks((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, ctx->subCtx.t5t.pAddressedUid, firstBlockNum, numOfBlocks, rxBuf, rxBufLen, rcvLen);
+        }
+    }
+
+    return ret;
+}
+
+/*******************************************************************************/
+static bool ndefT5TPollerCmdRefused(ReturnCode ret, const uint8_t *rxBuf, uint16_t rcvLen)
+{
+    /* Only an ISO15693 error response tells the tag lacks the command, a timeout or CRC error does not */
+    if( ret == ERR_NOTSUPP )
+    {
+        return true;
+    }
+    return ( (ret == ERR_PROTO) && (rcvLen >= 2U) && ((rxBuf[0U] & (uint8_t)RFAL_NFCV_RES_FLAG_ERROR) != 0U) &&
+             (rxBuf[1U] == (uint8_t)RFAL_NFCV_ERROR_CMD_NOT_RECOGNIZED) );
+}
+
+/*******************************************************************************/
+static ReturnCode ndefT5TPollerReadBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t nbBlocks, uint8_t *rxBuf, uint16_t rxBufLen)
+{
+    ReturnCode                ret;
+    uint16_t                  rcvLen;
+    uint16_t                  expLen;
+    uint16_t                  rxIt;
+    uint8_t                   lastVal;
+    uint8_t                   status;
+    uint8_t                   retry;
+
+    if( (ctx == NULL) || (nbBlocks == 0U) || (nbBlocks > NDEF_T5T_MAX_BLOCKS_PER_READ) )
+    {
+        return ERR_PARAM;
+    }
+    expLen = (uint16_t)((nbBlocks * (uint16_t)ctx->subCtx.t5t.blockLen) + 1U);
+
+    /* Fast, then standard multiple, then single block reads. A variant the tag refuses is not tried again on
+     * this tag; one that failed on the link is retried and only skipped for this read                        */
+    for( retry = 0U; ctx->subCtx.t5t.fastReadSupported && (nbBlocks > 1U) && (retry <= NDEF_T5T_READ_RETRIES); retry++ )
+    {
+        rcvLen = 0U;
+        ret    = ndefT5TPollerFastReadMultipleBlocks(ctx, firstBlockNum, (uint8_t)(nbBlocks - 1U), rxBuf, rxBufLen, &rcvLen);
+        if( (ret == ERR_NONE) && (rcvLen == expLen) && (rxBuf[0U] == 0U) )
+        {
+            return ERR_NONE;
+        }
+        if( ndefT5TPollerCmdRefused(ret, rxBuf, rcvLen) )
+        {
+            ctx->subCtx.t5t.fastReadSupported = false;
+        }
+    }
+    for( retry = 0U; ctx->subCtx.t5t.mbReadSupported && (nbBlocks > 1U) && (retry <= NDEF_T5T_READ_RETRIES); retry++ )
+    {
+        rcvLen = 0U;
+        ret    = ndefT5TPollerReadMultipleBlocks(ctx, firstBlockNum, (uint8_t)(nbBlocks - 1U), rxBuf, rxBufLen, &rcvLen);
+        if( (ret == ERR_NONE) && (rcvLen == expLen) && (rxBuf[0U] == 0U) )
+        {
+            return ERR_NONE;
+        }
+        if( ndefT5TPollerCmdRefused(ret, rxBuf, rcvLen) )
+        {
+            ctx->subCtx.t5t.mbReadSupported = false;
+        }
+    }
+
+    /* Single blocks, each response flags byte landing on the last byte of the previous block */
+    rxIt = 0U;
+    while( nbBlocks > 0U )
+    {
+        lastVal = rxBuf[rxIt];
+        ret     = ndefT5TPollerReadSingleBlock(ctx, firstBlockNum, &rxBuf[rxIt], (uint16_t)ctx->subCtx.t5t.blockLen + NDEF_T5T_RESP_OVERHEAD, &rcvLen);
+        status  = rxBuf[rxIt];     /* Keep status */
+        if( rxIt > 0U )
+        {
+            rxBuf[rxIt] = lastVal; /* Restore previous value */
+        }
+        if( ret != ERR_NONE )
+        {
+            return ret;
+        }
+        if( (rcvLen != ((uint16_t)ctx->subCtx.t5t.blockLen + 1U)) || (status != 0U) )
+        {
+            return ERR_REQUEST;
+        }
+        firstBlockNum++;
+        nbBlocks--;
+        rxIt = (uint16_t)(rxIt + ctx->subCtx.t5t.blockLen);
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static uint16_t ndefT5TPollerMaxBlocks(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t bufLen)
+{
+    uint32_t                  nbBlocks;
+    uint32_t                  blockLen;
+
+    blockLen = ctx->subCtx.t5t.blockLen;
+    nbBlocks = MIN(bufLen, NDEF_T5T_MAX_DATA_PER_READ) / blockLen;
+    nbBlocks = MIN(nbBlocks, NDEF_T5T_MAX_BLOCKS_PER_READ);
+
+    /* 1 byte block addresses cannot run past block 255 */
+    if( (firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR) && (!ctx->subCtx.t5t.legacySTHighDensity) )
+    {
+        nbBlocks = MIN(nbBlocks, (uint32_t)NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR - firstBlockNum);
+    }
+    /* Nor past the end of the tag memory */
+    if( ctx->subCtx.t5t.sysInfoSupported && (ndefT5TSysInfoMemSizePresent(ctx->subCtx.t5t.sysInfo.infoFlags) != 0U) && (ctx->subCtx.t5t.sysInfo.numberOfBlock > firstBlockNum) )
+    {
+        nbBlocks = MIN(nbBlocks, (uint32_t)ctx->subCtx.t5t.sysInfo.numberOfBlock - firstBlockNum);
+    }
+    return (uint16_t)MAX(nbBlocks, 1U);
+}
 
 /*******************************************************************************/
 static ReturnCode ndefT5TPollerReadSingleBlock(ndefContext *ctx, uint16_t blockNum, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen)
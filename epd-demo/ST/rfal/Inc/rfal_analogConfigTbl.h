@@ -43,6 +43,7 @@
  ******************************************************************************
  */
 #include "rfal_analogConfig.h"
+#include "rfal_features.h"
 #include "st25r3911_com.h"
 
 /*
@@ -223,6 +224,7 @@
                       , ST25R3911_REG_FIELD_THRESHOLD,        ST25R3911_REG_FIELD_THRESHOLD_mask_rfe, ST25R3911_REG_FIELD_THRESHOLD_rfe_75mV
                       )
                       
+#if RFAL_SUPPORT_MODE_POLL_NFCA
       //****** Default Analog Configuration for Poll NFC-A Tx. ******/
     , MODE_ENTRY_1_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                       , ST25R3911_REG_RFO_AM_ON_LEVEL, 0xff, 0xf0 /* Used for 848 TX: very high AM to keep wave shapes */
@@ -268,6 +270,9 @@
                       , ST25R3911_REG_RX_CONF1, 0x7f, 0x22
                       )
 
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCA */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCB
       //****** Default Analog Configuration for Poll NFC-B Tx. ******/
     , MODE_ENTRY_2_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                       , ST25R3911_REG_AUX,                    ST25R3911_REG_AUX_tr_am, ST25R3911_REG_AUX_tr_am   /* AM */
@@ -305,6 +310,9 @@
                       , ST25R3911_REG_RX_CONF1,               0x7f, 0x6c
                       )
                       
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCB */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCF
       //****** Default Analog Configuration for Poll NFC-F Tx. ******/
     , MODE_ENTRY_2_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                       , ST25R3911_REG_AUX,                    ST25R3911_REG_AUX_tr_am, ST25R3911_REG_AUX_tr_am /* AM */
@@ -326,6 +334,9 @@
                       , ST25R3911_REG_RX_CONF1,               0x7f, 0x0b   /* dev. from data sheet: lp 600kHz */
                       )
                       
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCF */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCV
     //****** Default Analog Configuration for Poll NFC-V Common bitrate Tx ******/
     , MODE_ENTRY_1_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                       , ST25R3911_REG_AUX, ST25R3911_REG_AUX_tr_am, 0x00
@@ -339,6 +350,9 @@
                       , ST25R3911_REG_AUX,                    ST25R3911_REG_AUX_rx_tol, ST25R3911_REG_AUX_rx_tol                           /* rx_tol On as default */
                       )
 
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCV */
+
+#if RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P
       //****** Default Analog Configuration for Poll AP2P Common bitrate Tx. ******/
     , MODE_ENTRY_1_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                       , ST25R3911_REG_RFO_AM_ON_LEVEL,        0xff, AM_MOD_DRIVER_LEVEL_DEFAULT /* Fixed driver for AM level: ~14% */
@@ -358,14 +372,19 @@
                       , ST25R3911_REG_RFO_AM_ON_LEVEL,        0xff, AM_MOD_DRIVER_LEVEL_DEFAULT /* Fixed driver for AM level: ~14% */
                       )
 
-      //****** Default Analog Configuration for Poll AP2P Common bitrate Rx. ******/
-      
+#endif /* RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P */
+
+#if RFAL_FEATURE_LISTEN_MODE
     , MODE_ENTRY_4_REG( (RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_ON)
                       , ST25R3911_REG_RX_CONF1,               0x7f, 0x45
                       , ST25R3911_REG_RX_CONF3,              (ST25R3911_REG_RX_CONF3_lim | ST25R3911_REG_RX_CONF3_rg_nfc), (ST25R3911_REG_RX_CONF3_lim | ST25R3911_REG_RX_CONF3_rg_nfc)
                       , ST25R3911_REG_AUX,                    ST25R3911_REG_AUX_rx_tol, ST25R3911_REG_AUX_rx_tol                            /* rx_tol On as default */
                       , ST25R3911_REG_RX_CONF4,               ST25R3911_REG_RX_CONF4_mask_rg2_am, 0x1U<<ST25R3911_REG_RX_CONF4_shift_rg2_am /* increase digitizer window for AM */
                       )
+#endif /* RFAL_FEATURE_LISTEN_MODE */
+
+#if RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P
+      //****** Default Analog Configuration for Poll AP2P Common bitrate Rx. ******/
                       
     , MODE_ENTRY_4_REG( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX)
                       , ST25R3911_REG_RX_CONF1,               0x7f, 0x45
@@ -386,6 +405,9 @@
                       , ST25R3911_REG_RX_CONF3,               ST25R3911_REG_RX_CONF3_mask_rg1_am, 0x00
                       )
 
+#endif /* RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P */
+
+#if RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P
       //****** Default Analog Configuration for Listen AP2P Common bitrate Tx. ******/
       , MODE_ENTRY_1_REG( (RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX)
                         , ST25R3911_REG_RFO_AM_ON_LEVEL,        0xff, AM_MOD_DRIVER_LEVEL_DEFAULT /* Fixed driver for AM level: ~14% */
@@ -421,6 +443,7 @@
       , MODE_ENTRY_1_REG( (RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_424 | RFAL_ANALOG_CONFIG_RX)
                         , ST25R3911_REG_RX_CONF3,               ST25R3911_REG_RX_CONF3_mask_rg1_am, 0x00
                         )
+#endif /* RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P */
 };
 
 #endif /* ST25R3911_ANALOGCONFIG_H */
@@ -51,15 +51,24 @@
 ******************************************************************************
 */
 
-#define RFAL_SUPPORT_MODE_POLL_NFCA                true          /*!< RFAL Poll NFCA mode support switch    */
-#define RFAL_SUPPORT_MODE_POLL_NFCB                true          /*!< RFAL Poll NFCB mode support switch    */    
-#define RFAL_SUPPORT_MODE_POLL_NFCF                true          /*!< RFAL Poll NFCF mode support switch    */
-#define RFAL_SUPPORT_MODE_POLL_NFCV                true          /*!< RFAL Poll NFCV mode support switch    */
-#define RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P          true          /*!< RFAL Poll AP2P mode support switch    */
-#define RFAL_SUPPORT_MODE_LISTEN_NFCA              false         /*!< RFAL Listen NFCA mode support switch  */
-#define RFAL_SUPPORT_MODE_LISTEN_NFCB              false         /*!< RFAL Listen NFCB mode support switch  */
-#define RFAL_SUPPORT_MODE_LISTEN_NFCF              false         /*!< RFAL Listen NFCF mode support switch  */
-#define RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P        true          /*!< RFAL Listen AP2P mode support switch  */
+/* Mode switches follow the RFAL_FEATURE_* selection in platform.h, so that a
+ * reader built for fewer technologies also drops their analog configuration
+ * entries and rfalSetMode()/rfalSetBitRate() branches.
+ * rfalNfcWorker() only loses the listen sleep transition, its other states
+ * are kept. Gains were measured as host -Os object sizes only; flash size,
+ * per command dispatch time and boot time on the STM32 were not measured.  */
+#define RFAL_SUPPORT_MODE_POLL_NFCA                ( RFAL_FEATURE_NFCA )                                /*!< RFAL Poll NFCA mode support switch    */
+#define RFAL_SUPPORT_MODE_POLL_NFCB                ( RFAL_FEATURE_NFCB )                                /*!< RFAL Poll NFCB mode support switch    */
+#define RFAL_SUPPORT_MODE_POLL_NFCF                ( RFAL_FEATURE_NFCF )                                /*!< RFAL Poll NFCF mode support switch    */
+#define RFAL_SUPPORT_MODE_POLL_NFCV                ( RFAL_FEATURE_NFCV )                                /*!< RFAL Poll NFCV mode support switch    */
+#define RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P          ( RFAL_FEATURE_NFC_DEP )                             /*!< RFAL Poll AP2P mode support switch    */
+#define RFAL_SUPPORT_MODE_LISTEN_NFCA              false                                                /*!< RFAL Listen NFCA mode support switch  */
+#define RFAL_SUPPORT_MODE_LISTEN_NFCB              false                                                /*!< RFAL Listen NFCB mode support switch  */
+#define RFAL_SUPPORT_MODE_LISTEN_NFCF              false                                                /*!< RFAL Listen NFCF mode support switch  */
+#define RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P        ( RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_LISTEN_MODE ) /*!< RFAL Listen AP2P mode support switch  */
+
+/*! Only NFC-V is polled: every mode check against it folds to a constant */
+#define RFAL_SUPPORT_MODE_NFCV_ONLY                ( RFAL_SUPPORT_MODE_POLL_NFCV && !RFAL_SUPPORT_MODE_POLL_NFCA && !RFAL_SUPPORT_MODE_POLL_NFCB && !RFAL_SUPPORT_MODE_POLL_NFCF && !RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P && !RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P )
 
 /*******************************************************************************/
 /*! RFAL supported Card Emulation (CE)        */
@@ -152,7 +152,7 @@
 #define rfalGetMaxBrCEF()                    ( ((RFAL_SUPPORT_BR_CE_F_424) ? RFAL_BR_424  : RFAL_BR_212 ) )
 
 
-#define rfalIsModeActiveComm( md )           ( ((md) == RFAL_MODE_POLL_ACTIVE_P2P) || ((md) == RFAL_MODE_LISTEN_ACTIVE_P2P) )                          /*!< Checks if mode md is Active Communication  */
+#define rfalIsModeActiveComm( md )           ( (RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P || RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P) && (((md) == RFAL_MODE_POLL_ACTIVE_P2P) || ((md) == RFAL_MODE_LISTEN_ACTIVE_P2P)) ) /*!< Checks if mode md is Active Communication, false on builds without AP2P */
 #define rfalIsModePassiveComm( md )          ( !rfalIsModeActiveComm(md) )                                                                             /*!< Checks if mode md is Passive Communication */
 #define rfalIsModePassiveListen( md )        ( ((md) == RFAL_MODE_LISTEN_NFCA) || ((md) == RFAL_MODE_LISTEN_NFCB) || ((md) == RFAL_MODE_LISTEN_NFCF) ) /*!< Checks if mode md is Passive Listen        */
 #define rfalIsModePassivePoll( md )          ( rfalIsModePassiveComm(md) && !rfalIsModePassiveListen(md) )                                             /*!< Checks if mode md is Passive Poll          */
@@ -1111,10 +1111,11 @@ bool rfalIsTransceiveInRx( void );
  * \brief  Get Transceive RSSI
  *  
  * Gets the RSSI value of the last executed Transceive in mV
+ * With automatic channel selection the stronger of the AM and PM channels
+ * is returned
  *
  * \param[out]  rssi : RSSI value
  *
- * \return  ERR_NOTSUPP : Feature not supported
  * \return  ERR_PARAM   : Invalid parameter
  * \return  ERR_NONE    : No error
  *****************************************************************************
@@ -425,11 +425,13 @@ void rfalNfcWorker( void )
                 gNfcDev.state = RFAL_NFC_STATE_DATAEXCHANGE_DONE;                     /* Go to done state               */
                 rfalNfcNfcNotify( gNfcDev.state );                                    /* And notify caller              */
             }
+        #if RFAL_FEATURE_LISTEN_MODE
             if( gNfcDev.dataExErr == ERR_SLEEP_REQ )                                  /* Check if Listen mode has to go to Sleep */
             {
                 gNfcDev.state = RFAL_NFC_STATE_LISTEN_SLEEP;                          /* Go to Listen Sleep state       */
                 rfalNfcNfcNotify( gNfcDev.state );                                    /* And notify caller              */
             }
+        #endif /* RFAL_FEATURE_LISTEN_MODE */
             break;
             
             
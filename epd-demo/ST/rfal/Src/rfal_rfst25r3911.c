@@ -341,6 +341,12 @@ typedef enum
 
 #define rfalCalcNumBytes( nBits )                (((uint32_t)(nBits) + 7U) / 8U)                          /*!< Returns the number of bytes required to fit given the number of bits */
 
+#if RFAL_SUPPORT_MODE_NFCV_ONLY
+#define rfalIsModeNfcvComm( md )                 true                                                      /*!< NFC-V only build: any mode set is NFC-V or PicoPass         */
+#else
+#define rfalIsModeNfcvComm( md )                 ( ((md) == RFAL_MODE_POLL_NFCV) || ((md) == RFAL_MODE_POLL_PICOPASS) ) /*!< Checks if mode md uses the NFC-V stream coding */
+#endif
+
 #define rfalTimerStart( timer, time_ms )         (timer) = platformTimerCreate((uint16_t)(time_ms))       /*!< Configures and starts the RTOX timer          */
 #define rfalTimerisExpired( timer )              platformTimerIsExpired( timer )                          /*!< Checks if timer has expired                   */
 
@@ -479,8 +485,17 @@ ReturnCode rfalInitialize( void )
     
     /*******************************************************************************/    
     /* Perform Automatic Calibration (if configured to do so).                     *
-     * Registers set by rfalSetAnalogConfig will tell rfalCalibrate what to perform*/
+     * Registers set by rfalSetAnalogConfig will tell rfalCalibrate what to perform*
+     * The platform may restore the results of an earlier calibration instead      */
+#if defined(platformCalibrationRestore) && defined(platformCalibrationSave)
+    if( !platformCalibrationRestore() )
+    {
+        rfalCalibrate();
+        platformCalibrationSave();
+    }
+#else
     rfalCalibrate();
+#endif /* platformCalibrationRestore */
     
     return ERR_NONE;
 }
@@ -631,6 +646,7 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
    
     switch( mode )
     {
+#if RFAL_SUPPORT_MODE_POLL_NFCA
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCA:
             
@@ -658,6 +674,9 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCA */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCB
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCB:
             
@@ -733,6 +752,9 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCB */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCF
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCF:
             
@@ -747,6 +769,9 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
         
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCF */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCV
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCV:
         case RFAL_MODE_POLL_PICOPASS:
@@ -759,6 +784,9 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
 
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCV */
+
+#if RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P
         /*******************************************************************************/
         case RFAL_MODE_POLL_ACTIVE_P2P:
             
@@ -777,6 +805,9 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
         
+#endif /* RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P */
+
+#if RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P
         /*******************************************************************************/
         case RFAL_MODE_LISTEN_ACTIVE_P2P:
 
@@ -795,6 +826,8 @@ ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P */
+
         /*******************************************************************************/
         case RFAL_MODE_LISTEN_NFCA:
         case RFAL_MODE_LISTEN_NFCB:
@@ -838,7 +871,7 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
     gRFAL.rxBR = ((rxBR == RFAL_BR_KEEP) ? gRFAL.rxBR : rxBR);
     
     /* Update the bitrate reg if not in NFCV mode (streaming) */
-    if( (RFAL_MODE_POLL_NFCV != gRFAL.mode) && (RFAL_MODE_POLL_PICOPASS != gRFAL.mode) )
+    if( !rfalIsModeNfcvComm( gRFAL.mode ) )
     {
         EXIT_ON_ERR( ret, st25r3911SetBitrate( (uint8_t)gRFAL.txBR, (uint8_t)gRFAL.rxBR ) );
     }
@@ -846,6 +879,7 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
     
     switch( gRFAL.mode )
     {
+#if RFAL_SUPPORT_MODE_POLL_NFCA
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCA:
         case RFAL_MODE_POLL_NFCA_T1T:
@@ -856,6 +890,9 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX ) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCA */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCB
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCB:
         case RFAL_MODE_POLL_B_PRIME:
@@ -867,6 +904,9 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX ) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCB */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCF
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCF:
             
@@ -876,6 +916,9 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX ) );
             break;
         
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCF */
+
+#if RFAL_SUPPORT_MODE_POLL_NFCV
         /*******************************************************************************/
         case RFAL_MODE_POLL_NFCV:
         case RFAL_MODE_POLL_PICOPASS:
@@ -931,6 +974,9 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             #endif /* RFAL_FEATURE_NFCV */
                 
         
+#endif /* RFAL_SUPPORT_MODE_POLL_NFCV */
+
+#if RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P
         /*******************************************************************************/
         case RFAL_MODE_POLL_ACTIVE_P2P:
             
@@ -940,6 +986,9 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX ) );
             break;
         
+#endif /* RFAL_SUPPORT_MODE_POLL_ACTIVE_P2P */
+
+#if RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P
         /*******************************************************************************/
         case RFAL_MODE_LISTEN_ACTIVE_P2P:
             
@@ -949,6 +998,8 @@ ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
             rfalSetAnalogConfig( (rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX ) );
             break;
             
+#endif /* RFAL_SUPPORT_MODE_LISTEN_ACTIVE_P2P */
+
         /*******************************************************************************/
         case RFAL_MODE_LISTEN_NFCA:
         case RFAL_MODE_LISTEN_NFCB:
@@ -1204,7 +1255,7 @@ ReturnCode rfalStartTransceive( const rfalTransceiveContext *ctx )
         
     #if RFAL_FEATURE_NFCV        
         /*******************************************************************************/
-        if( (RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode) )
+        if( rfalIsModeNfcvComm( gRFAL.mode ) )
         { /* Exchange receive buffer with internal buffer */
             gRFAL.nfcvData.origCtx = gRFAL.TxRx.ctx;
 
@@ -1380,18 +1431,19 @@ ReturnCode rfalGetTransceiveRSSI( uint16_t *rssi )
         return ERR_PARAM;
     }
     
+    st25r3911GetRSSI( &amRSSI, &pmRSSI );
+    
     /* Check if Manual channel is enabled */
     if( st25r3911CheckReg( ST25R3911_REG_OP_CONTROL, ST25R3911_REG_OP_CONTROL_rx_man, ST25R3911_REG_OP_CONTROL_rx_man ) )
     {
-        st25r3911GetRSSI( &amRSSI, &pmRSSI );
-        
         /* Check which channel is selected */
         *rssi = ( st25r3911CheckReg( ST25R3911_REG_RX_CONF1, ST25R3911_REG_RX_CONF1_ch_sel, ST25R3911_REG_RX_CONF1_ch_sel ) ? pmRSSI : amRSSI );
         return ERR_NONE;
     }
     
-    *rssi = 0;
-    return ERR_NOTSUPP;
+    /* Automatic channel selection decodes the stronger channel */
+    *rssi = MAX( amRSSI, pmRSSI );
+    return ERR_NONE;
 }
 
 
@@ -1730,7 +1782,7 @@ static void rfalTransceiveTx( void )
         #if RFAL_FEATURE_NFCV
             /*******************************************************************************/
             /* In NFC-V streaming mode, the FIFO needs to be loaded with the coded bits    */
-            if( (RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode) )
+            if( rfalIsModeNfcvComm( gRFAL.mode ) )
             {
             #if 0
                 /* Debugging code: output the payload bits by writing into the FIFO and subsequent clearing */
@@ -1817,7 +1869,7 @@ static void rfalTransceiveTx( void )
         #if RFAL_FEATURE_NFCV
             /*******************************************************************************/
             /* In NFC-V streaming mode, the FIFO needs to be loaded with the coded bits    */
-            if( (RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode) )
+            if( rfalIsModeNfcvComm( gRFAL.mode ) )
             {
                 uint16_t maxLen;
                                 
@@ -2248,7 +2300,7 @@ static void rfalTransceiveRx( void )
         #if RFAL_FEATURE_NFCV
             /*******************************************************************************/
             /* Decode sub bit stream into payload bits for NFCV, if no error found so far  */
-            if( ((RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode)) && (gRFAL.TxRx.status == ERR_BUSY) )
+            if( rfalIsModeNfcvComm( gRFAL.mode ) && (gRFAL.TxRx.status == ERR_BUSY) )
             {
                 ReturnCode ret;
                 uint16_t offset = 0;
@@ -0,0 +1,87 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Startup time profiler
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "boot_profile.h"
+#include "platform.h"
+#include <stdio.h>
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! One startup step */
+typedef struct
+{
+    const char *name;                               /*!< Step name                                */
+    uint32_t    cycles;                             /*!< Cycle counter at the end of the step     */
+} bootProfileEntry;
+
+/*
+******************************************************************************
+* LOCAL MACROS
+******************************************************************************
+*/
+#define bootProfileCyclesToUs( c )  ((uint32_t)((c) / (SystemCoreClock / 1000000U)))
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+static bootProfileEntry bootProfileMarks[BOOT_PROFILE_MARKS];
+static uint8_t          bootProfileCnt;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void bootProfileStart( void )
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0U;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    bootProfileCnt = 0U;
+}
+
+/*******************************************************************************/
+void bootProfileMark( const char *name )
+{
+    if( bootProfileCnt < BOOT_PROFILE_MARKS )
+    {
+        bootProfileMarks[bootProfileCnt].name   = name;
+        bootProfileMarks[bootProfileCnt].cycles = DWT->CYCCNT;
+        bootProfileCnt++;
+    }
+}
+
+/*******************************************************************************/
+void bootProfilePrint( void )
+{
+    uint32_t prev;
+    uint8_t  i;
+
+    prev = 0U;
+    for( i = 0U; i < bootProfileCnt; i++ )
+    {
+        printf( "Boot %-16s %8lu us  +%lu us\r\n", bootProfileMarks[i].name,
+                (unsigned long)bootProfileCyclesToUs( bootProfileMarks[i].cycles ),
+                (unsigned long)bootProfileCyclesToUs( bootProfileMarks[i].cycles - prev ) );
+        prev = bootProfileMarks[i].cycles;
+    }
+}
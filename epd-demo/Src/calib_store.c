@@ -0,0 +1,228 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief ST25R3911 calibration results kept across resets
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "calib_store.h"
+#include "boot_profile.h"
+#include "frame_source.h"
+#include "rfal_rf.h"
+#include "rfal_chip.h"
+#include "st25r3911_com.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define CALIB_STORE_MAGIC         0x43414C31U    /*!< "CAL1": record complete                   */
+#define CALIB_STORE_TRI_SHIFT     4U             /*!< tri<3:0> position in the result register  */
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! Calibration results and the measurements they were taken with */
+typedef struct
+{
+    uint8_t reg;                                    /*!< Regulator setting, rege<3:0> encoding    */
+    uint8_t trim;                                   /*!< Antenna trim, tre<3:0> encoding          */
+    uint8_t vdd;                                    /*!< Supply voltage                           */
+    uint8_t amp;                                    /*!< Antenna amplitude with the field on      */
+    uint8_t phase;                                  /*!< Antenna phase with the field on          */
+    uint8_t rfu[3];                                 /*!< Pads the record to whole words           */
+} calibStoreData;
+
+/*! Flash record, the magic word is programmed last */
+typedef struct
+{
+    uint32_t       magic;                           /*!< CALIB_STORE_MAGIC once complete          */
+    uint32_t       crc;                             /*!< CRC-32 of data                           */
+    calibStoreData data;
+} calibStoreRecord;
+
+/*
+******************************************************************************
+* LOCAL MACROS
+******************************************************************************
+*/
+#define calibStoreRec()           ((const calibStoreRecord*)CALIB_STORE_ADDR)
+#define calibStoreDiff( a, b )    ((uint8_t)(((a) > (b)) ? ((a) - (b)) : ((b) - (a))))
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static bool calibStoreMeasure( calibStoreData *data );
+static bool calibStoreIsManual( void );
+static ReturnCode calibStoreProgram( uint32_t addr, const uint8_t *data );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static bool calibStoreMeasure( calibStoreData *data )
+{
+    ReturnCode err;
+
+    rfalChipMeasurePowerSupply( ST25R3911_REG_REGULATOR_CONTROL_mpsv_vdd, &data->vdd );
+
+    /* Fails with an external field present, the antenna can't be judged then */
+    err = rfalFieldOnAndStartGT();
+    if( err == ERR_NONE )
+    {
+        rfalChipMeasureAmplitude( &data->amp );
+        rfalChipMeasurePhase( &data->phase );
+    }
+    rfalFieldOff();
+
+    return (err == ERR_NONE);
+}
+
+/*******************************************************************************/
+static bool calibStoreIsManual( void )
+{
+    uint8_t regCtrl;
+    uint8_t antCtrl;
+
+    rfalChipReadReg( ST25R3911_REG_REGULATOR_CONTROL, &regCtrl, 1U );
+    rfalChipReadReg( ST25R3911_REG_ANT_CAL_CONTROL, &antCtrl, 1U );
+
+    return (((regCtrl & ST25R3911_REG_REGULATOR_CONTROL_reg_s) != 0U) || ((antCtrl & ST25R3911_REG_ANT_CAL_CONTROL_trim_s) != 0U));
+}
+
+/*******************************************************************************/
+static ReturnCode calibStoreProgram( uint32_t addr, const uint8_t *data )
+{
+    uint32_t word;
+
+    word = ((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+
+    return ((HAL_FLASH_Program( FLASH_TYPEPROGRAM_WORD, addr, word ) == HAL_OK) ? ERR_NONE : ERR_WRITE);
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+bool calibStoreRestore( void )
+{
+    const calibStoreRecord *rec;
+    calibStoreData          now;
+
+    rec = calibStoreRec();
+    if( (rec->magic != CALIB_STORE_MAGIC) || (~frameSourceCrc32Update( 0xFFFFFFFFU, (const uint8_t*)&rec->data, sizeof(rec->data) ) != rec->crc) )
+    {
+        return false;
+    }
+
+    /* Manual settings from the analog configuration take precedence */
+    if( calibStoreIsManual() )
+    {
+        return false;
+    }
+
+    rfalChipChangeRegBits( ST25R3911_REG_REGULATOR_CONTROL, (ST25R3911_REG_REGULATOR_CONTROL_reg_s | ST25R3911_REG_REGULATOR_CONTROL_mask_rege),
+                           (uint8_t)(ST25R3911_REG_REGULATOR_CONTROL_reg_s | (rec->data.reg << ST25R3911_REG_REGULATOR_CONTROL_shift_rege)) );
+    rfalChipChangeRegBits( ST25R3911_REG_ANT_CAL_CONTROL, (ST25R3911_REG_ANT_CAL_CONTROL_trim_s | ST25R3911_REG_ANT_CAL_CONTROL_mask_tre),
+                           (uint8_t)(ST25R3911_REG_ANT_CAL_CONTROL_trim_s | (rec->data.trim << ST25R3911_REG_ANT_CAL_CONTROL_shift_tre)) );
+
+    if( calibStoreMeasure( &now )                                                 &&
+        (calibStoreDiff( now.vdd, rec->data.vdd )     <= CALIB_STORE_VDD_DRIFT)   &&
+        (calibStoreDiff( now.amp, rec->data.amp )     <= CALIB_STORE_AMP_DRIFT)   &&
+        (calibStoreDiff( now.phase, rec->data.phase ) <= CALIB_STORE_PHASE_DRIFT)    )
+    {
+        bootProfileMark( "rf cal restored" );
+        return true;
+    }
+
+    /* Drifted: back to automatic so that rfalCalibrate() measures again */
+    rfalChipChangeRegBits( ST25R3911_REG_REGULATOR_CONTROL, ST25R3911_REG_REGULATOR_CONTROL_reg_s, 0x00U );
+    rfalChipChangeRegBits( ST25R3911_REG_ANT_CAL_CONTROL, ST25R3911_REG_ANT_CAL_CONTROL_trim_s, 0x00U );
+
+    bootProfileMark( "rf cal drifted" );
+    return false;
+}
+
+/*******************************************************************************/
+void calibStoreSave( void )
+{
+    FLASH_EraseInitTypeDef  erase;
+    const calibStoreRecord *rec;
+    calibStoreRecord        newRec;
+    uint32_t                pageErr;
+    uint8_t                 regRes;
+    uint8_t                 antRes;
+    uint8_t                 i;
+    ReturnCode              err;
+
+    bootProfileMark( "rf cal full" );
+
+    if( calibStoreIsManual() )
+    {
+        return;
+    }
+
+    rfalChipReadReg( ST25R3911_REG_REGULATOR_RESULT, &regRes, 1U );
+    rfalChipReadReg( ST25R3911_REG_ANT_CAL_RESULT, &antRes, 1U );
+    if( (antRes & ST25R3911_REG_ANT_CAL_RESULT_tri_err) != 0U )
+    {
+        return;
+    }
+
+    ST_MEMSET( &newRec, 0x00, sizeof(newRec) );
+    newRec.data.reg  = (uint8_t)((regRes & ST25R3911_REG_REGULATOR_RESULT_mask_reg) >> ST25R3911_REG_REGULATOR_RESULT_shift_reg);
+    newRec.data.trim = (uint8_t)(antRes >> CALIB_STORE_TRI_SHIFT);
+    if( !calibStoreMeasure( &newRec.data ) )
+    {
+        return;
+    }
+    newRec.magic = CALIB_STORE_MAGIC;
+    newRec.crc   = ~frameSourceCrc32Update( 0xFFFFFFFFU, (const uint8_t*)&newRec.data, sizeof(newRec.data) );
+
+    /* Spare the flash when the same results are stored already */
+    rec = calibStoreRec();
+    if( ST_BYTECMP( rec, &newRec, sizeof(newRec) ) == 0 )
+    {
+        return;
+    }
+
+    HAL_FLASH_Unlock();
+
+    erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+    erase.Banks       = FLASH_BANK_1;
+    erase.PageAddress = CALIB_STORE_ADDR;
+    erase.NbPages     = 1U;
+    err = ((HAL_FLASHEx_Erase( &erase, &pageErr ) == HAL_OK) ? ERR_NONE : ERR_WRITE);
+
+    for( i = sizeof(newRec.magic); (err == ERR_NONE) && (i < sizeof(newRec)); i += sizeof(uint32_t) )
+    {
+        err = calibStoreProgram( (CALIB_STORE_ADDR + i), &((const uint8_t*)&newRec)[i] );
+    }
+    if( err == ERR_NONE )
+    {
+        err = calibStoreProgram( CALIB_STORE_ADDR, (const uint8_t*)&newRec.magic );
+    }
+
+    HAL_FLASH_Lock();
+
+    bootProfileMark( "rf cal stored" );
+}
@@ -2,6 +2,11 @@
 #include "utils.h"
 #include "rfal_nfc.h"
 #include "rfal_st25xv.h"
+#include "frame_source.h"
+#include "demo_fleet.h"
+#include "dlist.h"
+#include "ndef_image.h"
+#include "rfal_chip.h"
 
 /* Definition of possible states the demo state machine could have */
 #define DEMO_ST_NOTINIT 0         /*!< Demo State:  Not initialized        */
@@ -13,17 +18,43 @@
 //#define DEMO_NFCV_USE_SELECT_MODE     false /*!< NFCV demonstrate select mode        */
 #define DEMO_NFCV_WRITE_TAG true   /*!< NFCV demonstrate Write Single Block */
 #define DEMO_NFCV_LOCK_BLOCK false //CL/*!< NFCV demonstrate Lock Single Block */
+#define DEMO_NFCV_NDEF_IMAGE false /*!< NFCV send the frame as an NDEF image record instead of slots */
+#define DEMO_UID_CACHE_LEN 4U      /*!< Tags re-acquired without a full discovery */
+
+#define DEMO_WU_PERIOD RFAL_WUM_PERIOD_200MS /*!< Wake-up measurement period, also bounds the key latency */
+#define DEMO_WU_SAMPLES 8U                   /*!< Measurements taken to set reference and thresholds      */
+#define DEMO_WU_MARGIN 2U                    /*!< Added to the measured noise to get the threshold        */
+#define DEMO_WU_DELTA_MAX 15U                /*!< Largest threshold the ST25R3911 takes                   */
+
+/*! Tag seen before, re-acquired by inventory alone */
+typedef struct
+{
+    uint8_t uid[RFAL_NFCV_UID_LEN]; /*!< Tag UID (as received, LSB first)                  */
+    bool served;                    /*!< Shows the current frame or a label, in field      */
+} demoUidEntry;
 
 static rfalNfcDiscoverParam discParam;
 static uint8_t state = DEMO_ST_NOTINIT;
 
-extern uint8_t nfcbuf[];
-extern uint8_t nfcbuf2[];
-uint8_t nfcbuf1[10][125][4] = {0}; //发送10次 140块 每块4个字节；
+static frameSource *demoFrame = NULL;     /*!< Frame sent to the next tag found */
+
+static demoUidEntry demoUidCache[DEMO_UID_CACHE_LEN]; /*!< Most recently served first     */
+static uint8_t demoUidCnt = 0U;
+static bool demoProbing = false;                      /*!< Field on for the fast path     */
+static bool demoPollOnce = false;                     /*!< Next round polls, no wake-up   */
 
 static void demoNfcv(rfalNfcvListenDevice *nfcvDev);
-static void demo2Nfcv(rfalNfcvListenDevice *nfcvDev);
+static ReturnCode demo2Nfcv(rfalNfcvListenDevice *nfcvDev);
+#if DEMO_NFCV_NDEF_IMAGE
+static ReturnCode demoNdefImage(const rfalNfcDevice *dev);
+#endif /* DEMO_NFCV_NDEF_IMAGE */
 static void demoNotif(rfalNfcState st);
+static void demoWakeUpCalibrate(rfalWakeUpConfig *cfg);
+static bool demoServe(rfalNfcDevice *dev);
+static demoUidEntry *demoUidFind(const uint8_t *uid);
+static demoUidEntry *demoUidAdd(const uint8_t *uid);
+static demoUidEntry *demoProbe(rfalNfcvInventoryRes *invRes);
+static void demoFleetServed(void);
 ReturnCode demoTransceiveBlocking(uint8_t *txBuf, uint16_t txBufSize, uint8_t **rxBuf, uint16_t **rcvLen, uint32_t fwt);
 ReturnCode rfalNfcvPollerGetBlockSecurityStatus(uint8_t flags, const uint8_t *uid, uint8_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
 
@@ -79,8 +110,8 @@ bool demoIni(void)
 
         discParam.notifyCb = demoNotif;
         discParam.totalDuration = 1000U;
-        discParam.wakeupEnabled = false;
-        discParam.wakeupConfigDefault = true;
+        discParam.wakeupEnabled = DEMO_SERVICE_MODE;
+        discParam.wakeupConfigDefault = false;
         discParam.techs2Find = (RFAL_NFC_POLL_TECH_V);
 
         state = DEMO_ST_START_DISCOVERY;
@@ -100,6 +131,7 @@ bool demoIni(void)
 void demoCycle(void)
 {
     static rfalNfcDevice *nfcDevice;
+    bool wakeup;
 
     rfalNfcWorker(); /* Run RFAL worker periodically */
 
@@ -123,7 +155,22 @@ void demoCycle(void)
         platformLedOff(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
 
         rfalNfcDeactivate(false);
-        rfalNfcDiscover(&discParam);
+        if (demoPollOnce)
+        {
+            /* A tag left on the antenna never wakes the reader: poll one round for it */
+            wakeup = discParam.wakeupEnabled;
+            discParam.wakeupEnabled = false;
+            rfalNfcDiscover(&discParam);
+            discParam.wakeupEnabled = wakeup;
+        }
+        else
+        {
+            if (discParam.wakeupEnabled)
+            {
+                demoWakeUpCalibrate(&discParam.wakeupConfig);
+            }
+            rfalNfcDiscover(&discParam);
+        }
 
         state = DEMO_ST_DISCOVERY;
         break;
@@ -142,18 +189,11 @@ void demoCycle(void)
 
             /*******************************************************************************/
             case RFAL_NFC_LISTEN_TYPE_NFCV:
-            {
-                uint8_t devUID[RFAL_NFCV_UID_LEN];
-
-                ST_MEMCPY(devUID, nfcDevice->nfcid, nfcDevice->nfcidLen); /* Copy the UID into local var */
-                REVERSE_BYTES(devUID, RFAL_NFCV_UID_LEN);                 /* Reverse the UID for display purposes */
-                printf("ISO15693/NFC-V card found. UID: %s\r\n", hex2Str(devUID, RFAL_NFCV_UID_LEN));
-
-                platformLedOn(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
-
-                demo2Nfcv(&nfcDevice->dev.nfcv);
-            }
-            break;
+                if (demoServe(nfcDevice))
+                {
+                    demoPollOnce = false;
+                }
+                break;
 
             /*******************************************************************************/
             default:
@@ -161,9 +201,59 @@ void demoCycle(void)
             }
 
             rfalNfcDeactivate(false);
-            platformDelay(500);
+            demoProbing = false;
             state = DEMO_ST_START_DISCOVERY;
         }
+        /* Nothing found this round: probe the known tags while discovery idles */
+        else if ((rfalNfcGetState() == RFAL_NFC_STATE_LISTEN_TECHDETECT) && (demoUidCnt != 0U))
+        {
+            static rfalNfcDevice fastDevice;
+            demoUidEntry *entry;
+
+            if (!demoProbing)
+            {
+                rfalNfcvPollerInitialize();
+                rfalFieldOnAndStartGT();
+                demoProbing = true;
+            }
+            else if (rfalIsGTExpired())
+            {
+                entry = demoProbe(&fastDevice.dev.nfcv.InvRes);
+                if (entry != NULL)
+                {
+                    /* Addressed mode only needs the UID, no activation */
+                    fastDevice.type = RFAL_NFC_LISTEN_TYPE_NFCV;
+                    fastDevice.rfInterface = RFAL_NFC_INTERFACE_RF;
+                    fastDevice.nfcid = fastDevice.dev.nfcv.InvRes.UID;
+                    fastDevice.nfcidLen = RFAL_NFCV_UID_LEN;
+                    if (demoServe(&fastDevice))
+                    {
+                        demoPollOnce = false;
+                    }
+
+                    rfalNfcDeactivate(false);
+                    demoProbing = false;
+                    state = DEMO_ST_START_DISCOVERY;
+                }
+                else if (demoPollOnce)
+                {
+                    /* No tag to serve: back to wake-up mode */
+                    demoPollOnce = false;
+                    rfalNfcDeactivate(false);
+                    demoProbing = false;
+                    state = DEMO_ST_START_DISCOVERY;
+                }
+            }
+        }
+        else if ((rfalNfcGetState() == RFAL_NFC_STATE_LISTEN_TECHDETECT) && demoPollOnce)
+        {
+            demoPollOnce = false; /* No tag to serve: back to wake-up mode */
+            state = DEMO_ST_START_DISCOVERY;
+        }
+        else
+        {
+            demoProbing = false; /* The worker switches the field off before the next round */
+        }
         break;
 
     /*******************************************************************************/
@@ -173,6 +263,225 @@ void demoCycle(void)
     }
 }
 
+/*!
+ *****************************************************************************
+ * \brief Set the wake-up reference and thresholds for the current antenna
+ *
+ * Amplitude and phase are sampled a few times: the mean becomes the
+ * reference and the spread plus a margin the threshold. A tag left on the
+ * reader is part of the reference, so only a change wakes the reader up.
+ *****************************************************************************
+ */
+static void demoWakeUpCalibrate(rfalWakeUpConfig *cfg)
+{
+    uint8_t ampMin, ampMax, phaMin, phaMax;
+    uint16_t ampSum, phaSum;
+    uint8_t amp, pha;
+    uint8_t i;
+
+    ampMin = 0xFFU;
+    ampMax = 0x00U;
+    phaMin = 0xFFU;
+    phaMax = 0x00U;
+    ampSum = 0U;
+    phaSum = 0U;
+    for (i = 0U; i < DEMO_WU_SAMPLES; i++)
+    {
+        rfalChipMeasureAmplitude(&amp);
+        rfalChipMeasurePhase(&pha);
+
+        ampMin = MIN(ampMin, amp);
+        ampMax = MAX(ampMax, amp);
+        phaMin = MIN(phaMin, pha);
+        phaMax = MAX(phaMax, pha);
+        ampSum += amp;
+        phaSum += pha;
+    }
+
+    ST_MEMSET(cfg, 0x00, sizeof(rfalWakeUpConfig));
+    cfg->period = DEMO_WU_PERIOD;
+    cfg->irqTout = true; /* Lets the main loop look at the keys every period */
+
+    cfg->indAmp.enabled = true;
+    cfg->indAmp.reference = (uint8_t)(ampSum / DEMO_WU_SAMPLES);
+    cfg->indAmp.delta = (uint8_t)MIN(((uint8_t)(ampMax - ampMin) + DEMO_WU_MARGIN), DEMO_WU_DELTA_MAX);
+
+    cfg->indPha.enabled = true;
+    cfg->indPha.reference = (uint8_t)(phaSum / DEMO_WU_SAMPLES);
+    cfg->indPha.delta = (uint8_t)MIN(((uint8_t)(phaMax - phaMin) + DEMO_WU_MARGIN), DEMO_WU_DELTA_MAX);
+}
+
+/*!
+ *****************************************************************************
+ * \brief Deliver the frame to an NFC-V tag
+ *
+ * A tag that already has the current frame and never left the field is
+ * skipped, so it gets one frame per placement.
+ *
+ * \return true if the tag holds the current frame
+ *****************************************************************************
+ */
+static bool demoServe(rfalNfcDevice *dev)
+{
+    uint8_t devUID[RFAL_NFCV_UID_LEN];
+    demoUidEntry *entry;
+    ReturnCode err;
+
+    entry = demoUidAdd(dev->dev.nfcv.InvRes.UID);
+    if (entry->served)
+    {
+        return true;
+    }
+
+    ST_MEMCPY(devUID, dev->nfcid, dev->nfcidLen); /* Copy the UID into local var */
+    REVERSE_BYTES(devUID, RFAL_NFCV_UID_LEN);     /* Reverse the UID for display purposes */
+    printf("ISO15693/NFC-V card found. UID: %s\r\n", hex2Str(devUID, RFAL_NFCV_UID_LEN));
+
+    platformLedOn(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+
+#if DEMO_NFCV_NDEF_IMAGE
+    err = demoNdefImage(dev);
+#else
+    err = demo2Nfcv(&dev->dev.nfcv);
+#endif /* DEMO_NFCV_NDEF_IMAGE */
+
+    /* A failed tag is tried again while it stays in the field */
+    entry->served = (err == ERR_NONE);
+    return entry->served;
+}
+
+/*!
+ *****************************************************************************
+ * \brief Look a tag up in the UID cache
+ *****************************************************************************
+ */
+static demoUidEntry *demoUidFind(const uint8_t *uid)
+{
+    uint8_t i;
+
+    for (i = 0U; i < demoUidCnt; i++)
+    {
+        if (ST_BYTECMP(demoUidCache[i].uid, uid, RFAL_NFCV_UID_LEN) == 0)
+        {
+            return &demoUidCache[i];
+        }
+    }
+    return NULL;
+}
+
+/*!
+ *****************************************************************************
+ * \brief Move a tag to the front of the UID cache
+ *
+ * An unknown tag replaces the least recently served one.
+ *****************************************************************************
+ */
+static demoUidEntry *demoUidAdd(const uint8_t *uid)
+{
+    demoUidEntry entry;
+    demoUidEntry *found;
+    uint8_t pos;
+
+    found = demoUidFind(uid);
+    if (found != NULL)
+    {
+        entry = *found;
+        pos = (uint8_t)(found - demoUidCache);
+    }
+    else
+    {
+        ST_MEMCPY(entry.uid, uid, RFAL_NFCV_UID_LEN);
+        entry.served = false;
+        demoUidCnt = MIN((demoUidCnt + 1U), DEMO_UID_CACHE_LEN);
+        pos = (uint8_t)(demoUidCnt - 1U);
+    }
+
+    ST_MEMMOVE(&demoUidCache[1], &demoUidCache[0], (pos * sizeof(demoUidEntry)));
+    demoUidCache[0] = entry;
+    return &demoUidCache[0];
+}
+
+/*!
+ *****************************************************************************
+ * \brief Look for known tags with single inventory commands
+ *
+ * An unmasked 1 slot inventory answers for the common single tag case; only
+ * when several tags collide is each cached UID checked with a full length
+ * mask. Tags that don't answer have left the field and lose their served
+ * mark.
+ *
+ * \param[out] invRes : inventory response of the tag found
+ *
+ * \return cached tag that is present and still needs the frame, NULL if none
+ *****************************************************************************
+ */
+static demoUidEntry *demoProbe(rfalNfcvInventoryRes *invRes)
+{
+    ReturnCode err;
+    demoUidEntry *found;
+    uint8_t i;
+
+    found = NULL;
+    err = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_1, 0U, NULL, invRes, NULL);
+    if ((err == ERR_NONE) || (err == ERR_TIMEOUT))
+    {
+        if (err == ERR_NONE)
+        {
+            found = demoUidFind(invRes->UID);
+        }
+        for (i = 0U; i < demoUidCnt; i++)
+        {
+            if (&demoUidCache[i] != found)
+            {
+                demoUidCache[i].served = false;
+            }
+        }
+        return (((found != NULL) && !found->served) ? found : NULL);
+    }
+
+    for (i = 0U; i < demoUidCnt; i++)
+    {
+        err = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_1, (uint8_t)rfalConvBytesToBits(RFAL_NFCV_UID_LEN), demoUidCache[i].uid, invRes, NULL);
+        if ((err == ERR_NONE) && (ST_BYTECMP(invRes->UID, demoUidCache[i].uid, RFAL_NFCV_UID_LEN) == 0))
+        {
+            if (!demoUidCache[i].served && (found == NULL))
+            {
+                found = &demoUidCache[i];
+            }
+        }
+        else
+        {
+            demoUidCache[i].served = false;
+        }
+    }
+
+    /* invRes must belong to the tag returned */
+    if (found != NULL)
+    {
+        ST_MEMCPY(invRes->UID, found->uid, RFAL_NFCV_UID_LEN);
+    }
+    return found;
+}
+
+/*!
+ *****************************************************************************
+ * \brief Mark the tags the last fleet run reached as served
+ *****************************************************************************
+ */
+static void demoFleetServed(void)
+{
+    const demoFleetJob *job;
+    uint8_t i;
+
+    for (i = 0U; (job = demoFleetGetJob(i)) != NULL; i++)
+    {
+        if (job->state == DEMO_FLEET_DONE)
+        {
+            demoUidAdd(job->uid)->served = true;
+        }
+    }
+}
+
 /*!
  *****************************************************************************
  * \brief Demo NFC-V Exchange
@@ -206,53 +515,47 @@ static void demoNfcv(rfalNfcvListenDevice *nfcvDev)
 #endif /* DEMO_NFCV_WRITE_TAG */
 }
 
-static void demo2Nfcv(rfalNfcvListenDevice *nfcvDev)
+static ReturnCode demo2Nfcv(rfalNfcvListenDevice *nfcvDev)
 {
     ReturnCode err;
-    uint16_t rcvLen;
-    uint8_t blockNum = 0;
-    uint8_t rxBuf[1 + DEMO_NFCV_BLOCK_LEN + RFAL_CRC_LEN]; /* Flags + Block Data + CRC */
-    uint8_t *uid;
-    uint8_t cir = 0; //循环次数
-    uint8_t wrData[DEMO_NFCV_BLOCK_LEN] = {0};         /* Write block example */
-                                                       /* DEMO_NFCV_WRITE_TAG */
-    uid = nfcvDev->InvRes.UID;
-		
-    for(cir=0;cir<10;cir++)
-		{
-		  for(blockNum=0;blockNum<125;blockNum++)
-		  {
-			  for(uint8_t i=0;i<4;i++)
-			  {
-			    wrData[i] = nfcbuf1[cir][blockNum][i]; 
-			  }	
-		    err = rfalNfcvPollerWriteSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, uid, blockNum, wrData, sizeof(wrData));
-        //printf(" Write Block %X: %s Data: %s\r\n", blockNum, (err != ERR_NONE) ? "FAIL" : "OK", hex2Str(wrData, DEMO_NFCV_BLOCK_LEN));
-				
-				if(err!=ERR_NONE)//写入失败重新发送
-				{
-				  err = rfalNfcvPollerWriteSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, uid, blockNum, wrData, sizeof(wrData));
-          //printf(" Write Block %X: %s Data: %s\r\n", blockNum, (err != ERR_NONE) ? "FAIL" : "OK", hex2Str(wrData, DEMO_NFCV_BLOCK_LEN));
-				}
-        //err = rfalNfcvPollerReadSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, uid, blockNum, rxBuf, sizeof(rxBuf), &rcvLen);
-        //printf(" Read Block %X: %s %s\r\n", blockNum, (err != ERR_NONE) ? "FAIL" : "OK Data:", (err != ERR_NONE) ? "" : hex2Str(&rxBuf[1], DEMO_NFCV_BLOCK_LEN));
-		  }
-		  
-			//先去读取 st25dv是否将数据存储完了 先用delay代替吧
-			wrData[0] = 0xaa;  //启动传输
-			wrData[1] = cir;   //这是第几次循环
-			wrData[2] = 0;
-			wrData[3] = 0;
-			err = rfalNfcvPollerWriteSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, uid, 125, wrData, sizeof(wrData));
-      //printf(" Write Block %X: %s Data: %s\r\n", blockNum, (err != ERR_NONE) ? "FAIL" : "OK", hex2Str(wrData, DEMO_NFCV_BLOCK_LEN));
-			if(err!=ERR_NONE)//写入失败重新发送
-			{
-				err = rfalNfcvPollerWriteSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, uid, 125, wrData, sizeof(wrData));
-        //printf(" Write Block %X: %s Data: %s\r\n", blockNum, (err != ERR_NONE) ? "FAIL" : "OK", hex2Str(wrData, DEMO_NFCV_BLOCK_LEN));
-			}
-			HAL_Delay(1000);
-		}
+
+    if(demoFrame == NULL)
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    /* Single tag: a one entry job table, the engine paces on the tag's flag */
+    demoFleetReset();
+    demoFleetAdd(nfcvDev->InvRes.UID);
+    err = demoFleetRun(demoFrame);
+    demoFleetReport();
+    return err;
+}
+
+#if DEMO_NFCV_NDEF_IMAGE
+/*!
+ *****************************************************************************
+ * \brief Demo NDEF image
+ *
+ * Writes the frame as a standard NDEF record, the way a phone would
+ *****************************************************************************
+ */
+static ReturnCode demoNdefImage(const rfalNfcDevice *dev)
+{
+    ReturnCode err;
+    uint32_t   t;
+
+    if(demoFrame == NULL)
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    t = platformGetSysTick();
+    err = ndefImageWrite(dev, demoFrame);
+    printf(" NDEF image: %s (%d) in %lu ms\r\n", (err != ERR_NONE) ? "FAIL" : "OK", err, (unsigned long)(platformGetSysTick() - t));
+    return err;
 }
+#endif /* DEMO_NFCV_NDEF_IMAGE */
 
 /*!
  *****************************************************************************
@@ -295,38 +598,148 @@ ReturnCode rfalNfcvPollerGetBlockSecurityStatus(uint8_t flags, const uint8_t *ui
 
 
 
-void nfcBufInit()
+/*!
+ *****************************************************************************
+ * \brief Fleet update
+ *
+ * Inventories every NFC-V tag in the field and delivers the current frame
+ * to all of them, interleaving the tags' slot rounds.
+ *****************************************************************************
+ */
+void demoFleetUpdate(void)
 {
-  int num = 0;	
-	for(uint8_t i=0;i<10;i++)
-	{
-	  for(uint8_t j=0;j<125;j++)
-		{
-		  for(uint8_t k=0;k<4;k++)
-			{
-			  nfcbuf1[i][j][k] = nfcbuf[num++]; 
-				printf("%d %d %d\r\n",nfcbuf1[i][j][k],nfcbuf[num-1],num-1);
-			}
-		}
-	}
-	num = 0;
+    uint8_t cnt;
+
+    if(demoFrame == NULL)
+    {
+        return;
+    }
+
+    rfalNfcDeactivate(false);
+    platformLedOn(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+
+    demoFleetReset();
+    cnt = demoFleetInventory();
+    printf("Fleet update: %d tag(s) found\r\n", cnt);
+
+    if(cnt != 0U)
+    {
+        if(demoFleetRun(demoFrame) == ERR_NOTSUPP)
+        {
+            printf("Fleet update: an uploaded frame goes to one tag only\r\n");
+        }
+        else
+        {
+            demoFleetReport();
+            demoFleetServed();
+        }
+    }
+
+    rfalFieldOff();
+    platformLedOff(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+    state = DEMO_ST_START_DISCOVERY;
+}
+
+/*!
+ *****************************************************************************
+ * \brief Fleet label
+ *
+ * Sends every NFC-V tag in the field a display list instead of a bitmap:
+ * a framed label with the reader's uptime, one slot per tag.
+ *****************************************************************************
+ */
+void demoFleetLabel(void)
+{
+    static uint8_t labelBuf[DLIST_MAX_LEN];
+    dlist          label;
+    char           text[24];
+    uint16_t       len;
+    uint8_t        cnt;
+
+    dlistBegin(&label, labelBuf, sizeof(labelBuf), DLIST_INK_WHITE);
+    dlistRect(&label, 0U, 0U, 200U, 200U, DLIST_INK_BLACK);
+    dlistRect(&label, 0U, 0U, 200U, 40U, (DLIST_INK_BLACK | DLIST_RECT_FILL));
+    dlistText(&label, 10U, 6U, (DLIST_FONT_20X28 | DLIST_INK_WHITE), "L-ink");
+    dlistLine(&label, 10U, 150U, 189U, 150U, DLIST_INK_BLACK);
+    snprintf(text, sizeof(text), "Up %lus", (unsigned long)(platformGetSysTick() / 1000U));
+    dlistText(&label, 10U, 70U, DLIST_FONT_15X21, text);
+    dlistText(&label, 10U, 160U, DLIST_FONT_5X7, "Display list demo");
+    if (dlistEnd(&label, &len) != ERR_NONE)
+    {
+        return;
+    }
+
+    rfalNfcDeactivate(false);
+    platformLedOn(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+
+    demoFleetReset();
+    cnt = demoFleetInventory();
+    printf("Fleet label: %d tag(s) found, %d byte list\r\n", cnt, len);
+
+    if (cnt != 0U)
+    {
+        demoFleetRunList(labelBuf, len);
+        demoFleetReport();
+
+        /* Keep the label up: discovery must not send these tags the frame */
+        demoFleetServed();
+    }
+
+    rfalFieldOff();
+    platformLedOff(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+    state = DEMO_ST_START_DISCOVERY;
+}
+
+/*!
+ *****************************************************************************
+ * \brief Sleep while the reader waits in wake-up mode
+ *
+ * The MCU stays in sleep mode with the SysTick stopped until an interrupt
+ * arrives: the ST25R3911 on a wake-up or its period timer, the UART or
+ * KEY_BACK. Returns at once if the reader is doing anything else.
+ *****************************************************************************
+ */
+void demoIdle(void)
+{
+    __disable_irq();
+
+    /* A wake-up already flagged on the IRQ line is handled first */
+    if ((state == DEMO_ST_DISCOVERY) && (rfalNfcGetState() == RFAL_NFC_STATE_WAKEUP_MODE) && !rfalWakeUpModeHasWoke() &&
+        platformGpioIsLow(ST25R391X_INT_PORT, ST25R391X_INT_PIN))
+    {
+        HAL_SuspendTick();
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+        HAL_ResumeTick();
+    }
+
+    __enable_irq();
 }
 
-void nfcBuf2Init()
+/*!
+ *****************************************************************************
+ * \brief Select the frame sent to the next NFC-V tag found
+ *
+ * The source is only referenced, it must stay valid while discovery runs.
+ *****************************************************************************
+ */
+void demoSetFrameSource(frameSource *src)
 {
-  int num = 0;	
-	for(uint8_t i=0;i<10;i++)
-	{
-	  for(uint8_t j=0;j<125;j++)
-		{
-		  for(uint8_t k=0;k<4;k++)
-			{
-			  nfcbuf1[i][j][k] = nfcbuf2[num++]; 
-				printf("%d %d %d\r\n",nfcbuf1[i][j][k],nfcbuf2[num-1],num-1);
-			}
-		}
-	}
-	num = 0;
+    uint8_t i;
+
+    demoFrame = src;
+
+    /* Tags still in the field get the new frame too */
+    for (i = 0U; i < demoUidCnt; i++)
+    {
+        demoUidCache[i].served = false;
+    }
+
+    /* They are part of the wake-up reference: leave wake-up mode and look for them */
+    if (discParam.wakeupEnabled && (state == DEMO_ST_DISCOVERY))
+    {
+        demoPollOnce = true;
+        state = DEMO_ST_START_DISCOVERY;
+    }
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
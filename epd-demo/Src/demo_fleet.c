@@ -0,0 +1,859 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Multi-tag frame transfer engine
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "demo_fleet.h"
+#include "frame_store.h"
+#include "link_adapt.h"
+#include "dlist.h"
+#include "rfal_rf.h"
+#include "utils.h"
+#include "logger.h"
+#include <stdio.h>
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define DEMO_FLEET_FLAG_BLOCK      FRAME_SLOT_BLOCKS  /*!< Tag block polled by the tag firmware   */
+#define DEMO_FLEET_STATUS_BLOCK    (FRAME_SLOT_BLOCKS + 1U)  /*!< Tag reports results here        */
+#define DEMO_FLEET_HEADER_BLOCK    (FRAME_SLOT_BLOCKS + 2U)  /*!< CRC-32 of the slot in EEPROM    */
+#define DEMO_FLEET_FLAG_START      0xAAU    /*!< Flag: slot ready in EEPROM               */
+#define DEMO_FLEET_FLAG_DELTA      0xABU    /*!< Flag: delta chunk ready in EEPROM        */
+#define DEMO_FLEET_FLAG_DLIST      0xACU    /*!< Flag: display list ready in EEPROM       */
+#define DEMO_FLEET_POLL_INTERVAL   100U     /*!< Flag poll period per tag [ms]            */
+#define DEMO_FLEET_FLAG_TIMEOUT    3000U    /*!< Max time for a tag to take a slot [ms]   */
+#define DEMO_FLEET_TAG_IDLE        3200U    /*!< Tag drops a partial frame after [ms]     */
+#define DEMO_FLEET_SRC_TIMEOUT     3000U    /*!< Max wait for a streamed block [ms]       */
+#define DEMO_FLEET_MAX_RETRIES     3U       /*!< Slot retries before a job fails          */
+#define DEMO_FLEET_IDLE_DELAY      5U       /*!< Pause when all tags are busy [ms]        */
+
+#define DEMO_FLEET_DELTA_HDR_LEN   8U       /*!< Chunk header: base CRC + new CRC         */
+#define DEMO_FLEET_DELTA_RUN_HDR   3U       /*!< Run header: first block (2) + count (1)  */
+#define DEMO_FLEET_DELTA_RUN_MAX   255U     /*!< Blocks per run                           */
+#define DEMO_FLEET_DELTA_END       0xFFFFU  /*!< First block value ending a chunk         */
+#define DEMO_FLEET_DELTA_END_LEN   2U       /*!< Length of the end marker                 */
+
+#define DEMO_FLEET_ST_CHUNK_OK     0x01U    /*!< Tag: chunk applied                       */
+#define DEMO_FLEET_ST_FRAME_OK     0x02U    /*!< Tag: last chunk applied, new CRC matches */
+#define DEMO_FLEET_ST_BASE_ERR     0xE1U    /*!< Tag: frame doesn't match the base CRC    */
+#define DEMO_FLEET_ST_CRC_ERR      0xE2U    /*!< Tag: patched frame doesn't match new CRC */
+#define DEMO_FLEET_ST_SEQ_ERR      0xE3U    /*!< Tag: chunk out of sequence               */
+#define DEMO_FLEET_ST_CHUNK_BAD    0xE4U    /*!< Tag: send the slot in the status again   */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+static demoFleetJob         fleetJobs[DEMO_FLEET_MAX_TAGS];   /*!< Job table               */
+static uint8_t              fleetJobCnt;                      /*!< Jobs in the table       */
+static uint8_t              fleetSlots;                       /*!< Slots of the last frame */
+static rfalNfcvListenDevice fleetDevList[DEMO_FLEET_MAX_TAGS];/*!< Inventory result        */
+static uint32_t             fleetCrc;                         /*!< CRC-32 of the frame     */
+static bool                 fleetCrcValid;                    /*!< Frame can be sent as delta */
+static bool                 fleetSeekable;                    /*!< Slots can be sent again */
+static uint8_t              fleetChunk[FRAME_SLOT_LEN];       /*!< Delta chunk being built */
+static uint8_t              fleetFrameId;                     /*!< Tells the tag a new frame from a resent slot */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode demoFleetWriteBlock( demoFleetJob *job, uint8_t blockNum, const uint8_t *data );
+static ReturnCode demoFleetSendSlot( demoFleetJob *job, frameSource *src );
+static ReturnCode demoFleetBuildChunk( const demoFleetJob *job, frameSource *src, uint16_t *blockNo, uint16_t *chunkLen );
+static ReturnCode demoFleetSendChunk( demoFleetJob *job, frameSource *src );
+static void       demoFleetPlan( demoFleetJob *job, frameSource *src );
+static void       demoFleetFallback( demoFleetJob *job );
+static void       demoFleetDeltaResult( demoFleetJob *job, const uint8_t *status );
+static void       demoFleetSlotResult( demoFleetJob *job, const uint8_t *status );
+static void       demoFleetPoll( demoFleetJob *job );
+static void       demoFleetRetry( demoFleetJob *job, ReturnCode err );
+static ReturnCode demoFleetSendList( demoFleetJob *job, const uint8_t *list, uint16_t len );
+static void       demoFleetPollList( demoFleetJob *job );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode demoFleetWriteBlock( demoFleetJob *job, uint8_t blockNum, const uint8_t *data )
+{
+    ReturnCode err;
+    bool       retried;
+
+    retried = false;
+    err = rfalNfcvPollerWriteSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, blockNum, data, FRAME_BLOCK_LEN );
+    if( err != ERR_NONE ) //写入失败重新发送
+    {
+        job->blkErrors++;
+        retried = true;
+        err = rfalNfcvPollerWriteSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, blockNum, data, FRAME_BLOCK_LEN );
+    }
+
+    linkAdaptBlock( retried, err );
+    return err;
+}
+
+/*******************************************************************************/
+static ReturnCode demoFleetSendSlot( demoFleetJob *job, frameSource *src )
+{
+    ReturnCode     err;
+    uint16_t       blockNo;
+    uint16_t       lastBlock;
+    uint32_t       tStart;
+    const uint8_t *blkData;
+    uint8_t        flag[FRAME_BLOCK_LEN];
+    uint32_t       crc;
+
+    crc       = 0xFFFFFFFFU;
+    blockNo   = ((uint16_t)job->slot * FRAME_SLOT_BLOCKS);
+    lastBlock = (uint16_t)MIN( (blockNo + FRAME_SLOT_BLOCKS), frameSourceBlockCount( src ) );
+
+    for( ; blockNo < lastBlock; blockNo++ )
+    {
+        /* Streaming sources may still be receiving this block */
+        tStart = platformGetSysTick();
+        do
+        {
+            err = frameSourceGetBlock( src, blockNo, &blkData );
+        }
+        while( (err == ERR_BUSY) && ((platformGetSysTick() - tStart) < DEMO_FLEET_SRC_TIMEOUT) );
+
+        if( err != ERR_NONE )
+        {
+            return err;
+        }
+
+        EXIT_ON_ERR( err, demoFleetWriteBlock( job, frameSourceSlotBlock( blockNo ), blkData ) );
+        crc = frameSourceCrc32Update( crc, blkData, FRAME_BLOCK_LEN );
+    }
+
+    /* The tag checks the slot against it instead of the blocks being read back */
+    crc     = ~crc;
+    flag[0] = (uint8_t)(crc >> 24);
+    flag[1] = (uint8_t)(crc >> 16);
+    flag[2] = (uint8_t)(crc >> 8);
+    flag[3] = (uint8_t)(crc);
+    EXIT_ON_ERR( err, demoFleetWriteBlock( job, DEMO_FLEET_HEADER_BLOCK, flag ) );
+
+    /* Hand the slot over to the tag */
+    flag[0] = DEMO_FLEET_FLAG_START;
+    flag[1] = job->slot;                               //这是第几次循环
+    flag[2] = fleetFrameId;
+    flag[3] = fleetSlots;
+    EXIT_ON_ERR( err, demoFleetWriteBlock( job, DEMO_FLEET_FLAG_BLOCK, flag ) );
+
+    job->flagTick = platformGetSysTick();
+    job->pollTick = job->flagTick;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode demoFleetBuildChunk( const demoFleetJob *job, frameSource *src, uint16_t *blockNo, uint16_t *chunkLen )
+{
+    ReturnCode     err;
+    const uint8_t *blkData;
+    uint16_t       len;
+    uint16_t       runHdr;
+    uint8_t        runCnt;
+
+    fleetChunk[0] = (uint8_t)(job->baseCrc >> 24);
+    fleetChunk[1] = (uint8_t)(job->baseCrc >> 16);
+    fleetChunk[2] = (uint8_t)(job->baseCrc >> 8);
+    fleetChunk[3] = (uint8_t)(job->baseCrc);
+    fleetChunk[4] = (uint8_t)(fleetCrc >> 24);
+    fleetChunk[5] = (uint8_t)(fleetCrc >> 16);
+    fleetChunk[6] = (uint8_t)(fleetCrc >> 8);
+    fleetChunk[7] = (uint8_t)(fleetCrc);
+
+    len    = DEMO_FLEET_DELTA_HDR_LEN;
+    runHdr = 0U;
+    runCnt = 0U;
+    for( ; *blockNo < frameSourceBlockCount( src ); (*blockNo)++ )
+    {
+        EXIT_ON_ERR( err, frameSourceGetBlock( src, *blockNo, &blkData ) );
+
+        if( ST_BYTECMP( blkData, &job->base[(uint32_t)*blockNo * FRAME_BLOCK_LEN], FRAME_BLOCK_LEN ) == 0 )
+        {
+            runCnt = 0U;                                 /* Unchanged: close the open run          */
+            continue;
+        }
+
+        /* Changed block: extend the open run or start a new one, if it still fits */
+        if( (runCnt == 0U) || (runCnt == DEMO_FLEET_DELTA_RUN_MAX) )
+        {
+            if( (len + DEMO_FLEET_DELTA_RUN_HDR + FRAME_BLOCK_LEN + DEMO_FLEET_DELTA_END_LEN) > FRAME_SLOT_LEN )
+            {
+                break;
+            }
+            runHdr             = len;
+            runCnt             = 0U;
+            fleetChunk[len++]  = (uint8_t)(*blockNo >> 8);
+            fleetChunk[len++]  = (uint8_t)(*blockNo);
+            fleetChunk[len++]  = 0U;
+        }
+        else if( (len + FRAME_BLOCK_LEN + DEMO_FLEET_DELTA_END_LEN) > FRAME_SLOT_LEN )
+        {
+            break;
+        }
+
+        ST_MEMCPY( &fleetChunk[len], blkData, FRAME_BLOCK_LEN );
+        len                  += FRAME_BLOCK_LEN;
+        fleetChunk[runHdr + 2U] = ++runCnt;
+    }
+
+    fleetChunk[len++] = (uint8_t)(DEMO_FLEET_DELTA_END >> 8);
+    fleetChunk[len++] = (uint8_t)(DEMO_FLEET_DELTA_END);
+
+    *chunkLen = len;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode demoFleetSendChunk( demoFleetJob *job, frameSource *src )
+{
+    ReturnCode err;
+    uint16_t   blockNo;
+    uint16_t   len;
+    uint16_t   i;
+    uint8_t    flag[FRAME_BLOCK_LEN];
+
+    blockNo = job->deltaBlock;
+    EXIT_ON_ERR( err, demoFleetBuildChunk( job, src, &blockNo, &len ) );
+    job->deltaNext = blockNo;
+
+    /* Only the blocks the chunk occupies go over the air */
+    ST_MEMSET( &fleetChunk[len], 0xFF, (((FRAME_BLOCK_LEN - (len % FRAME_BLOCK_LEN)) % FRAME_BLOCK_LEN)) );
+    for( i = 0U; i < ((len + FRAME_BLOCK_LEN - 1U) / FRAME_BLOCK_LEN); i++ )
+    {
+        EXIT_ON_ERR( err, demoFleetWriteBlock( job, (uint8_t)i, &fleetChunk[i * FRAME_BLOCK_LEN] ) );
+    }
+
+    flag[0] = DEMO_FLEET_FLAG_DELTA;
+    flag[1] = job->chunk;
+    flag[2] = (((job->chunk + 1U) >= job->chunks) ? 1U : 0U);
+    flag[3] = 0U;
+    EXIT_ON_ERR( err, demoFleetWriteBlock( job, DEMO_FLEET_FLAG_BLOCK, flag ) );
+
+    job->flagTick = platformGetSysTick();
+    job->pollTick = job->flagTick;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static void demoFleetPlan( demoFleetJob *job, frameSource *src )
+{
+    uint16_t blockNo;
+    uint16_t len;
+
+    job->delta      = false;
+    job->chunk      = 0U;
+    job->chunks     = 0U;
+    job->deltaBlock = 0U;
+
+    if( !fleetCrcValid )
+    {
+        return;
+    }
+
+    job->base = frameStoreLookup( job->uid, &job->baseCrc );
+    if( job->base == NULL )
+    {
+        return;
+    }
+
+    /* Dry run: a delta needing as many rounds as the full frame is not worth it.
+     * An unchanged frame still takes one empty chunk, so the tag confirms it.   */
+    blockNo = 0U;
+    do
+    {
+        if( demoFleetBuildChunk( job, src, &blockNo, &len ) != ERR_NONE )
+        {
+            return;
+        }
+        job->chunks++;
+    }
+    while( (blockNo < frameSourceBlockCount( src )) && (job->chunks < fleetSlots) );
+
+    job->delta = ((blockNo >= frameSourceBlockCount( src )) && (job->chunks < fleetSlots));
+}
+
+/*******************************************************************************/
+static void demoFleetFallback( demoFleetJob *job )
+{
+    job->delta   = false;
+    job->chunk   = 0U;
+    job->slot    = 0U;
+    job->retries = 0U;
+    job->state   = DEMO_FLEET_SEND;
+    job->fallbacks++;
+}
+
+/*******************************************************************************/
+static void demoFleetDeltaResult( demoFleetJob *job, const uint8_t *status )
+{
+    if( status[1] != job->chunk )
+    {
+        demoFleetFallback( job );                        /* Not our chunk's answer                 */
+        return;
+    }
+
+    if( (status[0] == DEMO_FLEET_ST_FRAME_OK) && ((job->chunk + 1U) >= job->chunks) )
+    {
+        job->chunk++;
+        job->state    = DEMO_FLEET_DONE;
+        job->doneTick = job->pollTick;
+        return;
+    }
+
+    if( (status[0] == DEMO_FLEET_ST_CHUNK_OK) && ((job->chunk + 1U) < job->chunks) )
+    {
+        job->chunk++;
+        job->deltaBlock = job->deltaNext;
+        job->state      = DEMO_FLEET_SEND;
+        return;
+    }
+
+    /* Tag holds a different frame or patching went wrong: send it all */
+    demoFleetFallback( job );
+}
+
+/*******************************************************************************/
+static void demoFleetSlotResult( demoFleetJob *job, const uint8_t *status )
+{
+    if( status[0] == DEMO_FLEET_ST_FRAME_OK )
+    {
+        job->slot     = fleetSlots;
+        job->retries  = 0U;
+        job->state    = DEMO_FLEET_DONE;
+        job->doneTick = job->pollTick;
+        return;
+    }
+
+    if( (status[0] == DEMO_FLEET_ST_CHUNK_OK) && (status[1] == job->slot) && ((job->slot + 1U) < fleetSlots) )
+    {
+        job->retries = 0U;
+        job->slot++;
+        job->state   = DEMO_FLEET_SEND;
+        return;
+    }
+
+    /* Slot failed its CRC, was programmed wrong or got lost: go on from the one the tag asks for */
+    job->slot = (((status[0] == DEMO_FLEET_ST_CHUNK_BAD) && (status[1] < fleetSlots)) ? status[1] : 0U);
+    job->resends++;
+    demoFleetRetry( job, ERR_CRC );
+}
+
+/*******************************************************************************/
+static void demoFleetRetry( demoFleetJob *job, ReturnCode err )
+{
+    job->lastErr = err;
+
+    if( !fleetSeekable )
+    {
+        /* A streamed slot is gone once sent: the tag can't get it again */
+        job->lastErr  = ERR_NOTSUPP;
+        job->state    = DEMO_FLEET_FAILED;
+        job->doneTick = platformGetSysTick();
+        return;
+    }
+
+    if( ++job->retries > DEMO_FLEET_MAX_RETRIES )
+    {
+        if( job->delta )
+        {
+            demoFleetFallback( job );                    /* Tag firmware may not know deltas       */
+            return;
+        }
+
+        job->state    = DEMO_FLEET_FAILED;
+        job->doneTick = platformGetSysTick();
+        return;
+    }
+
+    job->state = DEMO_FLEET_SEND;
+}
+
+/*******************************************************************************/
+static void demoFleetPoll( demoFleetJob *job )
+{
+    ReturnCode err;
+    uint16_t   rcvLen;
+    uint8_t    rxBuf[1U + FRAME_BLOCK_LEN + RFAL_CRC_LEN];     /* Flags + Block Data + CRC */
+
+    if( (platformGetSysTick() - job->pollTick) < DEMO_FLEET_POLL_INTERVAL )
+    {
+        return;
+    }
+    job->pollTick = platformGetSysTick();
+
+    /* The tag clears the flag once it copied the slot out of its EEPROM.
+     * While its I2C side is busy the RF read may fail: just poll again.  */
+    err = rfalNfcvPollerReadSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, DEMO_FLEET_FLAG_BLOCK, rxBuf, sizeof(rxBuf), &rcvLen );
+    if( (err == ERR_NONE) && (rcvLen > 1U) && job->delta && (rxBuf[1] != DEMO_FLEET_FLAG_DELTA) )
+    {
+        /* The tag writes its verdict before it clears the flag */
+        err = rfalNfcvPollerReadSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, DEMO_FLEET_STATUS_BLOCK, rxBuf, sizeof(rxBuf), &rcvLen );
+        if( (err == ERR_NONE) && (rcvLen > 2U) )
+        {
+            job->retries  = 0U;
+            job->flagTick = job->pollTick;
+            demoFleetDeltaResult( job, &rxBuf[1] );
+            return;
+        }
+    }
+    else if( (err == ERR_NONE) && (rcvLen > 1U) && !job->delta && (rxBuf[1] != DEMO_FLEET_FLAG_START) )
+    {
+        /* Tags checking the slot CRC echo the frame ID with their verdict */
+        err = rfalNfcvPollerReadSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, DEMO_FLEET_STATUS_BLOCK, rxBuf, sizeof(rxBuf), &rcvLen );
+        if( (err == ERR_NONE) && (rcvLen > 3U) && (rxBuf[3] == fleetFrameId) )
+        {
+            job->flagTick = job->pollTick;             /* Tag's idle timer restarts here         */
+            job->echoed   = true;
+            demoFleetSlotResult( job, &rxBuf[1] );
+            return;
+        }
+
+        if( err != ERR_NONE )
+        {
+            /* Status unreadable: poll again, bounded by the flag timeout */
+        }
+        else if( !job->echoed )
+        {
+            /* Older tag firmware: a cleared flag is all it tells */
+            job->flagTick = job->pollTick;
+            job->retries  = 0U;
+            job->slot++;
+            if( job->slot >= fleetSlots )
+            {
+                job->state    = DEMO_FLEET_DONE;
+                job->doneTick = job->pollTick;
+            }
+            else
+            {
+                job->state = DEMO_FLEET_SEND;
+            }
+            return;
+        }
+        else
+        {
+            /* Stale or unknown frame ID: the tag couldn't read the flag, send the slot again */
+            job->flagTick = job->pollTick;
+            job->resends++;
+            demoFleetRetry( job, ERR_CRC );
+            return;
+        }
+    }
+
+    if( (platformGetSysTick() - job->flagTick) > DEMO_FLEET_FLAG_TIMEOUT )
+    {
+        demoFleetRetry( job, ((err != ERR_NONE) ? err : ERR_TIMEOUT) );
+    }
+}
+
+/*******************************************************************************/
+static ReturnCode demoFleetSendList( demoFleetJob *job, const uint8_t *list, uint16_t len )
+{
+    ReturnCode err;
+    uint16_t   pos;
+    uint8_t    blk[FRAME_BLOCK_LEN];
+
+    /* The tag reads all blocks below the flag, the rest is ignored after the end marker */
+    for( pos = 0U; pos < len; pos += FRAME_BLOCK_LEN )
+    {
+        ST_MEMSET( blk, DLIST_OP_END, FRAME_BLOCK_LEN );
+        ST_MEMCPY( blk, &list[pos], MIN( (uint16_t)FRAME_BLOCK_LEN, (uint16_t)(len - pos) ) );
+        EXIT_ON_ERR( err, demoFleetWriteBlock( job, (uint8_t)(pos / FRAME_BLOCK_LEN), blk ) );
+    }
+
+    blk[0] = DEMO_FLEET_FLAG_DLIST;
+    blk[1] = 0U;
+    blk[2] = 0U;
+    blk[3] = 0U;
+    EXIT_ON_ERR( err, demoFleetWriteBlock( job, DEMO_FLEET_FLAG_BLOCK, blk ) );
+
+    job->flagTick = platformGetSysTick();
+    job->pollTick = job->flagTick;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static void demoFleetPollList( demoFleetJob *job )
+{
+    ReturnCode err;
+    uint16_t   rcvLen;
+    uint8_t    rxBuf[1U + FRAME_BLOCK_LEN + RFAL_CRC_LEN];     /* Flags + Block Data + CRC */
+
+    if( (platformGetSysTick() - job->pollTick) < DEMO_FLEET_POLL_INTERVAL )
+    {
+        return;
+    }
+    job->pollTick = platformGetSysTick();
+
+    /* The tag renders the whole list before it writes its verdict and clears the flag */
+    err = rfalNfcvPollerReadSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, DEMO_FLEET_FLAG_BLOCK, rxBuf, sizeof(rxBuf), &rcvLen );
+    if( (err == ERR_NONE) && (rcvLen > 1U) && (rxBuf[1] != DEMO_FLEET_FLAG_DLIST) )
+    {
+        job->flagTick = job->pollTick;
+
+        err = rfalNfcvPollerReadSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, job->uid, DEMO_FLEET_STATUS_BLOCK, rxBuf, sizeof(rxBuf), &rcvLen );
+        if( (err == ERR_NONE) && (rcvLen > 1U) && (rxBuf[1] == DEMO_FLEET_ST_FRAME_OK) )
+        {
+            job->slot     = 1U;
+            job->retries  = 0U;
+            job->state    = DEMO_FLEET_DONE;
+            job->doneTick = job->pollTick;
+            return;
+        }
+
+        demoFleetRetry( job, ((err != ERR_NONE) ? err : ERR_CRC) );
+        return;
+    }
+
+    if( (platformGetSysTick() - job->flagTick) > DEMO_FLEET_FLAG_TIMEOUT )
+    {
+        demoFleetRetry( job, ((err != ERR_NONE) ? err : ERR_TIMEOUT) );
+    }
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void demoFleetReset( void )
+{
+    fleetJobCnt = 0U;
+}
+
+/*******************************************************************************/
+ReturnCode demoFleetAdd( const uint8_t *uid )
+{
+    uint8_t i;
+
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        if( ST_BYTECMP( fleetJobs[i].uid, uid, RFAL_NFCV_UID_LEN ) == 0 )
+        {
+            return ERR_NONE;
+        }
+    }
+
+    if( fleetJobCnt >= DEMO_FLEET_MAX_TAGS )
+    {
+        return ERR_NOMEM;
+    }
+
+    ST_MEMSET( &fleetJobs[fleetJobCnt], 0x00, sizeof(demoFleetJob) );
+    ST_MEMCPY( fleetJobs[fleetJobCnt].uid, uid, RFAL_NFCV_UID_LEN );
+    fleetJobs[fleetJobCnt].state = DEMO_FLEET_QUEUED;
+    fleetJobCnt++;
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+uint8_t demoFleetInventory( void )
+{
+    uint8_t devCnt;
+    uint8_t i;
+
+    rfalNfcvPollerInitialize();
+    rfalFieldOnAndStartGT();
+    while( !rfalIsGTExpired() )
+    {
+    }
+
+    devCnt = 0U;
+    if( rfalNfcvPollerSleepCollisionResolution( DEMO_FLEET_MAX_TAGS, fleetDevList, &devCnt ) != ERR_NONE )
+    {
+        /* Fall back to the plain anticollision, bounded by the slots it can resolve */
+        rfalNfcvPollerCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, DEMO_FLEET_MAX_TAGS, fleetDevList, &devCnt );
+    }
+
+    for( i = 0U; i < devCnt; i++ )
+    {
+        demoFleetAdd( fleetDevList[i].InvRes.UID );
+    }
+
+    return fleetJobCnt;
+}
+
+/*******************************************************************************/
+ReturnCode demoFleetRun( frameSource *src )
+{
+    ReturnCode    err;
+    demoFleetJob *next;
+    uint8_t       active;
+    uint8_t       pending;
+    uint8_t       i;
+
+    if( (src == NULL) || (frameSourceBlockCount( src ) == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    /* A streamed frame is read once, in order: only one tag can follow it */
+    if( !src->seekable && (fleetJobCnt > 1U) )
+    {
+        return ERR_NOTSUPP;
+    }
+
+    fleetSeekable = src->seekable;
+    fleetSlots = (uint8_t)((frameSourceBlockCount( src ) + FRAME_SLOT_BLOCKS - 1U) / FRAME_SLOT_BLOCKS);
+
+    /* Deltas need the whole frame up front: not possible while it is still streaming in */
+    fleetCrcValid = ((src->len == FRAME_LEN) && (frameSourceCrc32( src, &fleetCrc ) == ERR_NONE));
+    frameSourcePrefetch( src, 0U );
+    linkAdaptReset();
+
+    /* Never 0: a tag fresh out of reset holds that one */
+    fleetFrameId = (uint8_t)(((fleetFrameId + 1U) == 0x100U) ? 1U : (fleetFrameId + 1U));
+
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        fleetJobs[i].state     = DEMO_FLEET_QUEUED;
+        fleetJobs[i].slot      = 0U;
+        fleetJobs[i].retries   = 0U;
+        fleetJobs[i].restarts  = 0U;
+        fleetJobs[i].blkErrors = 0U;
+        fleetJobs[i].lastErr   = ERR_NONE;
+        fleetJobs[i].fallbacks = 0U;
+        fleetJobs[i].resends   = 0U;
+        fleetJobs[i].echoed    = false;
+        fleetJobs[i].base      = NULL;
+    }
+
+    for(;;)
+    {
+        /* Update waiting tags and count the active ones */
+        active  = 0U;
+        pending = 0U;
+        for( i = 0U; i < fleetJobCnt; i++ )
+        {
+            if( fleetJobs[i].state == DEMO_FLEET_WAIT )
+            {
+                demoFleetPoll( &fleetJobs[i] );
+            }
+            if( (fleetJobs[i].state == DEMO_FLEET_SEND) || (fleetJobs[i].state == DEMO_FLEET_WAIT) )
+            {
+                active++;
+            }
+            if( fleetJobs[i].state == DEMO_FLEET_QUEUED )
+            {
+                pending++;
+            }
+        }
+
+        /* Start queued tags while there is room */
+        for( i = 0U; (i < fleetJobCnt) && (active < DEMO_FLEET_ACTIVE_MAX); i++ )
+        {
+            if( fleetJobs[i].state == DEMO_FLEET_QUEUED )
+            {
+                fleetJobs[i].state     = DEMO_FLEET_SEND;
+                fleetJobs[i].startTick = platformGetSysTick();
+                fleetJobs[i].flagTick  = fleetJobs[i].startTick;
+                demoFleetPlan( &fleetJobs[i], src );
+                active++;
+                pending--;
+            }
+        }
+
+        if( (active == 0U) && (pending == 0U) )
+        {
+            break;
+        }
+
+        /* Serve the ready tag that has been idle longest, it is closest to its timeout */
+        next = NULL;
+        for( i = 0U; i < fleetJobCnt; i++ )
+        {
+            if( (fleetJobs[i].state == DEMO_FLEET_SEND) && ((next == NULL) || ((int32_t)(fleetJobs[i].flagTick - next->flagTick) < 0)) )
+            {
+                next = &fleetJobs[i];
+            }
+        }
+
+        if( next == NULL )
+        {
+            platformDelay( DEMO_FLEET_IDLE_DELAY );
+            continue;
+        }
+
+        /* Too late for the tag's partial frame: start this tag over.
+         * A partly patched frame no longer matches the delta base either. */
+        if( ((next->slot != 0U) || (next->chunk != 0U)) && ((platformGetSysTick() - next->flagTick) > DEMO_FLEET_TAG_IDLE) )
+        {
+            if( !fleetSeekable )
+            {
+                next->lastErr  = ERR_NOTSUPP;
+                next->state    = DEMO_FLEET_FAILED;
+                next->doneTick = platformGetSysTick();
+                continue;
+            }
+            next->slot  = 0U;
+            next->chunk = 0U;
+            next->delta = false;
+            next->restarts++;
+        }
+
+        err = (next->delta ? demoFleetSendChunk( next, src ) : demoFleetSendSlot( next, src ));
+        if( err == ERR_NONE )
+        {
+            next->state = DEMO_FLEET_WAIT;
+
+            /* Give streaming sources the chance to load what comes next */
+            frameSourcePrefetch( src, (next->delta ? next->deltaNext : (uint16_t)((next->slot + 1U) * FRAME_SLOT_BLOCKS)) );
+        }
+        else if( (err == ERR_BUSY) || (err == ERR_WRONG_STATE) || (err == ERR_PARAM) )
+        {
+            /* Frame source can't deliver: retrying the tag won't help */
+            next->lastErr  = err;
+            next->state    = DEMO_FLEET_FAILED;
+            next->doneTick = platformGetSysTick();
+        }
+        else
+        {
+            demoFleetRetry( next, err );
+        }
+    }
+
+    /* Remember what each tag shows now, the next frame only sends what differs */
+    err = ERR_NONE;
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        if( fleetJobs[i].state != DEMO_FLEET_DONE )
+        {
+            err = ERR_IO;
+        }
+        else if( fleetCrcValid && ((fleetJobs[i].base == NULL) || (fleetJobs[i].baseCrc != fleetCrc)) )
+        {
+            frameStoreSave( fleetJobs[i].uid, src, fleetCrc );
+        }
+    }
+    return err;
+}
+
+/*******************************************************************************/
+ReturnCode demoFleetRunList( const uint8_t *list, uint16_t len )
+{
+    ReturnCode err;
+    uint8_t    busy;
+    uint8_t    i;
+
+    if( (list == NULL) || (len == 0U) || (len > DLIST_MAX_LEN) )
+    {
+        return ERR_PARAM;
+    }
+
+    fleetSlots = 1U;
+    linkAdaptReset();
+
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        fleetJobs[i].state     = DEMO_FLEET_SEND;
+        fleetJobs[i].slot      = 0U;
+        fleetJobs[i].retries   = 0U;
+        fleetJobs[i].restarts  = 0U;
+        fleetJobs[i].blkErrors = 0U;
+        fleetJobs[i].lastErr   = ERR_NONE;
+        fleetJobs[i].delta     = false;
+        fleetJobs[i].fallbacks = 0U;
+        fleetJobs[i].resends   = 0U;
+        fleetJobs[i].base      = NULL;
+        fleetJobs[i].startTick = platformGetSysTick();
+    }
+
+    /* One slot per tag: write all of them, then collect the verdicts */
+    do
+    {
+        busy = 0U;
+        for( i = 0U; i < fleetJobCnt; i++ )
+        {
+            if( fleetJobs[i].state == DEMO_FLEET_SEND )
+            {
+                err = demoFleetSendList( &fleetJobs[i], list, len );
+                if( err == ERR_NONE )
+                {
+                    fleetJobs[i].state = DEMO_FLEET_WAIT;
+                }
+                else
+                {
+                    demoFleetRetry( &fleetJobs[i], err );
+                }
+            }
+            else if( fleetJobs[i].state == DEMO_FLEET_WAIT )
+            {
+                demoFleetPollList( &fleetJobs[i] );
+            }
+
+            if( (fleetJobs[i].state == DEMO_FLEET_SEND) || (fleetJobs[i].state == DEMO_FLEET_WAIT) )
+            {
+                busy++;
+            }
+        }
+
+        if( busy != 0U )
+        {
+            platformDelay( DEMO_FLEET_IDLE_DELAY );
+        }
+    }
+    while( busy != 0U );
+
+    err = ERR_NONE;
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        if( fleetJobs[i].state != DEMO_FLEET_DONE )
+        {
+            err = ERR_IO;
+        }
+    }
+    return err;
+}
+
+/*******************************************************************************/
+const demoFleetJob *demoFleetGetJob( uint8_t idx )
+{
+    return ((idx < fleetJobCnt) ? &fleetJobs[idx] : NULL);
+}
+
+/*******************************************************************************/
+void demoFleetReport( void )
+{
+    static const char * const stateStr[] = { "QUEUED", "SEND", "WAIT", "DONE", "FAILED" };
+    uint8_t devUID[RFAL_NFCV_UID_LEN];
+    uint8_t i;
+
+    for( i = 0U; i < fleetJobCnt; i++ )
+    {
+        ST_MEMCPY( devUID, fleetJobs[i].uid, RFAL_NFCV_UID_LEN );
+        REVERSE_BYTES( devUID, RFAL_NFCV_UID_LEN );     /* Reverse the UID for display purposes */
+
+        printf(" %s %-6s %s %d/%d retries %d restarts %d fallbacks %d resends %d blkErr %d err %d time %ldms\r\n",
+               hex2Str( devUID, RFAL_NFCV_UID_LEN ), stateStr[fleetJobs[i].state],
+               (fleetJobs[i].delta ? "chunk" : "slot"),
+               (fleetJobs[i].delta ? fleetJobs[i].chunk : fleetJobs[i].slot),
+               (fleetJobs[i].delta ? fleetJobs[i].chunks : fleetSlots),
+               fleetJobs[i].retries, fleetJobs[i].restarts, fleetJobs[i].fallbacks, fleetJobs[i].resends,
+               fleetJobs[i].blkErrors, fleetJobs[i].lastErr,
+               (long)(fleetJobs[i].doneTick - fleetJobs[i].startTick) );
+    }
+    printf(" RFO driver level %d\r\n", linkAdaptGetRfo() );
+}
@@ -0,0 +1,194 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Display list encoder
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "dlist.h"
+#include "utils.h"
+#include <string.h>
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define DLIST_HDR_LEN              2U       /*!< Version + background                     */
+#define DLIST_TEXT_MAX             255U     /*!< Characters per text command              */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static uint8_t *dlistReserve( dlist *dl, uint16_t len );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static uint8_t *dlistReserve( dlist *dl, uint16_t len )
+{
+    uint8_t *cmd;
+
+    /* Room for the end marker is always kept */
+    if( dl->overflow || (((uint32_t)dl->len + len + 1U) > dl->size) )
+    {
+        dl->overflow = true;
+        return NULL;
+    }
+
+    cmd      = &dl->buf[dl->len];
+    dl->len += len;
+    return cmd;
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void dlistBegin( dlist *dl, uint8_t *buf, uint16_t size, uint8_t background )
+{
+    dl->buf      = buf;
+    dl->size     = MIN( size, DLIST_MAX_LEN );
+    dl->len      = 0U;
+    dl->overflow = false;
+
+    if( dl->size <= DLIST_HDR_LEN )
+    {
+        dl->overflow = true;
+        return;
+    }
+
+    dl->buf[dl->len++] = DLIST_VERSION;
+    dl->buf[dl->len++] = background;
+}
+
+/*******************************************************************************/
+void dlistText( dlist *dl, uint8_t x, uint8_t y, uint8_t font, const char *text )
+{
+    uint8_t *cmd;
+    size_t   n;
+
+    n   = MIN( strlen( text ), DLIST_TEXT_MAX );
+    cmd = dlistReserve( dl, (uint16_t)(5U + n) );
+    if( cmd == NULL )
+    {
+        return;
+    }
+
+    cmd[0] = DLIST_OP_TEXT;
+    cmd[1] = x;
+    cmd[2] = y;
+    cmd[3] = font;
+    cmd[4] = (uint8_t)n;
+    ST_MEMCPY( &cmd[5], text, n );
+}
+
+/*******************************************************************************/
+void dlistLine( dlist *dl, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t ink )
+{
+    uint8_t *cmd;
+
+    cmd = dlistReserve( dl, 6U );
+    if( cmd == NULL )
+    {
+        return;
+    }
+
+    cmd[0] = DLIST_OP_LINE;
+    cmd[1] = x0;
+    cmd[2] = y0;
+    cmd[3] = x1;
+    cmd[4] = y1;
+    cmd[5] = ink;
+}
+
+/*******************************************************************************/
+void dlistRect( dlist *dl, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style )
+{
+    uint8_t *cmd;
+
+    cmd = dlistReserve( dl, 6U );
+    if( cmd == NULL )
+    {
+        return;
+    }
+
+    cmd[0] = DLIST_OP_RECT;
+    cmd[1] = x;
+    cmd[2] = y;
+    cmd[3] = w;
+    cmd[4] = h;
+    cmd[5] = style;
+}
+
+/*******************************************************************************/
+void dlistSprite( dlist *dl, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t ink, const uint8_t *bits )
+{
+    uint8_t *cmd;
+    uint16_t n;
+
+    n   = (uint16_t)(((w + 7U) / 8U) * h);
+    cmd = dlistReserve( dl, (uint16_t)(6U + n) );
+    if( cmd == NULL )
+    {
+        return;
+    }
+
+    cmd[0] = DLIST_OP_SPRITE;
+    cmd[1] = x;
+    cmd[2] = y;
+    cmd[3] = w;
+    cmd[4] = h;
+    cmd[5] = ink;
+    ST_MEMCPY( &cmd[6], bits, n );
+}
+
+/*******************************************************************************/
+void dlistQr( dlist *dl, uint8_t x, uint8_t y, uint8_t scale, uint8_t n, const uint8_t *modules )
+{
+    uint8_t *cmd;
+    uint16_t len;
+
+    len = (uint16_t)(((uint32_t)n * n + 7U) / 8U);
+    cmd = dlistReserve( dl, (uint16_t)(5U + len) );
+    if( cmd == NULL )
+    {
+        return;
+    }
+
+    cmd[0] = DLIST_OP_QR;
+    cmd[1] = x;
+    cmd[2] = y;
+    cmd[3] = scale;
+    cmd[4] = n;
+    ST_MEMCPY( &cmd[5], modules, len );
+}
+
+/*******************************************************************************/
+ReturnCode dlistEnd( dlist *dl, uint16_t *len )
+{
+    *len = 0U;
+    if( dl->overflow )
+    {
+        return ERR_NOMEM;
+    }
+
+    dl->buf[dl->len++] = DLIST_OP_END;
+    *len = dl->len;
+    return ERR_NONE;
+}
@@ -0,0 +1,204 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame source streaming an image file from the SD card
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_file.h"
+#include "utils.h"
+#include <stdio.h>
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode frameFileLoadSlot( frameFile *file, uint8_t slot, uint8_t *bufIdx );
+static ReturnCode frameFileGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData );
+static void       frameFilePrefetch( frameSource *src, uint16_t blockNo );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode frameFileLoadSlot( frameFile *file, uint8_t slot, uint8_t *bufIdx )
+{
+    UINT    br;
+    uint8_t idx;
+
+    idx = (slot % FRAME_FILE_BUFS);
+
+    if( file->slot[idx] == (int16_t)slot )
+    {
+        *bufIdx = idx;
+        return ERR_NONE;
+    }
+
+    file->slot[idx] = -1;
+
+    if( f_lseek( &file->fil, ((DWORD)slot * FRAME_SLOT_LEN) ) != FR_OK )
+    {
+        return ERR_IO;
+    }
+    if( f_read( &file->fil, file->buf[idx], FRAME_SLOT_LEN, &br ) != FR_OK )
+    {
+        return ERR_IO;
+    }
+
+    /* Last slot may be short: pad with white */
+    if( br < FRAME_SLOT_LEN )
+    {
+        ST_MEMSET( &file->buf[idx][br], 0xFF, (FRAME_SLOT_LEN - br) );
+    }
+
+    file->slot[idx] = (int16_t)slot;
+    *bufIdx = idx;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode frameFileGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData )
+{
+    ReturnCode err;
+    frameFile *file;
+    uint8_t    idx;
+
+    file = (frameFile*)src->ctx;
+
+    EXIT_ON_ERR( err, frameFileLoadSlot( file, frameSourceSlot( blockNo ), &idx ) );
+
+    *blockData = &file->buf[idx][(uint16_t)frameSourceSlotBlock( blockNo ) * FRAME_BLOCK_LEN];
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static void frameFilePrefetch( frameSource *src, uint16_t blockNo )
+{
+    uint8_t idx;
+
+    /* A failed prefetch is retried synchronously by frameFileGetBlock() */
+    frameFileLoadSlot( (frameFile*)src->ctx, frameSourceSlot( blockNo ), &idx );
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode frameSourceInitFile( frameSource *src, frameFile *file, const TCHAR *path )
+{
+    uint8_t i;
+
+    if( (src == NULL) || (file == NULL) || (path == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( file->isOpen )
+    {
+        f_close( &file->fil );
+        file->isOpen = false;
+    }
+
+    for( i = 0U; i < FRAME_FILE_BUFS; i++ )
+    {
+        file->slot[i] = -1;
+    }
+
+    if( f_open( &file->fil, path, (FA_OPEN_EXISTING | FA_READ) ) != FR_OK )
+    {
+        return ERR_IO;
+    }
+    file->isOpen = true;
+
+    if( f_size( &file->fil ) != FRAME_LEN )
+    {
+        f_close( &file->fil );
+        file->isOpen = false;
+        return ERR_PARAM;
+    }
+
+    snprintf( file->path, FRAME_FILE_PATH_LEN, "%s", path );
+
+    src->len      = FRAME_LEN;
+    src->getBlock = frameFileGetBlock;
+    src->prefetch = frameFilePrefetch;
+    src->mem      = NULL;
+    src->ctx      = file;
+    src->seekable = true;
+
+    /* Have the first slot ready before the first tag shows up */
+    frameFilePrefetch( src, 0U );
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode frameFileOpenNext( frameSource *src, frameFile *file, DIR *dir, const TCHAR *dirPath )
+{
+    FILINFO fno;
+    TCHAR   path[FRAME_FILE_PATH_LEN];
+    bool    wrapped;
+
+    if( (src == NULL) || (file == NULL) || (dir == NULL) || (dirPath == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( dir->fs == NULL )
+    {
+        if( f_opendir( dir, dirPath ) != FR_OK )
+        {
+            return ERR_IO;
+        }
+    }
+
+#if _USE_LFN
+    fno.lfname = NULL;                                 /* 8.3 names are enough for the library   */
+    fno.lfsize = 0U;
+#endif /* _USE_LFN */
+
+    wrapped = false;
+    for(;;)
+    {
+        if( f_readdir( dir, &fno ) != FR_OK )
+        {
+            return ERR_IO;
+        }
+
+        if( fno.fname[0] == 0 )
+        {
+            /* End of directory: rewind once, give up if it holds no image at all */
+            if( wrapped )
+            {
+                return ERR_NOTFOUND;
+            }
+            wrapped = true;
+            f_readdir( dir, NULL );
+            continue;
+        }
+
+        if( ((fno.fattrib & AM_DIR) != 0U) || (fno.fsize != FRAME_LEN) )
+        {
+            continue;
+        }
+
+        snprintf( path, sizeof(path), "%s/%s", dirPath, fno.fname );
+        if( frameSourceInitFile( src, file, path ) == ERR_NONE )
+        {
+            return ERR_NONE;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame source implementation
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_source.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode frameSourceMemGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode frameSourceMemGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData )
+{
+    uint32_t offset;
+    uint32_t remaining;
+
+    offset    = ((uint32_t)blockNo * FRAME_BLOCK_LEN);
+    remaining = (src->len - offset);
+
+    if( remaining >= FRAME_BLOCK_LEN )
+    {
+        *blockData = &src->mem[offset];
+        return ERR_NONE;
+    }
+
+    /* Trailing partial block: pad with white */
+    ST_MEMSET( src->pad, 0xFF, FRAME_BLOCK_LEN );
+    ST_MEMCPY( src->pad, &src->mem[offset], remaining );
+    *blockData = src->pad;
+    return ERR_NONE;
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode frameSourceInitMem( frameSource *src, const uint8_t *frame, uint32_t len )
+{
+    if( (src == NULL) || (frame == NULL) || (len == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    src->len      = len;
+    src->getBlock = frameSourceMemGetBlock;
+    src->prefetch = NULL;
+    src->mem      = frame;
+    src->ctx      = NULL;
+    src->seekable = true;
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+uint16_t frameSourceBlockCount( const frameSource *src )
+{
+    return (uint16_t)((src->len + FRAME_BLOCK_LEN - 1U) / FRAME_BLOCK_LEN);
+}
+
+/*******************************************************************************/
+ReturnCode frameSourceGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData )
+{
+    if( (src == NULL) || (src->getBlock == NULL) || (blockData == NULL) || (blockNo >= frameSourceBlockCount( src )) )
+    {
+        return ERR_PARAM;
+    }
+
+    return src->getBlock( src, blockNo, blockData );
+}
+
+/*******************************************************************************/
+void frameSourcePrefetch( frameSource *src, uint16_t blockNo )
+{
+    if( (src == NULL) || (src->prefetch == NULL) || (blockNo >= frameSourceBlockCount( src )) )
+    {
+        return;
+    }
+
+    src->prefetch( src, blockNo );
+}
+
+/*******************************************************************************/
+uint32_t frameSourceCrc32Update( uint32_t crc, const uint8_t *buf, uint32_t len )
+{
+    uint8_t bit;
+
+    /* Bitwise, the frame CRC is computed once per transfer: no table in flash */
+    while( len-- != 0U )
+    {
+        crc ^= *buf++;
+        for( bit = 0U; bit < 8U; bit++ )
+        {
+            crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ 0xEDB88320U) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************/
+ReturnCode frameSourceCrc32( frameSource *src, uint32_t *crc )
+{
+    ReturnCode     err;
+    const uint8_t *blkData;
+    uint32_t       remaining;
+    uint32_t       value;
+    uint16_t       blockNo;
+
+    if( (src == NULL) || (crc == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( !src->seekable )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    value     = 0xFFFFFFFFU;
+    remaining = src->len;
+    for( blockNo = 0U; blockNo < frameSourceBlockCount( src ); blockNo++ )
+    {
+        EXIT_ON_ERR( err, frameSourceGetBlock( src, blockNo, &blkData ) );
+
+        value      = frameSourceCrc32Update( value, blkData, MIN( remaining, FRAME_BLOCK_LEN ) );
+        remaining -= MIN( remaining, FRAME_BLOCK_LEN );
+    }
+
+    *crc = ~value;
+    return ERR_NONE;
+}
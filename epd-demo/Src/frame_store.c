@@ -0,0 +1,196 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Per tag record of the last delivered frame
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "frame_store.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define FRAME_STORE_MAGIC         0x46524D31U    /*!< "FRM1": record complete               */
+#define FRAME_STORE_RECORD_SIZE   (FRAME_STORE_RECORD_PAGES * FLASH_PAGE_SIZE)
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! Record header, placed right behind the frame and programmed last */
+typedef struct
+{
+    uint32_t magic;                                 /*!< FRAME_STORE_MAGIC once complete     */
+    uint32_t seq;                                   /*!< Write counter, oldest is replaced    */
+    uint32_t crc;                                   /*!< CRC-32 of the frame                  */
+    uint8_t  uid[FRAME_STORE_UID_LEN];              /*!< Tag UID                              */
+} frameStoreHeader;
+
+/*
+******************************************************************************
+* LOCAL MACROS
+******************************************************************************
+*/
+#define frameStoreRecord( idx )   (FRAME_STORE_BASE + ((uint32_t)(idx) * FRAME_STORE_RECORD_SIZE))
+#define frameStoreHdr( idx )      ((const frameStoreHeader*)(frameStoreRecord( idx ) + FRAME_LEN))
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode frameStoreProgram( uint32_t addr, const uint8_t *data );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode frameStoreProgram( uint32_t addr, const uint8_t *data )
+{
+    uint32_t word;
+
+    /* Little endian, so the flash content matches the byte order of data */
+    word = ((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+
+    return ((HAL_FLASH_Program( FLASH_TYPEPROGRAM_WORD, addr, word ) == HAL_OK) ? ERR_NONE : ERR_WRITE);
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+const uint8_t *frameStoreLookup( const uint8_t *uid, uint32_t *crc )
+{
+    const frameStoreHeader *hdr;
+    const uint8_t          *frame;
+    uint8_t                 i;
+
+    for( i = 0U; i < FRAME_STORE_RECORDS; i++ )
+    {
+        hdr = frameStoreHdr( i );
+        if( (hdr->magic != FRAME_STORE_MAGIC) || (ST_BYTECMP( hdr->uid, uid, FRAME_STORE_UID_LEN ) != 0) )
+        {
+            continue;
+        }
+
+        frame = (const uint8_t*)frameStoreRecord( i );
+        if( ~frameSourceCrc32Update( 0xFFFFFFFFU, frame, FRAME_LEN ) != hdr->crc )
+        {
+            return NULL;                            /* Damaged record, tag gets a full frame  */
+        }
+
+        *crc = hdr->crc;
+        return frame;
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************/
+ReturnCode frameStoreSave( const uint8_t *uid, frameSource *src, uint32_t crc )
+{
+    FLASH_EraseInitTypeDef  erase;
+    const frameStoreHeader *hdr;
+    const uint8_t          *blkData;
+    frameStoreHeader        newHdr;
+    uint32_t                pageErr;
+    uint32_t                addr;
+    uint32_t                maxSeq;
+    uint16_t                blockNo;
+    uint8_t                 slot;
+    uint8_t                 unused;
+    uint8_t                 oldest;
+    uint8_t                 i;
+    ReturnCode              err;
+
+    if( (uid == NULL) || (src == NULL) || !src->seekable || (src->len != FRAME_LEN) )
+    {
+        return ERR_PARAM;
+    }
+
+    /* Same tag first, then an unused record, then the oldest one */
+    slot    = FRAME_STORE_RECORDS;
+    unused  = FRAME_STORE_RECORDS;
+    oldest  = FRAME_STORE_RECORDS;
+    maxSeq  = 0U;
+    for( i = 0U; i < FRAME_STORE_RECORDS; i++ )
+    {
+        hdr = frameStoreHdr( i );
+        if( hdr->magic != FRAME_STORE_MAGIC )
+        {
+            unused = ((unused == FRAME_STORE_RECORDS) ? i : unused);
+            continue;
+        }
+
+        if( ST_BYTECMP( hdr->uid, uid, FRAME_STORE_UID_LEN ) == 0 )
+        {
+            slot = i;
+        }
+        if( (oldest == FRAME_STORE_RECORDS) || ((int32_t)(hdr->seq - frameStoreHdr( oldest )->seq) < 0) )
+        {
+            oldest = i;
+        }
+        maxSeq = MAX( maxSeq, hdr->seq );
+    }
+
+    if( slot == FRAME_STORE_RECORDS )
+    {
+        slot = ((unused != FRAME_STORE_RECORDS) ? unused : oldest);
+    }
+
+    ST_MEMSET( &newHdr, 0x00, sizeof(newHdr) );
+    newHdr.magic = FRAME_STORE_MAGIC;
+    newHdr.seq   = (maxSeq + 1U);
+    newHdr.crc   = crc;
+    ST_MEMCPY( newHdr.uid, uid, FRAME_STORE_UID_LEN );
+
+    HAL_FLASH_Unlock();
+
+    erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+    erase.Banks       = FLASH_BANK_1;
+    erase.PageAddress = frameStoreRecord( slot );
+    erase.NbPages     = FRAME_STORE_RECORD_PAGES;
+    err = ((HAL_FLASHEx_Erase( &erase, &pageErr ) == HAL_OK) ? ERR_NONE : ERR_WRITE);
+
+    addr = frameStoreRecord( slot );
+    for( blockNo = 0U; (err == ERR_NONE) && (blockNo < frameSourceBlockCount( src )); blockNo++ )
+    {
+        err = frameSourceGetBlock( src, blockNo, &blkData );
+        if( err == ERR_NONE )
+        {
+            err   = frameStoreProgram( addr, blkData );
+            addr += FRAME_BLOCK_LEN;
+        }
+    }
+
+    /* Header last, the magic word at its start only becomes valid at the very end */
+    for( i = sizeof(newHdr.magic); (err == ERR_NONE) && (i < sizeof(newHdr)); i += FRAME_BLOCK_LEN )
+    {
+        err = frameStoreProgram( (frameStoreRecord( slot ) + FRAME_LEN + i), &((const uint8_t*)&newHdr)[i] );
+    }
+    if( err == ERR_NONE )
+    {
+        err = frameStoreProgram( (frameStoreRecord( slot ) + FRAME_LEN), (const uint8_t*)&newHdr.magic );
+    }
+
+    HAL_FLASH_Lock();
+
+    return err;
+}
@@ -0,0 +1,177 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief RF output power adapted to the link quality
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "link_adapt.h"
+#include "rfal_dpo.h"
+#include "rfal_rf.h"
+#include "rfal_chip.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define LINK_ADAPT_HOLD           ((LINK_ADAPT_RAISE + LINK_ADAPT_LOWER) / 2U)  /*!< Score keeping the power */
+#define LINK_ADAPT_RSSI_NONE      0xFFFFU        /*!< No RSSI seen in the window                */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+/*! RFO driver resistance per step, full power first. The NFC-V modulated
+ *  level stays fixed, so the steps are kept small to keep the modulation depth. */
+static rfalDpoEntry linkAdaptTbl[] = {
+    { 0x00U, LINK_ADAPT_RAISE, LINK_ADAPT_LOWER },
+    { 0x01U, LINK_ADAPT_RAISE, LINK_ADAPT_LOWER },
+    { 0x02U, LINK_ADAPT_RAISE, LINK_ADAPT_LOWER },
+    { 0x03U, LINK_ADAPT_RAISE, LINK_ADAPT_LOWER },
+    { 0x05U, LINK_ADAPT_RAISE, LINK_ADAPT_LOWER }
+};
+
+static uint8_t  linkAdaptBlocks;                    /*!< Writes in the current window             */
+static uint8_t  linkAdaptErrors;                    /*!< Writes that needed a retry or failed     */
+static uint16_t linkAdaptRssiMin;                   /*!< Weakest answer in the window [mV]        */
+static uint8_t  linkAdaptClean;                     /*!< Clean windows since the last step        */
+static uint8_t  linkAdaptHoldoff;                   /*!< Clean windows needed to step down        */
+static bool     linkAdaptLowered;                   /*!< Last step lowered the power              */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode linkAdaptScore( uint8_t *score );
+static void       linkAdaptDecide( void );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode linkAdaptScore( uint8_t *score )
+{
+    bool strong;
+
+    strong = ((linkAdaptRssiMin != LINK_ADAPT_RSSI_NONE) && (linkAdaptRssiMin >= LINK_ADAPT_RSSI_STRONG));
+
+    if( (linkAdaptErrors != 0U) && strong )
+    {
+        *score = 0U;                                /* Errors on strong answers: overcoupled */
+    }
+    else if( linkAdaptErrors != 0U )
+    {
+        *score = (uint8_t)(LINK_ADAPT_RAISE + (((uint16_t)linkAdaptErrors * (0xFFU - LINK_ADAPT_RAISE)) / linkAdaptBlocks));
+    }
+    else if( (linkAdaptClean >= linkAdaptHoldoff) && (strong || (linkAdaptRssiMin == LINK_ADAPT_RSSI_NONE)) )
+    {
+        *score = 0U;
+    }
+    else
+    {
+        *score = (uint8_t)LINK_ADAPT_HOLD;
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static void linkAdaptDecide( void )
+{
+    const rfalDpoEntry *prev;
+    const rfalDpoEntry *now;
+
+    linkAdaptClean = ((linkAdaptErrors == 0U) ? (uint8_t)MIN( (linkAdaptClean + 1U), 0xFFU ) : 0U);
+
+    prev = rfalDpoGetCurrentTableEntry();
+    rfalDpoAdjust();
+    now  = rfalDpoGetCurrentTableEntry();
+
+    if( now < prev )
+    {
+        /* Had to take the last step down back: wait longer before the next try */
+        if( linkAdaptLowered )
+        {
+            linkAdaptHoldoff = (uint8_t)MIN( (linkAdaptHoldoff * 2U), LINK_ADAPT_HOLDOFF_MAX );
+        }
+        linkAdaptLowered = false;
+        linkAdaptClean   = 0U;
+    }
+    else if( now > prev )
+    {
+        linkAdaptLowered = true;
+        linkAdaptClean   = 0U;
+    }
+    else
+    {
+        /* Power kept */
+    }
+
+    linkAdaptBlocks  = 0U;
+    linkAdaptErrors  = 0U;
+    linkAdaptRssiMin = LINK_ADAPT_RSSI_NONE;
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void linkAdaptReset( void )
+{
+    rfalDpoInitialize();
+    rfalDpoTableWrite( linkAdaptTbl, (uint8_t)SIZEOF_ARRAY( linkAdaptTbl ) );
+    rfalDpoSetMeasureCallback( linkAdaptScore );
+    rfalDpoSetEnabled( true );
+    rfalChipSetRFO( linkAdaptTbl[0].rfoRes );
+
+    linkAdaptBlocks  = 0U;
+    linkAdaptErrors  = 0U;
+    linkAdaptRssiMin = LINK_ADAPT_RSSI_NONE;
+    linkAdaptClean   = 0U;
+    linkAdaptHoldoff = LINK_ADAPT_HOLDOFF_MIN;
+    linkAdaptLowered = false;
+}
+
+/*******************************************************************************/
+void linkAdaptBlock( bool retried, ReturnCode err )
+{
+    uint16_t rssi;
+
+    linkAdaptBlocks++;
+    if( retried || (err != ERR_NONE) )
+    {
+        linkAdaptErrors++;
+    }
+
+    if( (err == ERR_NONE) && (rfalGetTransceiveRSSI( &rssi ) == ERR_NONE) )
+    {
+        linkAdaptRssiMin = MIN( linkAdaptRssiMin, rssi );
+    }
+
+    if( (err != ERR_NONE) || (linkAdaptBlocks >= LINK_ADAPT_WINDOW) )
+    {
+        linkAdaptDecide();
+    }
+}
+
+/*******************************************************************************/
+uint8_t linkAdaptGetRfo( void )
+{
+    return rfalDpoGetCurrentTableEntry()->rfoRes;
+}
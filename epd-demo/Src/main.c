@@ -29,6 +29,10 @@
 /* USER CODE BEGIN Includes */
 #include "stdio.h"
 #include "demo.h"
+#include "frame_source.h"
+#include "frame_file.h"
+#include "uart_stream.h"
+#include "boot_profile.h"
 #include "platform.h"
 #include "logger.h"
 #include "st_errno.h"
@@ -53,7 +57,7 @@ uint8_t globalCommProtectCnt = 0;
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-uint8_t nfcbuf[5000] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
+const uint8_t nfcbuf[FRAME_LEN] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XF0,0X1F,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XE0,0X40,0X0F,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
@@ -368,7 +372,7 @@ uint8_t nfcbuf[5000] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
 0XFF,0XFF,0XFF,0XFF,0XFF,0XE3,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,};
 
-uint8_t nfcbuf2[5000] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
+const uint8_t nfcbuf2[FRAME_LEN] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
@@ -683,7 +687,14 @@ uint8_t nfcbuf2[5000] = { /* 0X00,0X01,0XC8,0X00,0XC8,0X00, */
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
 };
-	
+
+static frameSource frame1;
+static frameSource frame2;
+static frameSource frameSd;
+static frameSource frameUart;
+static frameFile   imgFile;
+static DIR         imgDir;
+static bool        sdMounted = false;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -720,6 +731,7 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  bootProfileStart();
 
   /* USER CODE END SysInit */
 
@@ -732,6 +744,26 @@ int main(void)
   MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
   SpiInit(&hspi1);
+  bootProfileMark("peripherals");
+
+  frameSourceInitMem(&frame1, nfcbuf, sizeof(nfcbuf));
+  frameSourceInitMem(&frame2, nfcbuf2, sizeof(nfcbuf2));
+  demoSetFrameSource(&frame1);
+
+  /* Host upload over the console UART, see Tools/epd_send.c */
+  uartStreamInit();
+
+  /* Image library on the SD card: 0:/IMG, raw 5000 byte frames */
+  if (f_mount(&USERFatFS, USERPath, 1) == FR_OK)
+  {
+    sdMounted = true;
+    printf("SD card mounted\r\n");
+  }
+  else
+  {
+    printf("No SD card, using built-in images\r\n");
+  }
+  bootProfileMark("sd mount");
 
   printf("Welcome to X-NUCLEO-NFC05A1\r\n");
 
@@ -739,6 +771,8 @@ int main(void)
   /* USER CODE END 2 */
   if (!demoIni())
   {
+    bootProfileMark("rfal init");
+    bootProfilePrint();
     /*
     * in case the rfal initalization failed signal it by flashing all LED
     * and stoping all operations
@@ -752,6 +786,7 @@ int main(void)
   }
   else
   {
+    bootProfileMark("rfal init");
     printf("Initialization succeeded..\r\n");
     for (int i = 0; i < 6; i++)
     {
@@ -759,24 +794,63 @@ int main(void)
       platformDelay(200);
     }
     platformLedOff(PLATFORM_LED_V_PORT, PLATFORM_LED_V_PIN);
+    bootProfileMark("led blink");
+    bootProfilePrint();
   }
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
     /* USER CODE END WHILE */
-		if(HAL_GPIO_ReadPin(KEY_DOWN_GPIO_Port, KEY_DOWN_Pin) == GPIO_PIN_RESET)
+		if(uartStreamProcess() == UART_STREAM_EVT_START)
+		{
+		  frameSourceInitUart(&frameUart);
+		  demoSetFrameSource(&frameUart);
+		}
+
+		/* KEY_DOWN + KEY_OK: push the current frame to every tag in the field */
+		if((HAL_GPIO_ReadPin(KEY_DOWN_GPIO_Port, KEY_DOWN_Pin) == GPIO_PIN_RESET) && (HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET))
+		{
+		  demoFleetUpdate();
+		  while((HAL_GPIO_ReadPin(KEY_DOWN_GPIO_Port, KEY_DOWN_Pin) == GPIO_PIN_RESET) || (HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET));
+		}
+		/* KEY_UP + KEY_OK: send every tag in the field a label built as a display list */
+		else if((HAL_GPIO_ReadPin(KEY_UP_GPIO_Port, KEY_UP_Pin) == GPIO_PIN_RESET) && (HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET))
+		{
+		  demoFleetLabel();
+		  /* KEY_UP alone selects frame1: wait until both are released */
+		  while((HAL_GPIO_ReadPin(KEY_UP_GPIO_Port, KEY_UP_Pin) == GPIO_PIN_RESET) || (HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET));
+		}
+		/* An uploaded frame is sent to the next tag without holding KEY_DOWN */
+		else if(DEMO_SERVICE_MODE || (HAL_GPIO_ReadPin(KEY_DOWN_GPIO_Port, KEY_DOWN_Pin) == GPIO_PIN_RESET) || uartStreamActive())
 		{
 		  demoCycle();
 		}
 		
 		if(HAL_GPIO_ReadPin(KEY_UP_GPIO_Port, KEY_UP_Pin) == GPIO_PIN_RESET)
 		{
-		  nfcBufInit();//初始化三维数组
+		  demoSetFrameSource(&frame1);
+		  while(HAL_GPIO_ReadPin(KEY_UP_GPIO_Port, KEY_UP_Pin) == GPIO_PIN_RESET);
 		}
 		if(HAL_GPIO_ReadPin(KEY_BACK_GPIO_Port, KEY_BACK_Pin) == GPIO_PIN_RESET)
 		{
-		  nfcBuf2Init();//初始化三维数组
+		  demoSetFrameSource(&frame2);
+		  while(HAL_GPIO_ReadPin(KEY_BACK_GPIO_Port, KEY_BACK_Pin) == GPIO_PIN_RESET);
+		}
+		if(sdMounted && (HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET))
+		{
+		  if(frameFileOpenNext(&frameSd, &imgFile, &imgDir, "0:/IMG") == ERR_NONE)
+		  {
+		    printf("Image: %s\r\n", imgFile.path);
+		    demoSetFrameSource(&frameSd);
+		  }
+		  while(HAL_GPIO_ReadPin(KEY_OK_GPIO_Port, KEY_OK_Pin) == GPIO_PIN_RESET);
+		}
+
+		/* Nothing near the reader: sleep until the next wake-up measurement */
+		if(DEMO_SERVICE_MODE && !uartStreamActive())
+		{
+		  demoIdle();
 		}
     
     /* USER CODE BEGIN 3 */
@@ -0,0 +1,214 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Frame delivery as a standard NDEF image record
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "ndef_image.h"
+#include "ndef_poller.h"
+#include "ndef_message.h"
+#include "ndef_types_mime.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define NDEF_IMAGE_RUN_MIN        3U      /*!< Shorter runs stay in literal packets */
+#define NDEF_IMAGE_PACKET_MAX     128U    /*!< Bytes per PackBits packet            */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+static ndefContext ndefImageCtx;                          /*!< NDEF context of the tag being written */
+static uint8_t     ndefImageBuf[NDEF_IMAGE_PACK_LEN];     /*!< Compressed frame                      */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode ndefImageByte( frameSource *src, uint32_t pos, uint8_t *val );
+static ReturnCode ndefImageRun( frameSource *src, uint32_t pos, uint32_t *runLen );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode ndefImageByte( frameSource *src, uint32_t pos, uint8_t *val )
+{
+    ReturnCode     err;
+    const uint8_t *blkData;
+
+    EXIT_ON_ERR( err, frameSourceGetBlock( src, (uint16_t)(pos / FRAME_BLOCK_LEN), &blkData ) );
+
+    *val = blkData[pos % FRAME_BLOCK_LEN];
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefImageRun( frameSource *src, uint32_t pos, uint32_t *runLen )
+{
+    ReturnCode err;
+    uint8_t    first;
+    uint8_t    val;
+    uint32_t   len;
+
+    EXIT_ON_ERR( err, ndefImageByte( src, pos, &first ) );
+
+    for( len = 1U; ((pos + len) < src->len) && (len < NDEF_IMAGE_PACKET_MAX); len++ )
+    {
+        EXIT_ON_ERR( err, ndefImageByte( src, (pos + len), &val ) );
+        if( val != first )
+        {
+            break;
+        }
+    }
+
+    *runLen = len;
+    return ERR_NONE;
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode ndefImagePack( frameSource *src, uint8_t *buf, uint32_t bufLen, uint32_t *outLen )
+{
+    ReturnCode err;
+    uint32_t   pos;
+    uint32_t   out;
+    uint32_t   hdr;
+    uint32_t   run;
+    uint8_t    val;
+
+    if( (src == NULL) || (buf == NULL) || (outLen == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( !src->seekable )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    pos = 0U;
+    out = 0U;
+    while( pos < src->len )
+    {
+        EXIT_ON_ERR( err, ndefImageRun( src, pos, &run ) );
+        EXIT_ON_ERR( err, ndefImageByte( src, pos, &val ) );
+
+        if( run >= NDEF_IMAGE_RUN_MIN )
+        {
+            if( (out + 2U) > bufLen )
+            {
+                return ERR_NOMEM;
+            }
+            buf[out++] = (uint8_t)(257U - run);
+            buf[out++] = val;
+            pos       += run;
+            continue;
+        }
+
+        /* Literal packet up to the next run worth encoding */
+        hdr = out++;
+        do
+        {
+            if( out >= bufLen )
+            {
+                return ERR_NOMEM;
+            }
+            EXIT_ON_ERR( err, ndefImageByte( src, pos, &buf[out++] ) );
+            pos++;
+            if( pos >= src->len )
+            {
+                break;
+            }
+            EXIT_ON_ERR( err, ndefImageRun( src, pos, &run ) );
+        }
+        while( (run < NDEF_IMAGE_RUN_MIN) && ((out - hdr - 1U) < NDEF_IMAGE_PACKET_MAX) );
+        buf[hdr] = (uint8_t)(out - hdr - 2U);
+    }
+
+    *outLen = out;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode ndefImageWrite( const rfalNfcDevice *dev, frameSource *src )
+{
+    ReturnCode       err;
+    ndefInfo         info;
+    ndefType         media;
+    ndefRecord       record;
+    ndefMessage      message;
+    ndefMessageInfo  msgInfo;
+    ndefConstBuffer8 bufType;
+    ndefConstBuffer  bufPayload;
+    uint32_t         packLen;
+
+    if( (dev == NULL) || (src == NULL) || (src->len != FRAME_LEN) )
+    {
+        return ERR_PARAM;
+    }
+
+    EXIT_ON_ERR( err, ndefPollerContextInitialization( &ndefImageCtx, dev ) );
+
+    /* No CC: never formatted, or a slot transfer overwrote it */
+    err = ndefPollerNdefDetect( &ndefImageCtx, &info );
+    if( (err != ERR_NONE) || (info.state == NDEF_STATE_INVALID) )
+    {
+        EXIT_ON_ERR( err, ndefPollerTagFormat( &ndefImageCtx, NULL, 0U ) );
+    }
+    else if( info.state == NDEF_STATE_READONLY )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    err = ndefImagePack( src, ndefImageBuf, sizeof(ndefImageBuf), &packLen );
+    if( err == ERR_NONE )
+    {
+        bufType.buffer    = (const uint8_t*)NDEF_IMAGE_TYPE_PACKBITS;
+        bufType.length    = (uint8_t)(sizeof(NDEF_IMAGE_TYPE_PACKBITS) - 1U);
+        bufPayload.buffer = ndefImageBuf;
+        bufPayload.length = packLen;
+    }
+    else if( (err == ERR_NOMEM) && (src->mem != NULL) )
+    {
+        /* Hard to compress, e.g. dithered: sent as it is from flash */
+        bufType.buffer    = (const uint8_t*)NDEF_IMAGE_TYPE_RAW;
+        bufType.length    = (uint8_t)(sizeof(NDEF_IMAGE_TYPE_RAW) - 1U);
+        bufPayload.buffer = src->mem;
+        bufPayload.length = src->len;
+    }
+    else
+    {
+        return err;
+    }
+
+    EXIT_ON_ERR( err, ndefMedia( &media, &bufType, &bufPayload ) );
+    EXIT_ON_ERR( err, ndefMediaToRecord( &media, &record ) );
+    EXIT_ON_ERR( err, ndefMessageInit( &message ) );
+    EXIT_ON_ERR( err, ndefMessageAppend( &message, &record ) );
+    EXIT_ON_ERR( err, ndefMessageGetInfo( &message, &msgInfo ) );
+    EXIT_ON_ERR( err, ndefPollerCheckAvailableSpace( &ndefImageCtx, msgInfo.length ) );
+
+    return ndefPollerWriteMessage( &ndefImageCtx, &message );
+}
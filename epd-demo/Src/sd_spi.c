@@ -0,0 +1,570 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief SD card driver in SPI mode on SPI2
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "sd_spi.h"
+#include "spi.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define SD_CMD0               0U      /*!< GO_IDLE_STATE                            */
+#define SD_CMD1               1U      /*!< SEND_OP_COND (MMC)                       */
+#define SD_CMD8               8U      /*!< SEND_IF_COND                             */
+#define SD_CMD9               9U      /*!< SEND_CSD                                 */
+#define SD_CMD12              12U     /*!< STOP_TRANSMISSION                        */
+#define SD_CMD16              16U     /*!< SET_BLOCKLEN                             */
+#define SD_CMD17              17U     /*!< READ_SINGLE_BLOCK                        */
+#define SD_CMD18              18U     /*!< READ_MULTIPLE_BLOCK                      */
+#define SD_CMD23              23U     /*!< SET_WR_BLK_ERASE_COUNT (with ACMD prefix)*/
+#define SD_CMD24              24U     /*!< WRITE_BLOCK                              */
+#define SD_CMD25              25U     /*!< WRITE_MULTIPLE_BLOCK                     */
+#define SD_CMD41              41U     /*!< SD_SEND_OP_COND (with ACMD prefix)       */
+#define SD_CMD55              55U     /*!< APP_CMD                                  */
+#define SD_CMD58              58U     /*!< READ_OCR                                 */
+#define SD_ACMD               0x80U   /*!< Flag: send CMD55 first                   */
+
+#define SD_R1_IDLE            0x01U   /*!< R1: in idle state                        */
+#define SD_TOKEN_START        0xFEU   /*!< Start token for single/multi read, CMD24 */
+#define SD_TOKEN_START_MULTI  0xFCU   /*!< Start token for CMD25                    */
+#define SD_TOKEN_STOP_MULTI   0xFDU   /*!< Stop token for CMD25                     */
+#define SD_DATA_ACCEPTED      0x05U   /*!< Data response: accepted                  */
+
+#define SD_TYPE_NONE          0x00U   /*!< No card                                  */
+#define SD_TYPE_MMC           0x01U   /*!< MMC v3                                   */
+#define SD_TYPE_SD1           0x02U   /*!< SD v1                                    */
+#define SD_TYPE_SD2           0x04U   /*!< SD v2, byte addressing                   */
+#define SD_TYPE_BLOCK         0x08U   /*!< Block addressing (SDHC/SDXC)             */
+
+#define SD_INIT_TIMEOUT       1000U   /*!< ACMD41 idle exit timeout [ms]            */
+#define SD_TOKEN_TIMEOUT      200U    /*!< Read data token timeout [ms]             */
+#define SD_BUSY_TIMEOUT       500U    /*!< Write busy timeout [ms]                  */
+#define SD_DMA_TIMEOUT        50U     /*!< One sector DMA transfer timeout [ms]     */
+#define SD_BYTE_TIMEOUT       10U     /*!< Single byte polling transfer [ms]        */
+
+#define SD_SPI_PRESC_INIT     SPI_BAUDRATEPRESCALER_128  /*!< 36MHz/128 = 281kHz, below 400kHz */
+#define SD_SPI_PRESC_FAST     SPI_BAUDRATEPRESCALER_2    /*!< 36MHz/2   = 18MHz                */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+static uint8_t           sdType = SD_TYPE_NONE;      /*!< Detected card type                 */
+static volatile uint8_t  sdDmaDone;                  /*!< Set from the SPI2 DMA callbacks    */
+static volatile uint8_t  sdDmaError;                 /*!< Set from the SPI2 error callback   */
+static const uint8_t     sdDummy = 0xFFU;            /*!< Idle pattern clocked out on reads  */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static void       sdSpiSetSpeed( uint32_t prescaler );
+static uint8_t    sdSpiXchg( uint8_t data );
+static void       sdSpiSelect( void );
+static void       sdSpiDeselect( void );
+static ReturnCode sdSpiWaitReady( uint32_t timeout );
+static uint8_t    sdSpiCmd( uint8_t cmd, uint32_t arg );
+static ReturnCode sdSpiDmaWait( void );
+static ReturnCode sdSpiRxBlock( uint8_t *buf, uint16_t len );
+static ReturnCode sdSpiTxBlock( const uint8_t *buf, uint8_t token );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void sdSpiSetSpeed( uint32_t prescaler )
+{
+    __HAL_SPI_DISABLE( &hspi2 );
+    MODIFY_REG( hspi2.Instance->CR1, SPI_CR1_BR, prescaler );
+    hspi2.Init.BaudRatePrescaler = prescaler;
+    __HAL_SPI_ENABLE( &hspi2 );
+}
+
+/*******************************************************************************/
+static uint8_t sdSpiXchg( uint8_t data )
+{
+    uint8_t rx = 0xFFU;
+
+    HAL_SPI_TransmitReceive( &hspi2, &data, &rx, 1U, SD_BYTE_TIMEOUT );
+    return rx;
+}
+
+/*******************************************************************************/
+static void sdSpiSelect( void )
+{
+    spiSelect( SD_CS_GPIO_Port, SD_CS_Pin );
+    sdSpiXchg( 0xFFU );                                /* Dummy clock to start the card's output */
+}
+
+/*******************************************************************************/
+static void sdSpiDeselect( void )
+{
+    spiDeselect( SD_CS_GPIO_Port, SD_CS_Pin );
+    sdSpiXchg( 0xFFU );                                /* Dummy clock to release DO              */
+}
+
+/*******************************************************************************/
+static ReturnCode sdSpiWaitReady( uint32_t timeout )
+{
+    uint32_t start = platformGetSysTick();
+
+    do
+    {
+        if( sdSpiXchg( 0xFFU ) == 0xFFU )
+        {
+            return ERR_NONE;
+        }
+    }
+    while( (platformGetSysTick() - start) < timeout );
+
+    return ERR_TIMEOUT;
+}
+
+/*******************************************************************************/
+static uint8_t sdSpiCmd( uint8_t cmd, uint32_t arg )
+{
+    uint8_t frame[6];
+    uint8_t res;
+    uint8_t n;
+
+    if( (cmd & SD_ACMD) != 0U )
+    {
+        cmd &= (uint8_t)~SD_ACMD;
+        res = sdSpiCmd( SD_CMD55, 0U );
+        if( res > SD_R1_IDLE )
+        {
+            return res;
+        }
+    }
+
+    /* Select the card and wait for ready, except to stop a multiple block read */
+    if( cmd != SD_CMD12 )
+    {
+        sdSpiDeselect();
+        sdSpiSelect();
+        if( sdSpiWaitReady( SD_BUSY_TIMEOUT ) != ERR_NONE )
+        {
+            return 0xFFU;
+        }
+    }
+
+    frame[0] = (uint8_t)(0x40U | cmd);
+    frame[1] = (uint8_t)(arg >> 24U);
+    frame[2] = (uint8_t)(arg >> 16U);
+    frame[3] = (uint8_t)(arg >> 8U);
+    frame[4] = (uint8_t)(arg);
+    frame[5] = 0x01U;                                  /* Dummy CRC + stop bit                   */
+    if( cmd == SD_CMD0 ) { frame[5] = 0x95U; }         /* Valid CRC for CMD0(0)                  */
+    if( cmd == SD_CMD8 ) { frame[5] = 0x87U; }         /* Valid CRC for CMD8(0x1AA)              */
+
+    HAL_SPI_Transmit( &hspi2, frame, sizeof(frame), SD_BYTE_TIMEOUT );
+
+    if( cmd == SD_CMD12 )
+    {
+        sdSpiXchg( 0xFFU );                            /* Discard the stuff byte                 */
+    }
+
+    /* R1 comes within 8 bytes (Ncr) */
+    n = 10U;
+    do
+    {
+        res = sdSpiXchg( 0xFFU );
+    }
+    while( ((res & 0x80U) != 0U) && (--n != 0U) );
+
+    return res;
+}
+
+/*******************************************************************************/
+static ReturnCode sdSpiDmaWait( void )
+{
+    uint32_t start = platformGetSysTick();
+
+    while( sdDmaDone == 0U )
+    {
+        if( (platformGetSysTick() - start) > SD_DMA_TIMEOUT )
+        {
+            HAL_SPI_Abort( &hspi2 );
+            return ERR_TIMEOUT;
+        }
+    }
+
+    return ((sdDmaError != 0U) ? ERR_IO : ERR_NONE);
+}
+
+/*******************************************************************************/
+static ReturnCode sdSpiRxBlock( uint8_t *buf, uint16_t len )
+{
+    ReturnCode err;
+    uint32_t   start;
+    uint8_t    token;
+
+    start = platformGetSysTick();
+    do
+    {
+        token = sdSpiXchg( 0xFFU );
+    }
+    while( (token == 0xFFU) && ((platformGetSysTick() - start) < SD_TOKEN_TIMEOUT) );
+
+    if( token != SD_TOKEN_START )
+    {
+        return ERR_IO;
+    }
+
+    if( len == SD_SPI_SECTOR_LEN )
+    {
+        /* Clock out 0xFF from a single byte: TX channel must not increment */
+        CLEAR_BIT( hspi2.hdmatx->Instance->CCR, DMA_CCR_MINC );
+        sdDmaDone  = 0U;
+        sdDmaError = 0U;
+        if( HAL_SPI_TransmitReceive_DMA( &hspi2, (uint8_t*)&sdDummy, buf, len ) != HAL_OK )
+        {
+            return ERR_IO;
+        }
+        EXIT_ON_ERR( err, sdSpiDmaWait() );
+    }
+    else
+    {
+        /* Short registers (CSD) are not worth a DMA setup */
+        while( len-- != 0U )
+        {
+            *buf++ = sdSpiXchg( 0xFFU );
+        }
+    }
+
+    sdSpiXchg( 0xFFU );                                /* Discard CRC16                          */
+    sdSpiXchg( 0xFFU );
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode sdSpiTxBlock( const uint8_t *buf, uint8_t token )
+{
+    ReturnCode err;
+    uint8_t    resp;
+
+    if( sdSpiWaitReady( SD_BUSY_TIMEOUT ) != ERR_NONE )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    sdSpiXchg( token );
+    if( token == SD_TOKEN_STOP_MULTI )
+    {
+        return ERR_NONE;
+    }
+
+    SET_BIT( hspi2.hdmatx->Instance->CCR, DMA_CCR_MINC );
+    sdDmaDone  = 0U;
+    sdDmaError = 0U;
+    if( HAL_SPI_Transmit_DMA( &hspi2, (uint8_t*)buf, SD_SPI_SECTOR_LEN ) != HAL_OK )
+    {
+        return ERR_IO;
+    }
+    EXIT_ON_ERR( err, sdSpiDmaWait() );
+
+    sdSpiXchg( 0xFFU );                                /* Dummy CRC16                            */
+    sdSpiXchg( 0xFFU );
+
+    resp = sdSpiXchg( 0xFFU );
+    return (((resp & 0x1FU) == SD_DATA_ACCEPTED) ? ERR_NONE : ERR_IO);
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode sdSpiInit( void )
+{
+    uint8_t  ocr[4];
+    uint8_t  type;
+    uint8_t  cmd;
+    uint8_t  i;
+    uint32_t start;
+
+    sdType = SD_TYPE_NONE;
+    type   = SD_TYPE_NONE;
+
+    sdSpiSetSpeed( SD_SPI_PRESC_INIT );
+
+    /* At least 74 clocks with CS high to enter native mode */
+    spiDeselect( SD_CS_GPIO_Port, SD_CS_Pin );
+    for( i = 0U; i < 10U; i++ )
+    {
+        sdSpiXchg( 0xFFU );
+    }
+
+    if( sdSpiCmd( SD_CMD0, 0U ) == SD_R1_IDLE )
+    {
+        start = platformGetSysTick();
+
+        if( sdSpiCmd( SD_CMD8, 0x1AAU ) == SD_R1_IDLE )
+        {
+            /* SD v2: check voltage range echo */
+            for( i = 0U; i < 4U; i++ )
+            {
+                ocr[i] = sdSpiXchg( 0xFFU );
+            }
+
+            if( (ocr[2] == 0x01U) && (ocr[3] == 0xAAU) )
+            {
+                while( ((platformGetSysTick() - start) < SD_INIT_TIMEOUT) && (sdSpiCmd( (SD_ACMD | SD_CMD41), (1UL << 30U) ) != 0U) )
+                {
+                }
+
+                if( ((platformGetSysTick() - start) < SD_INIT_TIMEOUT) && (sdSpiCmd( SD_CMD58, 0U ) == 0U) )
+                {
+                    for( i = 0U; i < 4U; i++ )
+                    {
+                        ocr[i] = sdSpiXchg( 0xFFU );
+                    }
+                    type = (((ocr[0] & 0x40U) != 0U) ? (SD_TYPE_SD2 | SD_TYPE_BLOCK) : SD_TYPE_SD2);
+                }
+            }
+        }
+        else
+        {
+            /* SD v1 or MMC v3 */
+            if( sdSpiCmd( (SD_ACMD | SD_CMD41), 0U ) <= SD_R1_IDLE )
+            {
+                type = SD_TYPE_SD1;
+                cmd  = (SD_ACMD | SD_CMD41);
+            }
+            else
+            {
+                type = SD_TYPE_MMC;
+                cmd  = SD_CMD1;
+            }
+
+            while( ((platformGetSysTick() - start) < SD_INIT_TIMEOUT) && (sdSpiCmd( cmd, 0U ) != 0U) )
+            {
+            }
+
+            if( ((platformGetSysTick() - start) >= SD_INIT_TIMEOUT) || (sdSpiCmd( SD_CMD16, SD_SPI_SECTOR_LEN ) != 0U) )
+            {
+                type = SD_TYPE_NONE;
+            }
+        }
+    }
+
+    sdSpiDeselect();
+
+    if( type == SD_TYPE_NONE )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    sdType = type;
+    sdSpiSetSpeed( SD_SPI_PRESC_FAST );
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+bool sdSpiIsReady( void )
+{
+    return (sdType != SD_TYPE_NONE);
+}
+
+/*******************************************************************************/
+ReturnCode sdSpiReadBlocks( uint8_t *buf, uint32_t sector, uint32_t count )
+{
+    ReturnCode err;
+
+    if( sdType == SD_TYPE_NONE )
+    {
+        return ERR_WRONG_STATE;
+    }
+    if( (buf == NULL) || (count == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( (sdType & SD_TYPE_BLOCK) == 0U )
+    {
+        sector *= SD_SPI_SECTOR_LEN;                   /* Byte addressing on SDSC/MMC            */
+    }
+
+    err = ERR_IO;
+    if( count == 1U )
+    {
+        if( sdSpiCmd( SD_CMD17, sector ) == 0U )
+        {
+            err = sdSpiRxBlock( buf, SD_SPI_SECTOR_LEN );
+        }
+    }
+    else
+    {
+        if( sdSpiCmd( SD_CMD18, sector ) == 0U )
+        {
+            do
+            {
+                err  = sdSpiRxBlock( buf, SD_SPI_SECTOR_LEN );
+                buf += SD_SPI_SECTOR_LEN;
+            }
+            while( (err == ERR_NONE) && (--count != 0U) );
+
+            sdSpiCmd( SD_CMD12, 0U );
+        }
+    }
+
+    sdSpiDeselect();
+    return err;
+}
+
+/*******************************************************************************/
+ReturnCode sdSpiWriteBlocks( const uint8_t *buf, uint32_t sector, uint32_t count )
+{
+    ReturnCode err;
+
+    if( sdType == SD_TYPE_NONE )
+    {
+        return ERR_WRONG_STATE;
+    }
+    if( (buf == NULL) || (count == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( (sdType & SD_TYPE_BLOCK) == 0U )
+    {
+        sector *= SD_SPI_SECTOR_LEN;
+    }
+
+    err = ERR_IO;
+    if( count == 1U )
+    {
+        if( sdSpiCmd( SD_CMD24, sector ) == 0U )
+        {
+            err = sdSpiTxBlock( buf, SD_TOKEN_START );
+        }
+    }
+    else
+    {
+        if( (sdType & (SD_TYPE_SD1 | SD_TYPE_SD2)) != 0U )
+        {
+            sdSpiCmd( (SD_ACMD | SD_CMD23), count );   /* Pre-erase hint                         */
+        }
+
+        if( sdSpiCmd( SD_CMD25, sector ) == 0U )
+        {
+            do
+            {
+                err  = sdSpiTxBlock( buf, SD_TOKEN_START_MULTI );
+                buf += SD_SPI_SECTOR_LEN;
+            }
+            while( (err == ERR_NONE) && (--count != 0U) );
+
+            if( sdSpiTxBlock( NULL, SD_TOKEN_STOP_MULTI ) != ERR_NONE )
+            {
+                err = ERR_TIMEOUT;
+            }
+        }
+    }
+
+    sdSpiDeselect();
+    return err;
+}
+
+/*******************************************************************************/
+ReturnCode sdSpiSync( void )
+{
+    ReturnCode err;
+
+    sdSpiSelect();
+    err = sdSpiWaitReady( SD_BUSY_TIMEOUT );
+    sdSpiDeselect();
+
+    return err;
+}
+
+/*******************************************************************************/
+ReturnCode sdSpiGetSectorCount( uint32_t *sectors )
+{
+    ReturnCode err;
+    uint8_t    csd[16];
+    uint32_t   cSize;
+    uint8_t    n;
+
+    if( sdType == SD_TYPE_NONE )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    err = ERR_IO;
+    if( sdSpiCmd( SD_CMD9, 0U ) == 0U )
+    {
+        err = sdSpiRxBlock( csd, sizeof(csd) );
+    }
+    sdSpiDeselect();
+
+    if( err != ERR_NONE )
+    {
+        return err;
+    }
+
+    if( (csd[0] >> 6U) == 1U )
+    {
+        /* CSD v2.0: capacity = (C_SIZE + 1) * 512KB */
+        cSize    = ((uint32_t)(csd[7] & 0x3FU) << 16U) | ((uint32_t)csd[8] << 8U) | csd[9];
+        *sectors = ((cSize + 1U) << 10U);
+    }
+    else
+    {
+        /* CSD v1.0 / MMC: capacity = (C_SIZE + 1) << (C_SIZE_MULT + 2 + READ_BL_LEN) */
+        n        = (uint8_t)((csd[5] & 0x0FU) + ((csd[10] & 0x80U) >> 7U) + ((csd[9] & 0x03U) << 1U) + 2U);
+        cSize    = ((uint32_t)(csd[8] >> 6U)) | ((uint32_t)csd[7] << 2U) | ((uint32_t)(csd[6] & 0x03U) << 10U);
+        *sectors = ((cSize + 1U) << (n - 9U));
+    }
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+void HAL_SPI_TxRxCpltCallback( SPI_HandleTypeDef *hspi )
+{
+    if( hspi->Instance == SPI2 )
+    {
+        sdDmaDone = 1U;
+    }
+}
+
+/*******************************************************************************/
+void HAL_SPI_TxCpltCallback( SPI_HandleTypeDef *hspi )
+{
+    if( hspi->Instance == SPI2 )
+    {
+        sdDmaDone = 1U;
+    }
+}
+
+/*******************************************************************************/
+void HAL_SPI_ErrorCallback( SPI_HandleTypeDef *hspi )
+{
+    if( hspi->Instance == SPI2 )
+    {
+        sdDmaError = 1U;
+        sdDmaDone  = 1U;
+    }
+}
@@ -0,0 +1,443 @@
+/*! \file
+ *
+ *  \author
+ *
+ *  \brief Host to reader image upload over USART2
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "uart_stream.h"
+#include "usart.h"
+#include "rfal_crc.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+#define UART_STREAM_RX_LEN          512U    /*!< Circular DMA buffer length               */
+#define UART_STREAM_HDR_LEN         4U      /*!< type + seq + len                         */
+#define UART_STREAM_CRC_LEN         2U      /*!< CRC16 length                             */
+#define UART_STREAM_OFS_LEN         2U      /*!< DATA offset field length                 */
+#define UART_STREAM_PAYLOAD_MAX     (UART_STREAM_OFS_LEN + UART_STREAM_CHUNK_MAX)
+#define UART_STREAM_CRC_PRELOAD     0xFFFFU /*!< CRC16 preload value                      */
+#define UART_STREAM_PKT_TIMEOUT     100U    /*!< Drop a partial packet after [ms]         */
+#define UART_STREAM_TX_TIMEOUT      10U     /*!< ACK transmit timeout [ms]                */
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! Packet parser states */
+typedef enum
+{
+    UART_STREAM_RX_SOF0,
+    UART_STREAM_RX_SOF1,
+    UART_STREAM_RX_BODY
+} uartStreamRxState;
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+static uint8_t            rxRing[UART_STREAM_RX_LEN];      /*!< DMA circular buffer               */
+static uint16_t           rxRd;                            /*!< Parser read index in rxRing       */
+static volatile uint8_t   rxEvt;                           /*!< Set from IDLE / DMA events        */
+
+static uartStreamRxState  pktState;                        /*!< Packet parser state               */
+static uint16_t           pktIdx;                          /*!< Bytes collected in pktBuf         */
+static uint16_t           pktNeed;                         /*!< Bytes expected in pktBuf          */
+static uint32_t           pktTick;                         /*!< Time of the last byte received    */
+static uint8_t            pktBuf[UART_STREAM_HDR_LEN + UART_STREAM_PAYLOAD_MAX + UART_STREAM_CRC_LEN];
+
+static uint8_t            slotBuf[UART_STREAM_SLOTS][FRAME_SLOT_LEN]; /*!< Receive ring           */
+static uint32_t           frameLen;                        /*!< Length announced by START         */
+static uint32_t           rxLen;                           /*!< Contiguous bytes received         */
+static uint8_t            txSlot;                          /*!< Oldest slot still needed by RF    */
+static bool               active;                          /*!< Frame not fully handed out yet    */
+static uint32_t           frameGen;                        /*!< Bumped by every START             */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static void          uartStreamRxStart( void );
+static void          uartStreamAck( uint8_t seq, uint8_t status );
+static uartStreamEvt uartStreamHandlePkt( void );
+static uint8_t       uartStreamHandleData( const uint8_t *payload, uint16_t len );
+static ReturnCode    uartStreamGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData );
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void uartStreamRxStart( void )
+{
+    rxRd     = 0U;
+    pktState = UART_STREAM_RX_SOF0;
+
+    HAL_UART_Receive_DMA( &huart2, rxRing, UART_STREAM_RX_LEN );
+    __HAL_UART_CLEAR_IDLEFLAG( &huart2 );
+    __HAL_UART_ENABLE_IT( &huart2, UART_IT_IDLE );
+}
+
+/*******************************************************************************/
+static void uartStreamAck( uint8_t seq, uint8_t status )
+{
+    uint8_t  ack[2U + UART_STREAM_HDR_LEN + 3U + UART_STREAM_CRC_LEN];
+    uint16_t crc;
+
+    ack[0] = UART_STREAM_SOF0;
+    ack[1] = UART_STREAM_SOF1;
+    ack[2] = UART_STREAM_PKT_ACK;
+    ack[3] = seq;
+    ack[4] = 0U;
+    ack[5] = 3U;
+    ack[6] = status;
+    ack[7] = (uint8_t)(rxLen >> 8U);
+    ack[8] = (uint8_t)(rxLen);
+
+    crc     = rfalCrcCalculateCcitt( UART_STREAM_CRC_PRELOAD, &ack[2], (UART_STREAM_HDR_LEN + 3U) );
+    ack[9]  = (uint8_t)(crc >> 8U);
+    ack[10] = (uint8_t)(crc);
+
+    HAL_UART_Transmit( &huart2, ack, sizeof(ack), UART_STREAM_TX_TIMEOUT );
+}
+
+/*******************************************************************************/
+static uint8_t uartStreamHandleData( const uint8_t *payload, uint16_t len )
+{
+    uint32_t ofs;
+    uint32_t end;
+    uint32_t pos;
+    uint16_t n;
+    uint16_t slotOfs;
+
+    if( !active )
+    {
+        return UART_STREAM_ST_STATE;
+    }
+    if( len <= UART_STREAM_OFS_LEN )
+    {
+        return UART_STREAM_ST_PARAM;
+    }
+
+    ofs = GETU16( payload );
+    end = (ofs + len - UART_STREAM_OFS_LEN);
+
+    if( end > frameLen )
+    {
+        return UART_STREAM_ST_PARAM;
+    }
+    if( ofs > rxLen )
+    {
+        return UART_STREAM_ST_SEQ;
+    }
+    if( end <= rxLen )
+    {
+        return UART_STREAM_ST_OK;                      /* Resent after a lost ACK                */
+    }
+    if( ((end - 1U) / FRAME_SLOT_LEN) >= ((uint32_t)txSlot + UART_STREAM_SLOTS) )
+    {
+        return UART_STREAM_ST_BUSY;                    /* Would overwrite a slot not sent yet    */
+    }
+
+    /* Only the bytes past rxLen are new, copy them slot by slot */
+    payload += (UART_STREAM_OFS_LEN + (rxLen - ofs));
+    pos      = rxLen;
+    while( pos < end )
+    {
+        slotOfs = (uint16_t)(pos % FRAME_SLOT_LEN);
+        n       = (uint16_t)MIN( (end - pos), (uint32_t)(FRAME_SLOT_LEN - slotOfs) );
+
+        ST_MEMCPY( &slotBuf[(pos / FRAME_SLOT_LEN) % UART_STREAM_SLOTS][slotOfs], payload, n );
+        payload += n;
+        pos     += n;
+    }
+
+    rxLen = end;
+    return UART_STREAM_ST_OK;
+}
+
+/*******************************************************************************/
+static uartStreamEvt uartStreamHandlePkt( void )
+{
+    uartStreamEvt evt;
+    uint16_t      len;
+    uint16_t      crc;
+    uint8_t       status;
+    uint8_t       type;
+    uint8_t       seq;
+
+    type = pktBuf[0];
+    seq  = pktBuf[1];
+    len  = GETU16( &pktBuf[2] );
+    crc  = GETU16( &pktBuf[UART_STREAM_HDR_LEN + len] );
+    evt  = UART_STREAM_EVT_NONE;
+
+    if( rfalCrcCalculateCcitt( UART_STREAM_CRC_PRELOAD, pktBuf, (UART_STREAM_HDR_LEN + len) ) != crc )
+    {
+        uartStreamAck( seq, UART_STREAM_ST_CRC );
+        return UART_STREAM_EVT_NONE;
+    }
+
+    switch( type )
+    {
+        case UART_STREAM_PKT_START:
+            frameLen = ((len == 4U) ? GETU32( &pktBuf[UART_STREAM_HDR_LEN] ) : 0U);
+            if( frameLen != FRAME_LEN )                /* The tag only accepts all of its slots  */
+            {
+                active = false;
+                status = UART_STREAM_ST_PARAM;
+                break;
+            }
+            rxLen  = 0U;
+            txSlot = 0U;
+            active = true;
+            frameGen++;
+            status = UART_STREAM_ST_OK;
+            evt    = UART_STREAM_EVT_START;
+            break;
+
+        case UART_STREAM_PKT_DATA:
+            status = uartStreamHandleData( &pktBuf[UART_STREAM_HDR_LEN], len );
+            evt    = ((status == UART_STREAM_ST_OK) ? UART_STREAM_EVT_DATA : UART_STREAM_EVT_NONE);
+            break;
+
+        default:
+            status = UART_STREAM_ST_PARAM;
+            break;
+    }
+
+    uartStreamAck( seq, status );
+    return evt;
+}
+
+/*******************************************************************************/
+static ReturnCode uartStreamGetBlock( frameSource *src, uint16_t blockNo, const uint8_t **blockData )
+{
+    uint32_t end;
+    uint32_t remaining;
+    uint8_t  slot;
+    const uint8_t *data;
+
+    uartStreamProcess();
+
+    slot = frameSourceSlot( blockNo );
+    end  = MIN( ((uint32_t)(blockNo + 1U) * FRAME_BLOCK_LEN), frameLen );
+
+    if( (!active) || (src->ctx != (void*)(uintptr_t)frameGen) )
+    {
+        return ERR_WRONG_STATE;                        /* Host restarted: this frame is gone     */
+    }
+    if( (rxLen != 0U) && (((rxLen - 1U) / FRAME_SLOT_LEN) >= ((uint32_t)slot + UART_STREAM_SLOTS)) )
+    {
+        return ERR_WRONG_STATE;                        /* Slot already reused, host must resend  */
+    }
+    if( end > rxLen )
+    {
+        return ERR_BUSY;
+    }
+
+    /* Slots before this one are no longer needed: let the host refill them */
+    if( slot > txSlot )
+    {
+        txSlot = slot;
+    }
+
+    data      = &slotBuf[slot % UART_STREAM_SLOTS][(uint16_t)frameSourceSlotBlock( blockNo ) * FRAME_BLOCK_LEN];
+    remaining = (end - ((uint32_t)blockNo * FRAME_BLOCK_LEN));
+
+    if( remaining < FRAME_BLOCK_LEN )
+    {
+        ST_MEMSET( src->pad, 0xFF, FRAME_BLOCK_LEN );
+        ST_MEMCPY( src->pad, data, remaining );
+        data = src->pad;
+    }
+
+    if( end == frameLen )
+    {
+        active = false;                                /* Whole frame handed to the RF side      */
+    }
+
+    *blockData = data;
+    return ERR_NONE;
+}
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void uartStreamInit( void )
+{
+    active = false;
+    rxEvt  = 0U;
+    uartStreamRxStart();
+}
+
+/*******************************************************************************/
+uartStreamEvt uartStreamProcess( void )
+{
+    uartStreamEvt evt;
+    uartStreamEvt pktEvt;
+    uint16_t      wr;
+    uint8_t       b;
+
+    evt = UART_STREAM_EVT_NONE;
+
+    if( (pktState != UART_STREAM_RX_SOF0) && ((platformGetSysTick() - pktTick) > UART_STREAM_PKT_TIMEOUT) )
+    {
+        pktState = UART_STREAM_RX_SOF0;                /* Host stopped mid packet: resync        */
+    }
+
+    if( rxEvt == 0U )
+    {
+        return evt;
+    }
+    rxEvt = 0U;
+
+    wr = (uint16_t)(UART_STREAM_RX_LEN - __HAL_DMA_GET_COUNTER( huart2.hdmarx ));
+    if( wr >= UART_STREAM_RX_LEN )
+    {
+        wr = 0U;
+    }
+
+    while( rxRd != wr )
+    {
+        b    = rxRing[rxRd];
+        rxRd = ((rxRd + 1U) % UART_STREAM_RX_LEN);
+
+        pktTick = platformGetSysTick();
+
+        switch( pktState )
+        {
+            case UART_STREAM_RX_SOF0:
+                if( b == UART_STREAM_SOF0 )
+                {
+                    pktState = UART_STREAM_RX_SOF1;
+                }
+                break;
+
+            case UART_STREAM_RX_SOF1:
+                if( b == UART_STREAM_SOF1 )
+                {
+                    pktState = UART_STREAM_RX_BODY;
+                    pktIdx   = 0U;
+                    pktNeed  = UART_STREAM_HDR_LEN;
+                }
+                else if( b != UART_STREAM_SOF0 )
+                {
+                    pktState = UART_STREAM_RX_SOF0;
+                }
+                break;
+
+            case UART_STREAM_RX_BODY:
+                pktBuf[pktIdx++] = b;
+                if( pktIdx == UART_STREAM_HDR_LEN )
+                {
+                    pktNeed = GETU16( &pktBuf[2] );
+                    if( pktNeed > UART_STREAM_PAYLOAD_MAX )
+                    {
+                        pktState = UART_STREAM_RX_SOF0;
+                        break;
+                    }
+                    pktNeed += (UART_STREAM_HDR_LEN + UART_STREAM_CRC_LEN);
+                }
+                else if( pktIdx == pktNeed )
+                {
+                    pktState = UART_STREAM_RX_SOF0;
+                    pktEvt   = uartStreamHandlePkt();
+                    if( pktEvt != UART_STREAM_EVT_NONE )
+                    {
+                        evt = pktEvt;
+                    }
+                }
+                else
+                {
+                    /* MISRA 15.7 - Empty else */
+                }
+                break;
+
+            default:
+                pktState = UART_STREAM_RX_SOF0;
+                break;
+        }
+    }
+
+    return evt;
+}
+
+/*******************************************************************************/
+bool uartStreamActive( void )
+{
+    return active;
+}
+
+/*******************************************************************************/
+ReturnCode frameSourceInitUart( frameSource *src )
+{
+    if( src == NULL )
+    {
+        return ERR_PARAM;
+    }
+
+    src->len      = frameLen;
+    src->getBlock = uartStreamGetBlock;
+    src->prefetch = NULL;
+    src->mem      = NULL;
+    src->ctx      = (void*)(uintptr_t)frameGen;        /* Ties the source to one upload          */
+    src->seekable = false;                             /* Slots are dropped once sent            */
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+void uartStreamRxEvent( void )
+{
+    rxEvt = 1U;
+}
+
+/*******************************************************************************/
+void HAL_UART_RxHalfCpltCallback( UART_HandleTypeDef *huart )
+{
+    if( huart->Instance == USART2 )
+    {
+        rxEvt = 1U;
+    }
+}
+
+/*******************************************************************************/
+void HAL_UART_RxCpltCallback( UART_HandleTypeDef *huart )
+{
+    if( huart->Instance == USART2 )
+    {
+        rxEvt = 1U;
+    }
+}
+
+/*******************************************************************************/
+void HAL_UART_ErrorCallback( UART_HandleTypeDef *huart )
+{
+    if( huart->Instance == USART2 )
+    {
+        /* HAL aborted the DMA on a line error: restart, bytes in flight are lost
+         * and the host resends after its ACK timeout */
+        uartStreamRxStart();
+    }
+}
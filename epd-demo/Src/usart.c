@@ -23,6 +23,7 @@
 #include "st_errno.h"
 /* USER CODE BEGIN 0 */
 #define USART_TIMEOUT 1000
+DMA_HandleTypeDef hdma_usart2_rx;
 /* USER CODE END 0 */
 //UART_HandleTypeDef *pUsart = 0;
 UART_HandleTypeDef huart2;
@@ -84,6 +85,27 @@ void HAL_UART_MspInit(UART_HandleTypeDef *uartHandle)
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
     /* USER CODE BEGIN USART2_MspInit 1 */
+    /* USART2 RX DMA: circular host upload buffer */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hdma_usart2_rx.Instance = DMA1_Channel6;
+    hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_usart2_rx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+    __HAL_LINKDMA(uartHandle, hdmarx, hdma_usart2_rx);
+
+    HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+    HAL_NVIC_SetPriority(USART2_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(USART2_IRQn);
 
     /* USER CODE END USART2_MspInit 1 */
   }
@@ -107,6 +129,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef *uartHandle)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_2 | GPIO_PIN_3);
 
     /* USER CODE BEGIN USART2_MspDeInit 1 */
+    HAL_DMA_DeInit(uartHandle->hdmarx);
+    HAL_NVIC_DisableIRQ(DMA1_Channel6_IRQn);
+    HAL_NVIC_DisableIRQ(USART2_IRQn);
 
     /* USER CODE END USART2_MspDeInit 1 */
   }
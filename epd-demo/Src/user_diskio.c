@@ -36,6 +36,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include <string.h>
 #include "ff_gen_drv.h"
+#include "sd_spi.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -82,7 +83,11 @@ DSTATUS USER_initialize(
 )
 {
   /* USER CODE BEGIN INIT */
-  Stat = STA_NOINIT;
+  if (pdrv != 0)
+  {
+    return STA_NOINIT;
+  }
+  Stat = (sdSpiInit() == ERR_NONE) ? 0 : STA_NOINIT;
   return Stat;
   /* USER CODE END INIT */
 }
@@ -97,7 +102,10 @@ DSTATUS USER_status(
 )
 {
   /* USER CODE BEGIN STATUS */
-  Stat = STA_NOINIT;
+  if (pdrv != 0)
+  {
+    return STA_NOINIT;
+  }
   return Stat;
   /* USER CODE END STATUS */
 }
@@ -118,7 +126,15 @@ DRESULT USER_read(
 )
 {
   /* USER CODE BEGIN READ */
-  return RES_OK;
+  if ((pdrv != 0) || (count == 0))
+  {
+    return RES_PARERR;
+  }
+  if ((Stat & STA_NOINIT) != 0)
+  {
+    return RES_NOTRDY;
+  }
+  return (sdSpiReadBlocks(buff, sector, count) == ERR_NONE) ? RES_OK : RES_ERROR;
   /* USER CODE END READ */
 }
 
@@ -139,8 +155,15 @@ DRESULT USER_write(
 )
 {
   /* USER CODE BEGIN WRITE */
-  /* USER CODE HERE */
-  return RES_OK;
+  if ((pdrv != 0) || (count == 0))
+  {
+    return RES_PARERR;
+  }
+  if ((Stat & STA_NOINIT) != 0)
+  {
+    return RES_NOTRDY;
+  }
+  return (sdSpiWriteBlocks(buff, sector, count) == ERR_NONE) ? RES_OK : RES_ERROR;
   /* USER CODE END WRITE */
 }
 #endif /* _USE_WRITE == 1 */
@@ -161,6 +184,45 @@ DRESULT USER_ioctl(
 {
   /* USER CODE BEGIN IOCTL */
   DRESULT res = RES_ERROR;
+  uint32_t sectors;
+
+  if (pdrv != 0)
+  {
+    return RES_PARERR;
+  }
+  if ((Stat & STA_NOINIT) != 0)
+  {
+    return RES_NOTRDY;
+  }
+
+  switch (cmd)
+  {
+  case CTRL_SYNC:
+    res = (sdSpiSync() == ERR_NONE) ? RES_OK : RES_ERROR;
+    break;
+
+  case GET_SECTOR_COUNT:
+    if (sdSpiGetSectorCount(&sectors) == ERR_NONE)
+    {
+      *(DWORD *)buff = sectors;
+      res = RES_OK;
+    }
+    break;
+
+  case GET_SECTOR_SIZE:
+    *(WORD *)buff = SD_SPI_SECTOR_LEN;
+    res = RES_OK;
+    break;
+
+  case GET_BLOCK_SIZE:
+    *(DWORD *)buff = 1; /* Erase block size unknown */
+    res = RES_OK;
+    break;
+
+  default:
+    res = RES_PARERR;
+    break;
+  }
   return res;
   /* USER CODE END IOCTL */
 }
@@ -0,0 +1,294 @@
+/*
+ * epd_send - upload a raw e-paper frame to the reader over its console UART
+ *
+ * Build:  gcc -O2 -Wall -o epd_send epd_send.c
+ * Usage:  epd_send /dev/ttyUSB0 image.bin [baud]
+ *
+ * image.bin is a raw 1bpp frame of exactly 5000 bytes (200x200 panel), the
+ * same layout as the built-in nfcbuf arrays. See Inc/uart_stream.h for the
+ * packet format. The reader starts writing the tag as soon as the first
+ * chunk arrived and answers BUSY while its two slot buffers are full, so
+ * this tool simply keeps resending until every chunk is accepted.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SOF0            0xA5
+#define SOF1            0x5A
+#define PKT_START       0x01
+#define PKT_DATA        0x02
+#define PKT_ACK         0x81
+
+#define ST_OK           0x00
+#define ST_CRC          0x01
+#define ST_BUSY         0x02
+#define ST_SEQ          0x03
+
+#define FRAME_LEN       5000
+#define CHUNK_MAX       256
+#define ACK_TIMEOUT_MS  500
+#define BUSY_RETRY_MS   20
+#define MAX_RETRIES     20
+#define BUSY_TIMEOUT_MS 30000
+
+static int port;
+
+/* CRC-16/MCRF4XX, same as rfalCrcCalculateCcitt() with preload 0xFFFF */
+static uint16_t crc16(uint16_t crc, const uint8_t *buf, size_t len)
+{
+    while (len--) {
+        uint8_t dat = *buf++ ^ (uint8_t)crc;
+        dat ^= (uint8_t)(dat << 4);
+        crc = (uint16_t)((crc >> 8) ^ ((uint16_t)dat << 8) ^ ((uint16_t)dat << 3) ^ (dat >> 4));
+    }
+    return crc;
+}
+
+static long now_ms(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000L + tv.tv_usec / 1000L;
+}
+
+static int open_port(const char *dev, int baud)
+{
+    struct termios tio;
+    speed_t speed;
+
+    switch (baud) {
+    case 115200: speed = B115200; break;
+    case 230400: speed = B230400; break;
+    case 460800: speed = B460800; break;
+    case 921600: speed = B921600; break;
+    default:
+        fprintf(stderr, "unsupported baud rate %d\n", baud);
+        return -1;
+    }
+
+    port = open(dev, O_RDWR | O_NOCTTY);
+    if (port < 0) {
+        fprintf(stderr, "%s: %s\n", dev, strerror(errno));
+        return -1;
+    }
+
+    if (tcgetattr(port, &tio) < 0) {
+        perror("tcgetattr");
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (tcsetattr(port, TCSANOW, &tio) < 0) {
+        perror("tcsetattr");
+        return -1;
+    }
+    tcflush(port, TCIOFLUSH);
+    return 0;
+}
+
+static int read_byte(uint8_t *b, long deadline)
+{
+    fd_set rd;
+    struct timeval tv;
+    long left;
+
+    for (;;) {
+        left = deadline - now_ms();
+        if (left <= 0)
+            return 0;
+
+        FD_ZERO(&rd);
+        FD_SET(port, &rd);
+        tv.tv_sec = left / 1000;
+        tv.tv_usec = (left % 1000) * 1000;
+        if (select(port + 1, &rd, NULL, NULL, &tv) <= 0)
+            return 0;
+        if (read(port, b, 1) == 1)
+            return 1;
+    }
+}
+
+/* Wait for the ACK of packet seq. Returns the status byte or -1 on timeout.
+ * Console log text printed by the reader is passed through to stderr. */
+static int wait_ack(uint8_t seq, uint16_t *rx_len)
+{
+    long deadline = now_ms() + ACK_TIMEOUT_MS;
+    uint8_t pkt[4 + 3 + 2];
+    uint8_t b;
+    size_t i;
+
+    for (;;) {
+        if (!read_byte(&b, deadline))
+            return -1;
+        if (b != SOF0) {
+            fputc(b, stderr);
+            continue;
+        }
+        if (!read_byte(&b, deadline))
+            return -1;
+        if (b != SOF1)
+            continue;
+
+        for (i = 0; i < sizeof(pkt); i++) {
+            if (!read_byte(&pkt[i], deadline))
+                return -1;
+        }
+
+        if (pkt[0] != PKT_ACK || pkt[2] != 0 || pkt[3] != 3)
+            continue;
+        if (crc16(0xFFFF, pkt, 7) != (uint16_t)((pkt[7] << 8) | pkt[8]))
+            continue;
+        if (pkt[1] != seq)
+            continue;                       /* Late ACK of an earlier attempt */
+
+        *rx_len = (uint16_t)((pkt[5] << 8) | pkt[6]);
+        return pkt[4];
+    }
+}
+
+static int send_pkt(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len)
+{
+    uint8_t pkt[2 + 4 + 2 + CHUNK_MAX + 2];
+    uint16_t crc;
+    size_t n = 0;
+
+    pkt[n++] = SOF0;
+    pkt[n++] = SOF1;
+    pkt[n++] = type;
+    pkt[n++] = seq;
+    pkt[n++] = (uint8_t)(len >> 8);
+    pkt[n++] = (uint8_t)len;
+    memcpy(&pkt[n], payload, len);
+    n += len;
+    crc = crc16(0xFFFF, &pkt[2], 4 + len);
+    pkt[n++] = (uint8_t)(crc >> 8);
+    pkt[n++] = (uint8_t)crc;
+
+    return (write(port, pkt, n) == (ssize_t)n) ? 0 : -1;
+}
+
+/* Send a packet until it is acknowledged with OK. Returns 0 on success. */
+static int transact(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len, uint16_t *rx_len)
+{
+    long busy_since = 0;
+    int retries = 0;
+    int st;
+
+    for (;;) {
+        if (send_pkt(type, seq, payload, len) < 0) {
+            perror("write");
+            return -1;
+        }
+
+        st = wait_ack(seq, rx_len);
+        if (st == ST_OK)
+            return 0;
+
+        if (st == ST_BUSY) {
+            /* Reader is waiting for the tag, this can take a while */
+            if (busy_since == 0)
+                busy_since = now_ms();
+            if (now_ms() - busy_since > BUSY_TIMEOUT_MS) {
+                fprintf(stderr, "\nreader stayed busy, is a tag in the field?\n");
+                return -1;
+            }
+            usleep(BUSY_RETRY_MS * 1000);
+            continue;
+        }
+
+        if (st == ST_SEQ)
+            return 1;                       /* Caller rewinds to rx_len */
+
+        if (st != ST_CRC && st != -1) {
+            fprintf(stderr, "\nreader rejected packet: status %d\n", st);
+            return -1;
+        }
+
+        if (++retries > MAX_RETRIES) {
+            fprintf(stderr, "\nno answer from reader\n");
+            return -1;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t frame[FRAME_LEN];
+    uint8_t payload[2 + CHUNK_MAX];
+    uint16_t rx_len = 0;
+    uint8_t seq = 0;
+    size_t len, ofs, n;
+    long t0;
+    FILE *f;
+    int ret;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <tty> <image.bin> [baud]\n", argv[0]);
+        return 2;
+    }
+
+    f = fopen(argv[2], "rb");
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", argv[2], strerror(errno));
+        return 1;
+    }
+    len = fread(frame, 1, sizeof(frame), f);
+    if (len != FRAME_LEN || fgetc(f) != EOF) {
+        fprintf(stderr, "%s: expected %d bytes\n", argv[2], FRAME_LEN);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    if (open_port(argv[1], (argc > 3) ? atoi(argv[3]) : 115200) < 0)
+        return 1;
+
+    t0 = now_ms();
+
+    payload[0] = (uint8_t)(len >> 24);
+    payload[1] = (uint8_t)(len >> 16);
+    payload[2] = (uint8_t)(len >> 8);
+    payload[3] = (uint8_t)len;
+    if (transact(PKT_START, seq++, payload, 4, &rx_len) != 0)
+        return 1;
+
+    ofs = 0;
+    while (ofs < len) {
+        n = len - ofs;
+        if (n > CHUNK_MAX)
+            n = CHUNK_MAX;
+
+        payload[0] = (uint8_t)(ofs >> 8);
+        payload[1] = (uint8_t)ofs;
+        memcpy(&payload[2], &frame[ofs], n);
+
+        ret = transact(PKT_DATA, seq++, payload, (uint16_t)(2 + n), &rx_len);
+        if (ret < 0)
+            return 1;
+        if (ret > 0) {
+            ofs = rx_len;                   /* Reader lost data, resume where it is */
+            continue;
+        }
+
+        ofs += n;
+        fprintf(stderr, "\r%zu/%zu bytes", ofs, len);
+    }
+
+    fprintf(stderr, "\nuploaded in %ld ms, reader is sending to the tag\n", now_ms() - t0);
+    close(port);
+    return 0;
+}
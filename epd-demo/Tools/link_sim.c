@@ -0,0 +1,175 @@
+/*
+ * link_sim - host simulation of the RF power adaptation (Src/link_adapt.c)
+ *
+ * Build (from epd-demo/Tools):
+ *   gcc -O2 -Wall -Wno-int-to-pointer-cast -DUSE_HAL_DRIVER -DSTM32F103xB -I../Inc -I../ST/rfal/Inc \
+ *       -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *       -I../Drivers/CMSIS/Include -I../BSP/NFC05A1 -I../BSP/Components/ST25R3911 \
+ *       -o link_sim link_sim.c ../Src/link_adapt.c ../ST/rfal/Src/rfal_dpo.c -lm
+ * Usage:  link_sim [blocks] [seed]
+ *
+ * The real link_adapt.c and RFAL dynamic power module run against stubs of
+ * the few chip calls they make. The channel model gives the field at the tag
+ * in dB from the reader distance and the RFO driver setting:
+ *
+ *   field = LINK_SIM_FIELD_0 - LINK_SIM_DB_PER_RFO * rfo - 20 * log10(d)
+ *
+ * A block write fails with a probability that rises on a weak field and
+ * again on a very strong one (tag overcoupled, too close), and the tag's
+ * answer RSSI grows with the field. Each block is written like
+ * demoFleetWriteBlock() does: one retry, then reported to linkAdaptBlock().
+ *
+ * For every distance it prints, at fixed full power and with the
+ * adaptation, the RF commands sent per block, the blocks that failed after
+ * their retry and the RFO setting at the end; once with RSSI and once
+ * without it, as on a receiver that doesn't provide one.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "link_adapt.h"
+#include "rfal_rf.h"
+#include "rfal_chip.h"
+
+#define LINK_SIM_BLOCKS       1000      /* Block writes per run            */
+#define LINK_SIM_TRIES        2         /* Attempts per block              */
+#define LINK_SIM_FIELD_0      10.0      /* Field at d = 1, full power [dB] */
+#define LINK_SIM_DB_PER_RFO   1.5       /* Field lost per RFO step [dB]    */
+#define LINK_SIM_WEAK_DB      (-7.0)    /* Half the writes fail below      */
+#define LINK_SIM_STRONG_DB    6.0       /* Half the writes fail above      */
+#define LINK_SIM_SLOPE        1.2       /* Steepness of both edges [1/dB]  */
+#define LINK_SIM_PERR_MAX     0.9       /* Some writes always get through  */
+#define LINK_SIM_RSSI_REF     950.0     /* RSSI at LINK_SIM_STRONG_DB [mV] */
+
+static const double distances[] = { 0.5, 1.0, 1.5, 2.0, 3.0, 5.0, 8.0 };
+
+static uint8_t simRfo;                  /* RFO setting the DPO module chose */
+static int     simRssi;                 /* Receiver reports an RSSI         */
+static double  simRssiNow;              /* RSSI of the last answer [mV]     */
+
+/* Chip stubs used by link_adapt.c and rfal_dpo.c */
+ReturnCode rfalChipSetRFO(uint8_t rfo)
+{
+    simRfo = rfo;
+    return ERR_NONE;
+}
+
+ReturnCode rfalChipMeasureAmplitude(uint8_t *result)
+{
+    *result = 0;
+    return ERR_NONE;
+}
+
+rfalMode rfalGetMode(void)
+{
+    return RFAL_MODE_POLL_NFCV;
+}
+
+ReturnCode rfalGetTransceiveRSSI(uint16_t *rssi)
+{
+    if (!simRssi)
+    {
+        *rssi = 0;
+        return ERR_NOTSUPP;
+    }
+    *rssi = (uint16_t)((simRssiNow > 65535.0) ? 65535.0 : simRssiNow);
+    return ERR_NONE;
+}
+
+static double sim_field(double d, uint8_t rfo)
+{
+    return LINK_SIM_FIELD_0 - (LINK_SIM_DB_PER_RFO * rfo) - (20.0 * log10(d));
+}
+
+static double sim_perr(double field)
+{
+    double weak   = 1.0 / (1.0 + exp((field - LINK_SIM_WEAK_DB) * LINK_SIM_SLOPE));
+    double strong = 1.0 / (1.0 + exp(-(field - LINK_SIM_STRONG_DB) * LINK_SIM_SLOPE));
+
+    return ((weak + strong) > LINK_SIM_PERR_MAX) ? LINK_SIM_PERR_MAX : (weak + strong);
+}
+
+static double sim_rand(void)
+{
+    return rand() / (RAND_MAX + 1.0);
+}
+
+static void sim_run(double d, int adapt, long blocks, long *tx, long *failed)
+{
+    double field;
+    long   b;
+    int    tries;
+    int    retried;
+    int    ok;
+
+    *tx     = 0;
+    *failed = 0;
+    if (adapt)
+    {
+        linkAdaptReset();
+    }
+    simRfo = 0;
+
+    for (b = 0; b < blocks; b++)
+    {
+        field      = sim_field(d, adapt ? simRfo : 0);
+        simRssiNow = LINK_SIM_RSSI_REF * pow(10.0, (field - LINK_SIM_STRONG_DB) / 20.0);
+
+        ok      = 0;
+        retried = 0;
+        for (tries = 0; tries < LINK_SIM_TRIES; tries++)
+        {
+            (*tx)++;
+            if (sim_rand() >= sim_perr(field))
+            {
+                ok = 1;
+                break;
+            }
+            retried = 1;
+        }
+
+        if (!ok)
+        {
+            (*failed)++;
+        }
+        if (adapt)
+        {
+            linkAdaptBlock(retried != 0, ok ? ERR_NONE : ERR_TIMEOUT);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long     blocks = (argc > 1) ? atol(argv[1]) : LINK_SIM_BLOCKS;
+    unsigned seed   = (argc > 2) ? (unsigned)atoi(argv[2]) : 1U;
+    long     tx, failed;
+    size_t   i;
+    int      adapt;
+
+    if (blocks <= 0)
+    {
+        fprintf(stderr, "usage: %s [blocks] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    for (simRssi = 1; simRssi >= 0; simRssi--)
+    {
+        printf("RSSI %s, %ld blocks per run\n", simRssi ? "available" : "not available", blocks);
+        printf("  dist  | fixed: tx/blk failed rfo | adapt: tx/blk failed rfo\n");
+        for (i = 0; i < sizeof(distances) / sizeof(distances[0]); i++)
+        {
+            printf("  %4.1f  ", distances[i]);
+            for (adapt = 0; adapt < 2; adapt++)
+            {
+                srand(seed);
+                sim_run(distances[i], adapt, blocks, &tx, &failed);
+                printf("|        %5.3f %6ld %3d ", (double)tx / blocks, failed, adapt ? linkAdaptGetRfo() : 0);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}